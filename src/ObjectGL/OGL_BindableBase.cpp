@@ -34,9 +34,43 @@ OGL_BindableBase::OGL_BindableBase()
     this->instance->registerBindable(this);
 }
 
+OGL_BindableBase::OGL_BindableBase(OGL_BindableBase&& other)
+{
+    //take the instance of the other bindable
+    this->instance = other.instance;
+    //take the place of the other bindable in the instance
+    if (this->instance) {this->instance->replaceBindable(&other, this);}
+    //the other bindable dose not own anything anymore
+    other.instance = 0;
+}
+
+OGL_BindableBase& OGL_BindableBase::operator=(OGL_BindableBase&& other)
+{
+    //moving into itself changes nothing
+    if (this == &other) {return *this;}
+    //destroy the own OpenGL object
+    this->release();
+    //take the instance of the other bindable
+    this->instance = other.instance;
+    //take the place of the other bindable in the instance
+    if (this->instance) {this->instance->replaceBindable(&other, this);}
+    //the other bindable dose not own anything anymore
+    other.instance = 0;
+    //return a reference to this
+    return *this;
+}
+
 //define the destructor for the bindable base
 OGL_BindableBase::~OGL_BindableBase()
 {
+    //child classes release in they're own destructor, because the overwritten onDestroy can't be called from here
+    this->release();
+}
+
+void OGL_BindableBase::release()
+{
+    //if the bindable is not bound to an instance, it dose not own anything
+    if (this->instance == 0) {return;}
     //call the destroy function
     this->onDestroy();
     //remove this from the instance
@@ -0,0 +1,53 @@
+/**
+ * @file OGL_BufferUsageTracker.cpp
+ * @author DM8AT
+ * @brief implement the adaptive usage policy for buffers
+ * @version 0.1
+ * @date 2024-08-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+bool OGL_BufferUsageTracker::recordUpload(uint64_t frame)
+{
+    //count the upload
+    ++this->uploads;
+    //without the adaptive policy the hint never changes
+    if (!this->adaptive) {return false;}
+    //start the first window at the first upload
+    if (!this->windowStarted) {this->windowStart = frame; this->windowStarted = true;}
+    //count the upload for the window
+    ++this->windowUploads;
+    //store the amount of frames since the window started
+    uint64_t frames = frame - this->windowStart;
+    //only decide when the window is over
+    if (frames < this->window) {return false;}
+    //calculate the uploads per frame
+    this->uploadRate = this->windowUploads / (float)frames;
+    //start the next window
+    this->windowStart = frame;
+    this->windowUploads = 0;
+
+    //the usage hints are ordered as stream, static and dynamic with draw, read and copy each, like GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY, (unused), GL_STATIC_DRAW, ...
+    GLenum access = (this->usage - GL_STREAM_DRAW) % 4;
+    //select the frequency from the upload rate
+    GLenum frequency = GL_STATIC_DRAW;
+    if (this->uploadRate >= OGL_BUFFER_USAGE_STREAM_RATE) {frequency = GL_STREAM_DRAW;}
+    else if (this->uploadRate >= OGL_BUFFER_USAGE_DYNAMIC_RATE) {frequency = GL_DYNAMIC_DRAW;}
+    //store the new hint
+    GLenum usage = frequency + access;
+    //check if the hint changed
+    if (usage == this->usage) {return false;}
+    //store the new hint
+    this->usage = usage;
+    //count the change
+    ++this->usageChanges;
+    //the storage should be re-allocated
+    return true;
+}
@@ -0,0 +1,297 @@
+/**
+ * @file OGL_CommandList.cpp
+ * @author DM8AT
+ * @brief implement command lists that record draws and replay them sorted by their state
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+/**
+ * @brief get a small ID for an object, IDs are handed out in the order the objects are first seen
+ * 
+ * @param ids the IDs that where handed out
+ * @param object the object
+ * @return uint64_t the ID of the object, clamped to 16 bits
+ */
+static uint64_t getObjectID(std::unordered_map<const void*, uint64_t>& ids, const void* object)
+{
+    //no object always has the ID 0
+    if (!object) {return 0;}
+    //hand out a new ID if the object is new
+    std::unordered_map<const void*, uint64_t>::iterator it = ids.find(object);
+    if (it == ids.end()) {it = ids.emplace(object, ids.size() + 1).first;}
+    //IDs that don't fit into 16 bits share the last ID, they are still drawn correctly
+    return (it->second < 0xFFFF) ? it->second : 0xFFFF;
+}
+
+void OGL_CommandList::setTexture(uint8_t unit, OGL_Texture* texture)
+{
+    //search the unit, the textures are sorted by their unit
+    size_t i = 0;
+    while (i < this->textures.size() && this->textures[i].unit < unit) {++i;}
+    bool exists = (i < this->textures.size() && this->textures[i].unit == unit);
+    //remove the texture of the unit
+    if (!texture) {if (exists) {this->textures.erase(this->textures.begin() + i);} return;}
+    //replace or add the texture
+    if (exists) {this->textures[i].texture = texture; return;}
+    OGL_CommandTexture entry;
+    entry.unit = unit;
+    entry.texture = texture;
+    this->textures.insert(this->textures.begin() + i, entry);
+}
+
+void OGL_CommandList::setUniformBuffer(uint8_t unit, OGL_UniformBuffer* buffer, GLintptr offset, GLsizeiptr size)
+{
+    //search the binding point, the ranges are sorted by their binding point
+    size_t i = 0;
+    while (i < this->uniforms.size() && this->uniforms[i].unit < unit) {++i;}
+    bool exists = (i < this->uniforms.size() && this->uniforms[i].unit == unit);
+    //remove the range of the binding point
+    if (!buffer) {if (exists) {this->uniforms.erase(this->uniforms.begin() + i);} return;}
+    //replace or add the range
+    OGL_CommandUniformRange entry;
+    entry.unit = unit;
+    entry.buffer = buffer;
+    entry.offset = offset;
+    entry.size = size;
+    if (exists) {this->uniforms[i] = entry; return;}
+    this->uniforms.insert(this->uniforms.begin() + i, entry);
+}
+
+void OGL_CommandList::drawElements(GLsizei count, GLenum mode, uint32_t firstIndex, GLsizei instanceCount, GLint baseVertex)
+{
+    //indexed draws need an index buffer
+    if (!this->indexBuffer) {std::__throw_runtime_error("Can't record an indexed draw without an index buffer");}
+    //store the draw arguments
+    OGL_DrawPacket packet;
+    packet.indexBuffer = this->indexBuffer;
+    packet.mode = mode;
+    packet.count = count;
+    packet.first = firstIndex;
+    packet.instanceCount = instanceCount;
+    packet.baseVertex = baseVertex;
+    //store the draw
+    this->record(packet);
+}
+
+void OGL_CommandList::drawArrays(GLsizei count, GLenum mode, uint32_t first, GLsizei instanceCount)
+{
+    //store the draw arguments, draws without indices don't bind the index buffer
+    OGL_DrawPacket packet;
+    packet.mode = mode;
+    packet.count = count;
+    packet.first = first;
+    packet.instanceCount = instanceCount;
+    //store the draw
+    this->record(packet);
+}
+
+void OGL_CommandList::record(OGL_DrawPacket& packet)
+{
+    //draws need a shader and vertex attributes
+    if (!this->shader || !this->vertexAttributes) {std::__throw_runtime_error("Can't record a draw without a shader and vertex attributes");}
+    //store the current state
+    packet.shader = this->shader;
+    packet.vertexAttributes = this->vertexAttributes;
+    //copy the textures and uniform buffer ranges into the arenas
+    packet.firstTexture = this->textureArena.size();
+    packet.textureCount = this->textures.size();
+    this->textureArena.insert(this->textureArena.end(), this->textures.begin(), this->textures.end());
+    packet.firstUniform = this->uniformArena.size();
+    packet.uniformCount = this->uniforms.size();
+    this->uniformArena.insert(this->uniformArena.end(), this->uniforms.begin(), this->uniforms.end());
+    //store the draw
+    this->packets.push_back(packet);
+}
+
+void OGL_CommandList::append(const OGL_CommandList& other)
+{
+    //store where the arenas of the other list start in this list
+    uint32_t textureOffset = this->textureArena.size();
+    uint32_t uniformOffset = this->uniformArena.size();
+    //copy the arenas
+    this->textureArena.insert(this->textureArena.end(), other.textureArena.begin(), other.textureArena.end());
+    this->uniformArena.insert(this->uniformArena.end(), other.uniformArena.begin(), other.uniformArena.end());
+    //copy the draws and move them to the new position of their arena entries
+    this->packets.reserve(this->packets.size() + other.packets.size());
+    for (OGL_DrawPacket packet : other.packets)
+    {
+        packet.firstTexture += textureOffset;
+        packet.firstUniform += uniformOffset;
+        this->packets.push_back(packet);
+    }
+}
+
+void OGL_CommandList::submit(bool sort)
+{
+    //start with the order of recording
+    this->order.resize(this->packets.size());
+    for (uint32_t i = 0; i < this->order.size(); ++i) {this->order[i] = i;}
+    //count the state changes without sorting
+    OGL_CommandListStats unsorted;
+    this->replay(this->order, unsorted, false);
+    //sort the draws by their state
+    if (sort)
+    {
+        this->calculateKeys();
+        this->sortKeys();
+    }
+    //replay the draws
+    this->stats = OGL_CommandListStats();
+    this->replay(this->order, this->stats, true);
+    this->stats.unsortedStateChanges = unsorted.programChanges + unsorted.vertexArrayChanges + unsorted.indexBufferChanges + unsorted.textureChanges + unsorted.uniformChanges;
+}
+
+void OGL_CommandList::clear()
+{
+    //remove the draws, the vectors keep their memory
+    this->packets.clear();
+    this->textureArena.clear();
+    this->uniformArena.clear();
+    this->order.clear();
+    //reset the recording state
+    this->shader = 0;
+    this->vertexAttributes = 0;
+    this->indexBuffer = 0;
+    this->textures.clear();
+    this->uniforms.clear();
+}
+
+uint64_t OGL_CommandList::getStateChanges() const
+{
+    //sum up all changes
+    return this->stats.programChanges + this->stats.vertexArrayChanges + this->stats.indexBufferChanges + this->stats.textureChanges + this->stats.uniformChanges;
+}
+
+uint64_t OGL_CommandList::getRemovedStateChanges() const
+{
+    //sorting never adds changes, but an unsorted submission removes none
+    uint64_t changes = this->getStateChanges();
+    return (this->stats.unsortedStateChanges > changes) ? this->stats.unsortedStateChanges - changes : 0;
+}
+
+void OGL_CommandList::calculateKeys()
+{
+    //hand out small IDs for the objects in the order they are first used, so the sorting is the same every frame
+    std::unordered_map<const void*, uint64_t> shaders;
+    std::unordered_map<const void*, uint64_t> vertexAttributes;
+    std::unordered_map<const void*, uint64_t> indexBuffers;
+    //texture sets are identified by a hash of their units and textures
+    std::unordered_map<uint64_t, uint64_t> textureSets;
+    for (OGL_DrawPacket& packet : this->packets)
+    {
+        //hash the textures of the draw (FNV-1a)
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t i = 0; i < packet.textureCount; ++i)
+        {
+            const OGL_CommandTexture& texture = this->textureArena[packet.firstTexture + i];
+            hash = (hash ^ texture.unit) * 1099511628211ull;
+            hash = (hash ^ (uint64_t)(uintptr_t)texture.texture) * 1099511628211ull;
+        }
+        //get the ID of the texture set, draws without textures have the ID 0
+        uint64_t textureSet = 0;
+        if (packet.textureCount)
+        {
+            std::unordered_map<uint64_t, uint64_t>::iterator it = textureSets.find(hash);
+            if (it == textureSets.end()) {it = textureSets.emplace(hash, textureSets.size() + 1).first;}
+            textureSet = (it->second < 0xFFFF) ? it->second : 0xFFFF;
+        }
+        //changing the shader costs the most, then the textures, then the vertex attributes and the index buffer
+        packet.key = (getObjectID(shaders, packet.shader) << 48) | (textureSet << 32) | 
+                     (getObjectID(vertexAttributes, packet.vertexAttributes) << 16) | getObjectID(indexBuffers, packet.indexBuffer);
+    }
+}
+
+void OGL_CommandList::sortKeys()
+{
+    //less than two draws are allways sorted
+    if (this->order.size() < 2) {return;}
+    //sort the order by one byte of the key at a time, starting with the lowest byte. Each pass is stable, so draws with the same key keep their order
+    this->sortBuffer.resize(this->order.size());
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        //count how many keys have each value of the byte
+        size_t count[256] = {};
+        for (uint32_t i : this->order) {++count[(this->packets[i].key >> shift) & 0xFF];}
+        //skip the byte if all keys have the same value for it
+        if (count[(this->packets[this->order[0]].key >> shift) & 0xFF] == this->order.size()) {continue;}
+        //calculate where the keys with each value start
+        size_t start = 0;
+        for (size_t& c : count) {size_t n = c; c = start; start += n;}
+        //move the draws to their new position
+        for (uint32_t i : this->order) {this->sortBuffer[count[(this->packets[i].key >> shift) & 0xFF]++] = i;}
+        this->order.swap(this->sortBuffer);
+    }
+}
+
+void OGL_CommandList::replay(const std::vector<uint32_t>& order, OGL_CommandListStats& stats, bool execute)
+{
+    //store the bound state, to skip everything that is allready bound
+    OGL_Shader* shader = 0;
+    OGL_VertexAttributes* vertexAttributes = 0;
+    OGL_IndexBuffer* indexBuffer = 0;
+    std::vector<OGL_Texture*> textures;
+    std::vector<OGL_CommandUniformRange> uniforms;
+    for (uint32_t i : order)
+    {
+        const OGL_DrawPacket& packet = this->packets[i];
+        ++stats.draws;
+        //use the shader
+        if (packet.shader != shader)
+        {
+            shader = packet.shader;
+            ++stats.programChanges;
+            if (execute) {shader->bind();}
+        }
+        //bind the vertex attributes. The index buffer binding is part of them, so it must be bound again
+        if (packet.vertexAttributes != vertexAttributes)
+        {
+            vertexAttributes = packet.vertexAttributes;
+            indexBuffer = 0;
+            ++stats.vertexArrayChanges;
+            if (execute) {vertexAttributes->bind();}
+        }
+        //bind the index buffer
+        if (packet.indexBuffer && packet.indexBuffer != indexBuffer)
+        {
+            indexBuffer = packet.indexBuffer;
+            ++stats.indexBufferChanges;
+            if (execute) {indexBuffer->bind();}
+        }
+        //bind the textures that changed
+        for (uint32_t t = 0; t < packet.textureCount; ++t)
+        {
+            const OGL_CommandTexture& texture = this->textureArena[packet.firstTexture + t];
+            if (textures.size() <= texture.unit) {textures.resize(texture.unit + 1, 0);}
+            if (textures[texture.unit] == texture.texture) {continue;}
+            textures[texture.unit] = texture.texture;
+            ++stats.textureChanges;
+            if (execute) {texture.texture->bind(texture.unit);}
+        }
+        //bind the uniform buffer ranges that changed
+        for (uint32_t u = 0; u < packet.uniformCount; ++u)
+        {
+            const OGL_CommandUniformRange& range = this->uniformArena[packet.firstUniform + u];
+            if (uniforms.size() <= range.unit) {uniforms.resize(range.unit + 1);}
+            OGL_CommandUniformRange& bound = uniforms[range.unit];
+            if (bound.buffer == range.buffer && bound.offset == range.offset && bound.size == range.size) {continue;}
+            bound = range;
+            ++stats.uniformChanges;
+            if (!execute) {continue;}
+            if (range.size) {range.buffer->bindRange(range.unit, range.offset, range.size);}
+            else {range.buffer->bind(range.unit);}
+        }
+        //draw
+        if (!execute) {continue;}
+        if (packet.indexBuffer) {glDrawElementsInstancedBaseVertex(packet.mode, packet.count, GL_UNSIGNED_INT, (const void*)(uintptr_t)(packet.first * sizeof(uint32_t)), packet.instanceCount, packet.baseVertex);}
+        else {glDrawArraysInstanced(packet.mode, packet.first, packet.count, packet.instanceCount);}
+    }
+}
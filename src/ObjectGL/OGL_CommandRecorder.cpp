@@ -0,0 +1,88 @@
+/**
+ * @file OGL_CommandRecorder.cpp
+ * @author DM8AT
+ * @brief implement recording command lists on worker threads
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+OGL_CommandRecorder::~OGL_CommandRecorder()
+{
+    //the worker threads must not use the command lists after they are deleted
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->signal.wait(lock, [this]() {return this->pending == 0;});
+}
+
+void OGL_CommandRecorder::record(void (*func)(OGL_CommandList*, void*, size_t), void* data, size_t count, OGL_WorkerPool* pool)
+{
+    //finish the last recording, its lists are re-used
+    this->wait();
+    //get the worker pool of the instance
+    if (!pool)
+    {
+        OGL_Instance* instance = oglGetCurrentInstance();
+        if (!instance) {std::__throw_runtime_error("Can't record commands without a worker pool or an instance");}
+        pool = instance->getWorkerPool();
+    }
+    //store the recording function
+    this->func = func;
+    this->data = data;
+    //create a command list for each task, existing lists keep their memory
+    this->lists.resize(count);
+    for (OGL_CommandList& list : this->lists) {list.clear();}
+    //all tasks are pending before the first one starts, so a task that finishes early can't signal the end
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending = count;
+        this->error.clear();
+    }
+    //start the tasks
+    for (size_t i = 0; i < count; ++i) {pool->push(OGL_CommandRecorder::runTask, this, i);}
+}
+
+void OGL_CommandRecorder::wait()
+{
+    //wait until no task is running
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->signal.wait(lock, [this]() {return this->pending == 0;});
+    //throw the error of a task on this thread
+    if (!this->error.empty())
+    {
+        std::string error = this->error;
+        this->error.clear();
+        std::__throw_runtime_error(error.c_str());
+    }
+}
+
+OGL_CommandList& OGL_CommandRecorder::merge()
+{
+    //wait for the recording
+    this->wait();
+    //add the lists in the order of their index, so the result is the same for every run
+    this->merged.clear();
+    for (const OGL_CommandList& list : this->lists) {this->merged.append(list);}
+    //return the merged list
+    return this->merged;
+}
+
+void OGL_CommandRecorder::runTask(void* data, size_t index)
+{
+    //get the recorder
+    OGL_CommandRecorder* recorder = (OGL_CommandRecorder*)data;
+    //record into the list of the task. Errors can't leave the worker thread, so they are stored for the render thread
+    std::string error;
+    try {(*recorder->func)(&recorder->lists[index], recorder->data, index);}
+    catch (const std::exception& e) {error = e.what();}
+    //the task is done
+    std::lock_guard<std::mutex> lock(recorder->mutex);
+    if (!error.empty() && recorder->error.empty()) {recorder->error = error;}
+    if (--recorder->pending == 0) {recorder->signal.notify_all();}
+}
@@ -0,0 +1,900 @@
+/**
+ * @file OGL_CompressedImage.cpp
+ * @author DM8AT
+ * @brief implement the loading, saving and CPU compression of block compressed images
+ * @version 0.1
+ * @date 2024-08-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+//include file streams
+#include <fstream>
+//include memcpy
+#include <cstring>
+//include sqrt
+#include <cmath>
+//include min and max
+#include <algorithm>
+
+/**
+ * @brief the identifier at the start of a KTX file
+ */
+static const uint8_t KTX_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+/**
+ * @brief the identifier at the start of a KTX2 file
+ */
+static const uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+/**
+ * @brief the weights of the 16 palette entries of a BC7 block with 4 bit indices
+ */
+static const int32_t BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/**
+ * @brief create a four character code like the ones used in DDS files
+ * 
+ * @param a the first character
+ * @param b the second character
+ * @param c the third character
+ * @param d the fourth character
+ * @return uint32_t the four characters as a little endian integer
+ */
+static constexpr uint32_t fourCC(char a, char b, char c, char d)
+{
+    return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+}
+
+/**
+ * @brief read a little endian 32 bit integer
+ * 
+ * @param p a pointer to the integer
+ * @return uint32_t the integer
+ */
+static uint32_t readU32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief read a little endian 64 bit integer
+ * 
+ * @param p a pointer to the integer
+ * @return uint64_t the integer
+ */
+static uint64_t readU64(const uint8_t* p)
+{
+    return (uint64_t)readU32(p) | ((uint64_t)readU32(p + 4) << 32);
+}
+
+/**
+ * @brief append a little endian 32 bit integer to a byte vector
+ * 
+ * @param out the vector to append to
+ * @param value the integer to append
+ */
+static void writeU32(std::vector<uint8_t>& out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {out.push_back((uint8_t)(value >> (i*8)));}
+}
+
+/**
+ * @brief swap the bytes of a 32 bit integer
+ * 
+ * @param value the integer
+ * @return uint32_t the integer with the other endianness
+ */
+static uint32_t swapU32(uint32_t value)
+{
+    return (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+}
+
+/**
+ * @brief get the size of a 4x4 block of a compressed format
+ * 
+ * @param internalFormat the compressed internal format
+ * @return size_t the size of a block in bytes or 0 if the format is not known
+ */
+static size_t getBlockSize(GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+    //formats with 8 bytes per block
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT: case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RED_RGTC1: case GL_COMPRESSED_SIGNED_RED_RGTC1:
+    case GL_COMPRESSED_RGB8_ETC2: case GL_COMPRESSED_SRGB8_ETC2:
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2: case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+    case GL_COMPRESSED_R11_EAC: case GL_COMPRESSED_SIGNED_R11_EAC:
+        return 8;
+    //formats with 16 bytes per block
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT: case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_RG_RGTC2: case GL_COMPRESSED_SIGNED_RG_RGTC2:
+    case GL_COMPRESSED_RGBA_BPTC_UNORM: case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+    case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT: case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+    case GL_COMPRESSED_RGBA8_ETC2_EAC: case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+    case GL_COMPRESSED_RG11_EAC: case GL_COMPRESSED_SIGNED_RG11_EAC:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief get the base format of a compressed format, it is stored in KTX files
+ * 
+ * @param internalFormat the compressed internal format
+ * @return GLenum the base format, like GL_RGB
+ */
+static GLenum getBaseFormat(GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+    case GL_COMPRESSED_RED_RGTC1: case GL_COMPRESSED_SIGNED_RED_RGTC1:
+    case GL_COMPRESSED_R11_EAC: case GL_COMPRESSED_SIGNED_R11_EAC:
+        return GL_RED;
+    case GL_COMPRESSED_RG_RGTC2: case GL_COMPRESSED_SIGNED_RG_RGTC2:
+    case GL_COMPRESSED_RG11_EAC: case GL_COMPRESSED_SIGNED_RG11_EAC:
+        return GL_RG;
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT: case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+    case GL_COMPRESSED_RGB8_ETC2: case GL_COMPRESSED_SRGB8_ETC2:
+        return GL_RGB;
+    default:
+        return GL_RGBA;
+    }
+}
+
+/**
+ * @brief get the compressed format for a DXGI format of a DDS file
+ * 
+ * @param format the DXGI format
+ * @return GLenum the compressed internal format or 0 if it is not supported
+ */
+static GLenum fromDXGI(uint32_t format)
+{
+    switch (format)
+    {
+    case 70: case 71: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case 72: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+    case 73: case 74: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    case 75: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+    case 76: case 77: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case 78: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case 79: case 80: return GL_COMPRESSED_RED_RGTC1;
+    case 81: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+    case 82: case 83: return GL_COMPRESSED_RG_RGTC2;
+    case 84: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+    case 94: case 95: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+    case 96: return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+    case 97: case 98: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case 99: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    default: return 0;
+    }
+}
+
+/**
+ * @brief get the compressed format for a four character code of a DDS file
+ * 
+ * @param code the four character code
+ * @return GLenum the compressed internal format or 0 if it is not supported
+ */
+static GLenum fromFourCC(uint32_t code)
+{
+    switch (code)
+    {
+    case fourCC('D','X','T','1'): return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case fourCC('D','X','T','3'): return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    case fourCC('D','X','T','5'): return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case fourCC('A','T','I','1'): case fourCC('B','C','4','U'): return GL_COMPRESSED_RED_RGTC1;
+    case fourCC('B','C','4','S'): return GL_COMPRESSED_SIGNED_RED_RGTC1;
+    case fourCC('A','T','I','2'): case fourCC('B','C','5','U'): return GL_COMPRESSED_RG_RGTC2;
+    case fourCC('B','C','5','S'): return GL_COMPRESSED_SIGNED_RG_RGTC2;
+    default: return 0;
+    }
+}
+
+/**
+ * @brief get the compressed format for a Vulkan format of a KTX2 file
+ * 
+ * @param format the Vulkan format
+ * @return GLenum the compressed internal format or 0 if it is not supported
+ */
+static GLenum fromVulkan(uint32_t format)
+{
+    switch (format)
+    {
+    case 131: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case 132: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+    case 133: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case 134: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+    case 135: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    case 136: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+    case 137: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case 138: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case 139: return GL_COMPRESSED_RED_RGTC1;
+    case 140: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+    case 141: return GL_COMPRESSED_RG_RGTC2;
+    case 142: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+    case 143: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+    case 144: return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+    case 145: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case 146: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    case 147: return GL_COMPRESSED_RGB8_ETC2;
+    case 148: return GL_COMPRESSED_SRGB8_ETC2;
+    case 149: return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+    case 150: return GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+    case 151: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    case 152: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+    case 153: return GL_COMPRESSED_R11_EAC;
+    case 154: return GL_COMPRESSED_SIGNED_R11_EAC;
+    case 155: return GL_COMPRESSED_RG11_EAC;
+    case 156: return GL_COMPRESSED_SIGNED_RG11_EAC;
+    default: return 0;
+    }
+}
+
+size_t oglGetCompressedImageSize(GLenum internalFormat, uint32_t width, uint32_t height)
+{
+    //get the size of a block
+    size_t blockSize = getBlockSize(internalFormat);
+    //return the size of all blocks, partial blocks at the border are full blocks
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+}
+
+/**
+ * @brief find the direction in which a set of points varies the most with a power iteration
+ * 
+ * @param covariance the covariance matrix of the points, n by n
+ * @param n the amount of dimensions, 3 or 4
+ * @param axis the array to store the normalized direction in
+ */
+static void principalAxis(const float* covariance, int n, float* axis)
+{
+    //start with the dimension that varies the most
+    int best = 0;
+    for (int i = 1; i < n; ++i) {if (covariance[i*n+i] > covariance[best*n+best]) {best = i;}}
+    for (int i = 0; i < n; ++i) {axis[i] = covariance[best*n+i];}
+    //repeat the multiplication with the matrix, the vector converges to the biggest eigenvector
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        float next[4] = {0,0,0,0};
+        for (int i = 0; i < n; ++i) {for (int j = 0; j < n; ++j) {next[i] += covariance[i*n+j] * axis[j];}}
+        //normalize the vector
+        float length = 0;
+        for (int i = 0; i < n; ++i) {length += next[i]*next[i];}
+        length = std::sqrt(length);
+        //a block with a single color has no direction
+        if (length < 1e-6f) {for (int i = 0; i < n; ++i) {axis[i] = 1.f / std::sqrt((float)n);} return;}
+        for (int i = 0; i < n; ++i) {axis[i] = next[i] / length;}
+    }
+}
+
+/**
+ * @brief find two endpoints that span the colors of a block along the direction they vary the most
+ * 
+ * @param block the 16 RGBA pixels of the block
+ * @param n the amount of channels to use, 3 or 4
+ * @param e0 the array to store the first endpoint in
+ * @param e1 the array to store the second endpoint in
+ */
+static void findEndpoints(const uint8_t* block, int n, float* e0, float* e1)
+{
+    //calculate the mean
+    float mean[4] = {0,0,0,0};
+    for (int p = 0; p < 16; ++p) {for (int c = 0; c < n; ++c) {mean[c] += block[p*4+c];}}
+    for (int c = 0; c < n; ++c) {mean[c] /= 16.f;}
+    //calculate the covariance
+    float covariance[16] = {};
+    for (int p = 0; p < 16; ++p)
+    {
+        float d[4];
+        for (int c = 0; c < n; ++c) {d[c] = block[p*4+c] - mean[c];}
+        for (int i = 0; i < n; ++i) {for (int j = 0; j < n; ++j) {covariance[i*n+j] += d[i]*d[j];}}
+    }
+    //get the direction
+    float axis[4];
+    principalAxis(covariance, n, axis);
+    //project all pixels on the direction to find the extremes
+    float lo = 0, hi = 0;
+    for (int p = 0; p < 16; ++p)
+    {
+        float t = 0;
+        for (int c = 0; c < n; ++c) {t += (block[p*4+c] - mean[c]) * axis[c];}
+        if (t < lo) {lo = t;}
+        if (t > hi) {hi = t;}
+    }
+    //the endpoints are the extremes, clamped to the valid range
+    for (int c = 0; c < n; ++c)
+    {
+        e0[c] = std::fmin(std::fmax(mean[c] + hi*axis[c], 0.f), 255.f);
+        e1[c] = std::fmin(std::fmax(mean[c] + lo*axis[c], 0.f), 255.f);
+    }
+}
+
+/**
+ * @brief quantize a color to 5:6:5 bits
+ * 
+ * @param color the RGB color
+ * @return uint16_t the packed color
+ */
+static uint16_t packRGB565(const float* color)
+{
+    uint32_t r = (uint32_t)(std::fmin(std::fmax(color[0], 0.f), 255.f) * 31.f / 255.f + .5f);
+    uint32_t g = (uint32_t)(std::fmin(std::fmax(color[1], 0.f), 255.f) * 63.f / 255.f + .5f);
+    uint32_t b = (uint32_t)(std::fmin(std::fmax(color[2], 0.f), 255.f) * 31.f / 255.f + .5f);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+/**
+ * @brief expand a 5:6:5 color to 8 bits per channel
+ * 
+ * @param packed the packed color
+ * @param color the array to store the RGB color in
+ */
+static void unpackRGB565(uint16_t packed, int32_t* color)
+{
+    int32_t r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * @brief select the nearest palette entry of a BC1 color block for each pixel
+ * 
+ * @param block the 16 RGBA pixels of the block
+ * @param c0 the first endpoint, it must be bigger than or equal to the second one
+ * @param c1 the second endpoint
+ * @param indices the array to store the 16 indices in
+ * @return uint32_t the squared error of the block
+ */
+static uint32_t fitBC1Indices(const uint8_t* block, uint16_t c0, uint16_t c1, uint8_t* indices)
+{
+    //build the palette
+    int32_t palette[4][3];
+    unpackRGB565(c0, palette[0]);
+    unpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+        palette[2][c] = (2*palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2*palette[1][c]) / 3;
+    }
+    //equal endpoints only use the first entry
+    int entries = (c0 == c1) ? 1 : 4;
+    //find the nearest entry for each pixel
+    uint32_t error = 0;
+    for (int p = 0; p < 16; ++p)
+    {
+        uint32_t best = UINT32_MAX;
+        for (int e = 0; e < entries; ++e)
+        {
+            uint32_t d = 0;
+            for (int c = 0; c < 3; ++c) {int32_t v = block[p*4+c] - palette[e][c]; d += v*v;}
+            if (d < best) {best = d; indices[p] = e;}
+        }
+        error += best;
+    }
+    //return the error
+    return error;
+}
+
+/**
+ * @brief encode the color of a block as a BC1 block in four color mode
+ * 
+ * @param block the 16 RGBA pixels of the block
+ * @param out the memory for the 8 byte block
+ */
+static void encodeBC1Color(const uint8_t* block, uint8_t* out)
+{
+    //find the endpoints
+    float e0[4], e1[4];
+    findEndpoints(block, 3, e0, e1);
+    uint16_t c0 = packRGB565(e0), c1 = packRGB565(e1);
+    //the first endpoint must be bigger for the four color mode
+    if (c0 < c1) {uint16_t t = c0; c0 = c1; c1 = t;}
+    uint8_t indices[16];
+    uint32_t error = fitBC1Indices(block, c0, c1, indices);
+
+    //refit the endpoints to the selected indices with least squares
+    if (c0 != c1)
+    {
+        //the weight of the first endpoint for each index
+        const float weights[4] = {1.f, 0.f, 2.f/3.f, 1.f/3.f};
+        float aa = 0, bb = 0, ab = 0, ax[3] = {0,0,0}, bx[3] = {0,0,0};
+        for (int p = 0; p < 16; ++p)
+        {
+            float a = weights[indices[p]], b = 1.f - a;
+            aa += a*a; bb += b*b; ab += a*b;
+            for (int c = 0; c < 3; ++c) {ax[c] += a*block[p*4+c]; bx[c] += b*block[p*4+c];}
+        }
+        float det = aa*bb - ab*ab;
+        if (std::fabs(det) > 1e-6f)
+        {
+            float r0[3], r1[3];
+            for (int c = 0; c < 3; ++c)
+            {
+                r0[c] = (ax[c]*bb - bx[c]*ab) / det;
+                r1[c] = (bx[c]*aa - ax[c]*ab) / det;
+            }
+            uint16_t n0 = packRGB565(r0), n1 = packRGB565(r1);
+            if (n0 < n1) {uint16_t t = n0; n0 = n1; n1 = t;}
+            //keep the refit if it is better
+            uint8_t refit[16];
+            uint32_t refitError = fitBC1Indices(block, n0, n1, refit);
+            if (refitError < error) {c0 = n0; c1 = n1; memcpy(indices, refit, 16);}
+        }
+    }
+
+    //write the block
+    out[0] = c0 & 0xFF; out[1] = c0 >> 8;
+    out[2] = c1 & 0xFF; out[3] = c1 >> 8;
+    uint32_t bits = 0;
+    for (int p = 0; p < 16; ++p) {bits |= (uint32_t)indices[p] << (p*2);}
+    for (int i = 0; i < 4; ++i) {out[4+i] = (uint8_t)(bits >> (i*8));}
+}
+
+/**
+ * @brief encode the alpha of a block as a BC3 alpha block with eight values
+ * 
+ * @param block the 16 RGBA pixels of the block
+ * @param out the memory for the 8 byte block
+ */
+static void encodeBC3Alpha(const uint8_t* block, uint8_t* out)
+{
+    //find the range of the alpha
+    int32_t lo = 255, hi = 0;
+    for (int p = 0; p < 16; ++p) {lo = std::min<int32_t>(lo, block[p*4+3]); hi = std::max<int32_t>(hi, block[p*4+3]);}
+    out[0] = (uint8_t)hi;
+    out[1] = (uint8_t)lo;
+    //build the palette, with equal endpoints only the first entry is used
+    int32_t palette[8] = {hi, lo};
+    for (int i = 2; i < 8; ++i) {palette[i] = ((8-i)*hi + (i-1)*lo) / 7;}
+    int entries = (hi == lo) ? 1 : 8;
+    //find the nearest entry for each pixel
+    uint64_t bits = 0;
+    for (int p = 0; p < 16; ++p)
+    {
+        int32_t best = INT32_MAX, index = 0;
+        for (int e = 0; e < entries; ++e)
+        {
+            int32_t d = std::abs(block[p*4+3] - palette[e]);
+            if (d < best) {best = d; index = e;}
+        }
+        bits |= (uint64_t)index << (p*3);
+    }
+    //write the indices
+    for (int i = 0; i < 6; ++i) {out[2+i] = (uint8_t)(bits >> (i*8));}
+}
+
+/**
+ * @brief quantize a BC7 mode 6 endpoint to 7 bits per channel and a shared p-bit
+ * 
+ * @param endpoint the RGBA endpoint
+ * @param quantized the array to store the 7 bit channels in
+ * @return uint32_t the p-bit
+ */
+static uint32_t quantizeBC7Endpoint(const float* endpoint, int32_t* quantized)
+{
+    //store the best p-bit
+    uint32_t bestBit = 0;
+    float bestError = 1e30f;
+    //try both p-bits
+    for (uint32_t bit = 0; bit < 2; ++bit)
+    {
+        float error = 0;
+        int32_t q[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            q[c] = std::min(std::max((int32_t)std::lround((endpoint[c] - bit) / 2.f), 0), 127);
+            float d = (float)(q[c]*2 + bit) - endpoint[c];
+            error += d*d;
+        }
+        if (error < bestError) {bestError = error; bestBit = bit; memcpy(quantized, q, sizeof(q));}
+    }
+    //return the p-bit
+    return bestBit;
+}
+
+/**
+ * @brief write bits to a block, starting at the lowest bit
+ * 
+ * @param out the block
+ * @param position the position of the next bit, it is advanced
+ * @param value the value to write
+ * @param count the amount of bits to write
+ */
+static void writeBits(uint8_t* out, uint32_t& position, uint32_t value, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i, ++position)
+    {
+        if ((value >> i) & 1) {out[position >> 3] |= (uint8_t)(1 << (position & 7));}
+    }
+}
+
+/**
+ * @brief encode a block as a BC7 block in mode 6, a single subset with RGBA endpoints and 4 bit indices
+ * 
+ * @param block the 16 RGBA pixels of the block
+ * @param out the memory for the 16 byte block
+ */
+static void encodeBC7(const uint8_t* block, uint8_t* out)
+{
+    //find and quantize the endpoints
+    float e0[4], e1[4];
+    findEndpoints(block, 4, e0, e1);
+    int32_t q0[4], q1[4];
+    uint32_t p0 = quantizeBC7Endpoint(e0, q0);
+    uint32_t p1 = quantizeBC7Endpoint(e1, q1);
+    //build the palette
+    int32_t palette[16][4];
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < 4; ++c) {palette[i][c] = ((64 - BC7_WEIGHTS[i]) * (q0[c]*2 + (int32_t)p0) + BC7_WEIGHTS[i] * (q1[c]*2 + (int32_t)p1) + 32) >> 6;}
+    }
+    //find the nearest entry for each pixel
+    uint32_t indices[16];
+    for (int p = 0; p < 16; ++p)
+    {
+        int32_t best = INT32_MAX;
+        for (int i = 0; i < 16; ++i)
+        {
+            int32_t d = 0;
+            for (int c = 0; c < 4; ++c) {int32_t v = block[p*4+c] - palette[i][c]; d += v*v;}
+            if (d < best) {best = d; indices[p] = i;}
+        }
+    }
+    //the highest bit of the first index is not stored, so it must be 0. Swap the endpoints if it is not
+    if (indices[0] & 8)
+    {
+        for (int c = 0; c < 4; ++c) {int32_t t = q0[c]; q0[c] = q1[c]; q1[c] = t;}
+        uint32_t t = p0; p0 = p1; p1 = t;
+        for (int p = 0; p < 16; ++p) {indices[p] = 15 - indices[p];}
+    }
+    //write the block
+    memset(out, 0, 16);
+    uint32_t position = 0;
+    //mode 6 is 6 zero bits followed by a one
+    writeBits(out, position, 1 << 6, 7);
+    //the endpoints are stored channel by channel
+    for (int c = 0; c < 4; ++c) {writeBits(out, position, q0[c], 7); writeBits(out, position, q1[c], 7);}
+    writeBits(out, position, p0, 1);
+    writeBits(out, position, p1, 1);
+    //the first index has only 3 bits
+    writeBits(out, position, indices[0], 3);
+    for (int p = 1; p < 16; ++p) {writeBits(out, position, indices[p], 4);}
+}
+
+/**
+ * @brief compress a whole image level
+ * 
+ * @param pixels the tightly packed RGBA pixels
+ * @param width the width in pixels
+ * @param height the height in pixels
+ * @param format the block format
+ * @param out the memory for the blocks
+ */
+static void compressLevel(const uint8_t* pixels, uint32_t width, uint32_t height, OGL_BlockFormat format, uint8_t* out)
+{
+    //store the size of a block
+    size_t blockSize = (format == OGL_BLOCK_FORMAT_BC1) ? 8 : 16;
+    //loop over all blocks
+    for (uint32_t by = 0; by < (height + 3) / 4; ++by)
+    {
+        for (uint32_t bx = 0; bx < (width + 3) / 4; ++bx)
+        {
+            //gather the pixels, blocks at the border repeat the last row and column
+            uint8_t block[64];
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    uint32_t px = std::min(bx*4 + x, width - 1), py = std::min(by*4 + y, height - 1);
+                    memcpy(block + (y*4 + x)*4, pixels + ((size_t)py*width + px)*4, 4);
+                }
+            }
+            //encode the block
+            uint8_t* dst = out + ((size_t)by*((width + 3) / 4) + bx) * blockSize;
+            switch (format)
+            {
+            case OGL_BLOCK_FORMAT_BC1: encodeBC1Color(block, dst); break;
+            case OGL_BLOCK_FORMAT_BC3: encodeBC3Alpha(block, dst); encodeBC1Color(block, dst + 8); break;
+            case OGL_BLOCK_FORMAT_BC7: encodeBC7(block, dst); break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief halve the size of an image with a box filter
+ * 
+ * @param pixels the tightly packed RGBA pixels
+ * @param width the width in pixels, it is set to the new width
+ * @param height the height in pixels, it is set to the new height
+ * @return std::vector<uint8_t> the pixels of the smaller image
+ */
+static std::vector<uint8_t> downsample(const std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height)
+{
+    //calculate the new size
+    uint32_t w = std::max(width / 2, 1u), h = std::max(height / 2, 1u);
+    std::vector<uint8_t> out((size_t)w*h*4);
+    //average 2x2 pixels, the last row and column are repeated for odd sizes
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            uint32_t x0 = std::min(x*2, width - 1), x1 = std::min(x*2 + 1, width - 1);
+            uint32_t y0 = std::min(y*2, height - 1), y1 = std::min(y*2 + 1, height - 1);
+            for (int c = 0; c < 4; ++c)
+            {
+                uint32_t sum = pixels[((size_t)y0*width + x0)*4 + c] + pixels[((size_t)y0*width + x1)*4 + c]
+                             + pixels[((size_t)y1*width + x0)*4 + c] + pixels[((size_t)y1*width + x1)*4 + c];
+                out[((size_t)y*w + x)*4 + c] = (uint8_t)((sum + 2) / 4);
+            }
+        }
+    }
+    //store the new size
+    width = w;
+    height = h;
+    return out;
+}
+
+OGL_CompressedImage::OGL_CompressedImage(const char* file)
+{
+    //load the file
+    this->load(file);
+}
+
+void OGL_CompressedImage::allocate(GLenum internalFormat, uint32_t width, uint32_t height, uint32_t levelCount, uint32_t layerCount, uint32_t faceCount)
+{
+    //check if the format is known
+    if (getBlockSize(internalFormat) == 0) {std::__throw_runtime_error("The format of the compressed image is not a supported block compressed format");}
+    //check the size
+    if (width == 0 || height == 0 || levelCount == 0 || layerCount == 0 || (faceCount != 1 && faceCount != 6)) {std::__throw_runtime_error("The compressed image has an invalid size");}
+    //store the format and size
+    this->internalFormat = internalFormat;
+    this->width = width;
+    this->height = height;
+    this->layers = layerCount;
+    this->faces = faceCount;
+    //store where the levels are
+    this->levels.resize(levelCount);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        OGL_CompressedLevel& level = this->levels[i];
+        level.width = std::max(width >> i, 1u);
+        level.height = std::max(height >> i, 1u);
+        level.offset = offset;
+        level.size = oglGetCompressedImageSize(internalFormat, level.width, level.height) * layerCount * faceCount;
+        offset += level.size;
+    }
+    //allocate the data
+    this->data.assign(offset, 0);
+}
+
+void OGL_CompressedImage::load(const char* file)
+{
+    //open the file
+    std::ifstream f(file, std::ios::binary);
+    //check if the file is opend
+    if (!f.is_open()) {std::__throw_runtime_error((std::string("Failed to open file ") + file).c_str());}
+    //read the whole file
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    //select the reader from the identifier
+    if (content.size() >= 4 && readU32(content.data()) == fourCC('D','D','S',' ')) {this->loadDDS(content.data(), content.size());}
+    else if (content.size() >= 12 && memcmp(content.data(), KTX_IDENTIFIER, 12) == 0) {this->loadKTX(content.data(), content.size());}
+    else if (content.size() >= 12 && memcmp(content.data(), KTX2_IDENTIFIER, 12) == 0) {this->loadKTX2(content.data(), content.size());}
+    else {std::__throw_runtime_error((std::string("The file ") + file + " is not a KTX, KTX2 or DDS file").c_str());}
+}
+
+void OGL_CompressedImage::loadDDS(const uint8_t* file, size_t size)
+{
+    //the magic number and the header need 128 bytes
+    if (size < 128) {std::__throw_runtime_error("The DDS file is truncated");}
+    //read the header
+    uint32_t flags = readU32(file + 8);
+    uint32_t height = readU32(file + 12);
+    uint32_t width = readU32(file + 16);
+    uint32_t levelCount = (flags & 0x20000) ? std::max(readU32(file + 28), 1u) : 1;
+    uint32_t pixelFlags = readU32(file + 80);
+    uint32_t code = readU32(file + 84);
+    uint32_t caps2 = readU32(file + 112);
+    //only block compressed files are supported
+    if (!(pixelFlags & 0x4)) {std::__throw_runtime_error("Only block compressed DDS files are supported");}
+    //store the layout
+    uint32_t layerCount = 1;
+    uint32_t faceCount = (caps2 & 0x200) ? 6 : 1;
+    size_t offset = 128;
+    GLenum format = 0;
+    //check for the extended header
+    if (code == fourCC('D','X','1','0'))
+    {
+        if (size < 148) {std::__throw_runtime_error("The DDS file is truncated");}
+        format = fromDXGI(readU32(file + 128));
+        if (readU32(file + 136) & 0x4) {faceCount = 6;}
+        layerCount = std::max(readU32(file + 140), 1u);
+        offset = 148;
+    }
+    else {format = fromFourCC(code);}
+    //check if the format is supported
+    if (!format) {std::__throw_runtime_error("The format of the DDS file is not supported");}
+    //allocate the image
+    this->allocate(format, width, height, levelCount, layerCount, faceCount);
+    //DDS files store all levels of a face after each other, reorder them to store all faces of a level after each other
+    for (uint32_t layer = 0; layer < layerCount; ++layer)
+    {
+        for (uint32_t face = 0; face < faceCount; ++face)
+        {
+            for (uint32_t i = 0; i < levelCount; ++i)
+            {
+                size_t imageSize = this->levels[i].size / (layerCount * faceCount);
+                if (offset + imageSize > size) {std::__throw_runtime_error("The DDS file is truncated");}
+                memcpy(this->data.data() + this->levels[i].offset + (layer*faceCount + face)*imageSize, file + offset, imageSize);
+                offset += imageSize;
+            }
+        }
+    }
+}
+
+void OGL_CompressedImage::loadKTX(const uint8_t* file, size_t size)
+{
+    //the header needs 64 bytes
+    if (size < 64) {std::__throw_runtime_error("The KTX file is truncated");}
+    //check the endianness
+    uint32_t endianness = readU32(file + 12);
+    bool swap = (endianness == 0x01020304);
+    if (!swap && endianness != 0x04030201) {std::__throw_runtime_error("The KTX file has an invalid endianness");}
+    //read the header fields
+    uint32_t header[13];
+    for (int i = 0; i < 13; ++i) {header[i] = swap ? swapU32(readU32(file + 12 + i*4)) : readU32(file + 12 + i*4);}
+    //header[1] is the type, it is 0 for compressed data
+    if (header[1] != 0) {std::__throw_runtime_error("Only block compressed KTX files are supported");}
+    //3D textures are not supported
+    if (header[8] > 1) {std::__throw_runtime_error("3D KTX files are not supported");}
+    //allocate the image
+    uint32_t layerCount = std::max(header[9], 1u);
+    uint32_t faceCount = header[10];
+    uint32_t levelCount = std::max(header[11], 1u);
+    this->allocate(header[4], header[6], header[7], levelCount, layerCount, faceCount);
+    //skip the key-value data
+    size_t offset = 64 + (size_t)header[12];
+    //read all levels, the images of a level are stored like in the image
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        //skip the size of the level, block compressed images need no padding
+        offset += 4;
+        if (offset + this->levels[i].size > size) {std::__throw_runtime_error("The KTX file is truncated");}
+        memcpy(this->data.data() + this->levels[i].offset, file + offset, this->levels[i].size);
+        offset += this->levels[i].size;
+    }
+}
+
+void OGL_CompressedImage::loadKTX2(const uint8_t* file, size_t size)
+{
+    //the header and the index need 80 bytes
+    if (size < 80) {std::__throw_runtime_error("The KTX2 file is truncated");}
+    //read the header
+    GLenum format = fromVulkan(readU32(file + 12));
+    uint32_t width = readU32(file + 20);
+    uint32_t height = readU32(file + 24);
+    uint32_t depth = readU32(file + 28);
+    uint32_t layerCount = std::max(readU32(file + 32), 1u);
+    uint32_t faceCount = readU32(file + 36);
+    uint32_t levelCount = std::max(readU32(file + 40), 1u);
+    uint32_t supercompression = readU32(file + 44);
+    //check if the file is supported
+    if (supercompression != 0) {std::__throw_runtime_error("Supercompressed KTX2 files are not supported");}
+    if (!format) {std::__throw_runtime_error("The format of the KTX2 file is not supported");}
+    if (depth > 1) {std::__throw_runtime_error("3D KTX2 files are not supported");}
+    if (size < 80 + (size_t)levelCount*24) {std::__throw_runtime_error("The KTX2 file is truncated");}
+    //allocate the image
+    this->allocate(format, width, height, levelCount, layerCount, faceCount);
+    //read all levels from the level index, the images of a level are stored like in the image
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        uint64_t offset = readU64(file + 80 + i*24);
+        uint64_t length = readU64(file + 88 + i*24);
+        if (length < this->levels[i].size || offset + this->levels[i].size > size) {std::__throw_runtime_error("The KTX2 file is truncated");}
+        memcpy(this->data.data() + this->levels[i].offset, file + offset, this->levels[i].size);
+    }
+}
+
+bool OGL_CompressedImage::save(const char* file) const
+{
+    //an empty image can't be saved
+    if (!this->internalFormat) {return false;}
+    //write the header
+    std::vector<uint8_t> out(KTX_IDENTIFIER, KTX_IDENTIFIER + 12);
+    writeU32(out, 0x04030201);
+    //type, type size and format of compressed data
+    writeU32(out, 0);
+    writeU32(out, 1);
+    writeU32(out, 0);
+    writeU32(out, this->internalFormat);
+    writeU32(out, getBaseFormat(this->internalFormat));
+    writeU32(out, this->width);
+    writeU32(out, this->height);
+    writeU32(out, 0);
+    writeU32(out, (this->layers > 1) ? this->layers : 0);
+    writeU32(out, this->faces);
+    writeU32(out, this->levels.size());
+    //no key-value data
+    writeU32(out, 0);
+    //write all levels
+    for (const OGL_CompressedLevel& level : this->levels)
+    {
+        //cubemaps that are not arrays store the size of a single face
+        writeU32(out, (this->faces == 6 && this->layers == 1) ? level.size / 6 : level.size);
+        out.insert(out.end(), this->data.begin() + level.offset, this->data.begin() + level.offset + level.size);
+    }
+    //write the file
+    std::ofstream f(file, std::ios::binary);
+    if (!f.is_open()) {return false;}
+    f.write((const char*)out.data(), out.size());
+    return f.good();
+}
+
+void OGL_CompressedImage::compress(const uint8_t* pixels, uint32_t width, uint32_t height, OGL_BlockFormat format, bool srgb, bool mipmaps)
+{
+    //select the internal format
+    GLenum internalFormat = 0;
+    switch (format)
+    {
+    case OGL_BLOCK_FORMAT_BC1: internalFormat = srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+    case OGL_BLOCK_FORMAT_BC3: internalFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+    case OGL_BLOCK_FORMAT_BC7: internalFormat = srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+    }
+    //count the levels of a full mip chain
+    uint32_t levelCount = 1;
+    if (mipmaps) {for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {++levelCount;}}
+    //allocate the image
+    this->allocate(internalFormat, width, height, levelCount, 1, 1);
+    //compress the first level from the input
+    compressLevel(pixels, width, height, format, this->data.data());
+    //create and compress the smaller levels
+    std::vector<uint8_t> level;
+    uint32_t w = width, h = height;
+    for (uint32_t i = 1; i < levelCount; ++i)
+    {
+        level = (i == 1) ? downsample(std::vector<uint8_t>(pixels, pixels + (size_t)width*height*4), w, h) : downsample(level, w, h);
+        compressLevel(level.data(), w, h, format, this->data.data() + this->levels[i].offset);
+    }
+}
+
+void OGL_CompressedImage::addLayers(const OGL_CompressedImage& other)
+{
+    //check if the images match
+    if (other.internalFormat != this->internalFormat || other.width != this->width || other.height != this->height ||
+        other.levels.size() != this->levels.size() || other.faces != this->faces)
+    {
+        std::__throw_runtime_error("The layers of compressed images must have the same format, size, levels and faces");
+    }
+    //store the old data
+    std::vector<uint8_t> oldData = std::move(this->data);
+    std::vector<OGL_CompressedLevel> oldLevels = this->levels;
+    //allocate the bigger image
+    this->allocate(this->internalFormat, this->width, this->height, oldLevels.size(), this->layers + other.layers, this->faces);
+    //copy the old and the new layers of each level after each other
+    for (size_t i = 0; i < this->levels.size(); ++i)
+    {
+        uint8_t* dst = this->data.data() + this->levels[i].offset;
+        memcpy(dst, oldData.data() + oldLevels[i].offset, oldLevels[i].size);
+        memcpy(dst + oldLevels[i].size, other.data.data() + other.levels[i].offset, other.levels[i].size);
+    }
+}
+
+void OGL_CompressedImage::makeCubemap()
+{
+    //the layers become the faces
+    if (this->layers != 6 || this->faces != 1) {std::__throw_runtime_error("A cubemap needs a compressed image with 6 layers of single faces");}
+    //the data is stored the same way
+    this->layers = 1;
+    this->faces = 6;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file OGL_DirtyRanges.cpp
+ * @author DM8AT
+ * @brief implement the tracking of modified ranges of buffers
+ * @version 0.1
+ * @date 2024-08-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+void OGL_DirtyRanges::mark(size_t offset, size_t size)
+{
+    //nothing to do for empty ranges
+    if (size == 0) {return;}
+    //store the new range, clamp the end if it would overflow
+    size_t begin = offset;
+    size_t end = (size > ((size_t)-1 - offset)) ? (size_t)-1 : offset + size;
+    //skip all ranges that end too far before the new range to merge with it
+    size_t first = 0;
+    while (first < this->ranges.size() && this->ranges[first].end < begin && (begin - this->ranges[first].end) > this->mergeDistance) {++first;}
+    //merge all ranges that start close enough to the end of the new range
+    size_t last = first;
+    while (last < this->ranges.size() && (this->ranges[last].begin <= end || (this->ranges[last].begin - end) <= this->mergeDistance))
+    {
+        //grow the new range to include the old one
+        if (this->ranges[last].begin < begin) {begin = this->ranges[last].begin;}
+        if (this->ranges[last].end > end) {end = this->ranges[last].end;}
+        ++last;
+    }
+    //replace the merged ranges with the new one
+    this->ranges.erase(this->ranges.begin() + first, this->ranges.begin() + last);
+    this->ranges.insert(this->ranges.begin() + first, OGL_DirtyRange{begin, end});
+    //check if too many ranges are tracked
+    if (this->ranges.size() > OGL_DIRTY_RANGE_MAX_COUNT)
+    {
+        //then upload everything between the first and the last modified byte as one range
+        OGL_DirtyRange all{this->ranges.front().begin, this->ranges.back().end};
+        this->ranges.clear();
+        this->ranges.push_back(all);
+    }
+}
+
+size_t OGL_DirtyRanges::flush(OGL_Instance* instance, GLenum target, GLuint buffer, const void* data, size_t size)
+{
+    //store the amount of uploaded bytes
+    size_t uploaded = 0;
+    //loop over all ranges
+    for (const OGL_DirtyRange& range : this->ranges)
+    {
+        //skip ranges that are completely behind the data
+        if (range.begin >= size) {continue;}
+        //clip the range to the data
+        size_t end = (range.end < size) ? range.end : size;
+        //upload the range
+        instance->bufferSubData(target, buffer, range.begin, end - range.begin, ((const uint8_t*)data) + range.begin);
+        //count the uploaded bytes
+        uploaded += end - range.begin;
+    }
+    //the GPU has the same data as the CPU now
+    this->ranges.clear();
+    //return the amount of uploaded bytes
+    return uploaded;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file OGL_DrawBatcher.cpp
+ * @author DM8AT
+ * @brief implement a batcher that merges draws into multi draw indirect calls
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+OGL_DrawBatcher::OGL_DrawBatcher(size_t drawDataSize, uint8_t dataUnit, GLenum mode)
+{
+    //store the settings
+    this->drawDataSize = drawDataSize;
+    this->dataUnit = dataUnit;
+    this->mode = mode;
+}
+
+OGL_DrawBatcher::~OGL_DrawBatcher()
+{
+    //delete the buffers
+    if (this->indirect) {delete this->indirect;}
+    if (this->data) {delete this->data;}
+}
+
+void OGL_DrawBatcher::add(OGL_Shader* shader, OGL_VertexAttributes* vertexAttributes, OGL_IndexBuffer* indexBuffer, uint32_t count, uint32_t firstIndex, int32_t baseVertex, uint32_t instanceCount, const void* drawData)
+{
+    //check if the draw has all objects it needs
+    if (!shader || !vertexAttributes || !indexBuffer) {std::__throw_runtime_error("Can't batch a draw without a shader, vertex attributes and an index buffer");}
+    //check if the last batch fits, consecutive draws mostly share it
+    uint32_t batch = this->lastBatch;
+    if (batch >= this->batches.size() || this->batches[batch].shader != shader || this->batches[batch].vertexAttributes != vertexAttributes || 
+        this->batches[batch].indexBuffer != indexBuffer)
+    {
+        //search the batch of the draw
+        batch = 0;
+        while (batch < this->batches.size() && (this->batches[batch].shader != shader || this->batches[batch].vertexAttributes != vertexAttributes || 
+               this->batches[batch].indexBuffer != indexBuffer)) {++batch;}
+        //create a new batch if none fits
+        if (batch == this->batches.size())
+        {
+            OGL_DrawBatch newBatch;
+            newBatch.shader = shader;
+            newBatch.vertexAttributes = vertexAttributes;
+            newBatch.indexBuffer = indexBuffer;
+            this->batches.push_back(newBatch);
+        }
+        this->lastBatch = batch;
+    }
+    //count the draw for the batch
+    ++this->batches[batch].commandCount;
+
+    //store the draw
+    OGL_BatchedDraw draw;
+    draw.batch = batch;
+    draw.command.count = count;
+    draw.command.instanceCount = instanceCount;
+    draw.command.firstIndex = firstIndex;
+    draw.command.baseVertex = baseVertex;
+    draw.dataOffset = this->drawData.size();
+    this->draws.push_back(draw);
+    //store the data of the draw
+    if (this->drawDataSize == 0) {return;}
+    if (drawData) {this->drawData.insert(this->drawData.end(), (const uint8_t*)drawData, (const uint8_t*)drawData + this->drawDataSize);}
+    else {this->drawData.resize(this->drawData.size() + this->drawDataSize, 0);}
+}
+
+void OGL_DrawBatcher::submit(bool useDrawCount)
+{
+    //nothing to draw
+    if (this->draws.empty()) {return;}
+    //get the instance to draw with
+    OGL_Instance* instance = oglGetCurrentInstance();
+    //check if an instance exists
+    if (!instance) {std::__throw_runtime_error("Can't submit draws without an instance");}
+    //create the buffers with the first submission
+    if (!this->indirect) {this->indirect = new OGL_DrawIndirectBuffer(std::vector<OGL_DrawElementsIndirectCommand>(), GL_DYNAMIC_DRAW);}
+    if (!this->data && this->drawDataSize != 0) {this->data = new OGL_ShaderStorageBuffer(0, 0, GL_DYNAMIC_DRAW);}
+
+    //the data of each batch is bound on its own, so it must start at an offset the context accepts
+    size_t alignment = (size_t)instance->getStorageBufferOffsetAlignment();
+    if (alignment == 0) {alignment = 1;}
+    //compute where the commands and the data of each batch start
+    uint32_t firstCommand = 0;
+    size_t dataSize = 0;
+    for (size_t i = 0; i < this->batches.size(); ++i)
+    {
+        this->batches[i].firstCommand = firstCommand;
+        this->batches[i].dataOffset = ((dataSize + alignment - 1) / alignment) * alignment;
+        firstCommand += this->batches[i].commandCount;
+        dataSize = this->batches[i].dataOffset + this->batches[i].commandCount * this->drawDataSize;
+        //the amount is counted again while the draws are sorted
+        this->batches[i].commandCount = 0;
+    }
+
+    //sort the commands and the data by their batch, the order inside a batch stays the order the draws where added in
+    this->commands.resize(this->draws.size());
+    this->sortedData.resize(dataSize);
+    for (size_t i = 0; i < this->draws.size(); ++i)
+    {
+        OGL_DrawBatch& batch = this->batches[this->draws[i].batch];
+        //store the command of the draw
+        this->commands[batch.firstCommand + batch.commandCount] = this->draws[i].command;
+        //copy the data of the draw
+        if (this->drawDataSize != 0)
+        {
+            memcpy(this->sortedData.data() + batch.dataOffset + batch.commandCount * this->drawDataSize, this->drawData.data() + this->draws[i].dataOffset, this->drawDataSize);
+        }
+        ++batch.commandCount;
+    }
+
+    //upload the commands and the amount of draws of each batch
+    this->indirect->setCommands(this->commands.data(), this->commands.size());
+    for (size_t i = 0; i < this->batches.size(); ++i) {this->indirect->setDrawCount(i, this->batches[i].commandCount);}
+    this->indirect->upload();
+    //upload the data of the draws
+    if (this->data)
+    {
+        this->data->updateData(this->sortedData.data(), this->sortedData.size());
+        this->data->upload();
+    }
+
+    //issue a single call for each batch
+    for (size_t i = 0; i < this->batches.size(); ++i)
+    {
+        OGL_DrawBatch& batch = this->batches[i];
+        //bind the state of the batch
+        batch.shader->bind();
+        batch.vertexAttributes->bind();
+        batch.indexBuffer->bind();
+        //bind the data of the batch, gl_DrawID starts at 0 for every call
+        if (this->data) {this->data->bindRange(this->dataUnit, (GLintptr)batch.dataOffset, (GLsizeiptr)(batch.commandCount * this->drawDataSize));}
+        //draw the batch
+        if (useDrawCount && instance->supportsDrawCount()) {this->indirect->drawCount(this->mode, i, batch.firstCommand, batch.commandCount);}
+        else {this->indirect->draw(this->mode, batch.firstCommand, batch.commandCount);}
+    }
+}
+
+void OGL_DrawBatcher::clear()
+{
+    //remove all draws, the memory stays reserved
+    this->draws.clear();
+    this->drawData.clear();
+    this->batches.clear();
+    this->lastBatch = 0;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file OGL_DrawIndirectBuffer.cpp
+ * @author DM8AT
+ * @brief implement buffers for indirect draw commands
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+//a macro to ensure that the correct window is bound
+#define correctInstanceBinding() if (oglGetCurrentInstance() != this->instance) {this->instance->makeCurrent();}
+/**
+ * @brief a mactor to check if the buffer is inalised
+ * 
+ * @param error the error message to print if the buffer is not initalised
+ */
+#define checkExistance(buffer, error) if (buffer == 0) { std::__throw_runtime_error(error); }
+
+OGL_DrawIndirectBuffer::OGL_DrawIndirectBuffer(std::vector<OGL_DrawElementsIndirectCommand> commands, GLenum usage)
+{
+    //store the usage hint
+    this->usage.setUsage(usage);
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //create a buffer
+    this->buffer = this->instance->createBuffer();
+    //store the commands
+    this->updateData(std::move(commands));
+    //upload the commands
+    this->upload();
+}
+
+OGL_DrawElementsIndirectCommand& OGL_DrawIndirectBuffer::operator[](size_t idx)
+{
+    //make sure the index is in range
+    if (idx >= this->commands.size())
+    {
+        //throw an error
+        std::__throw_runtime_error("The index to access is out of bunds for the draw indirect buffer");
+    }
+    //the command may be changed through the reference
+    this->dirty.mark(idx*sizeof(OGL_DrawElementsIndirectCommand), sizeof(OGL_DrawElementsIndirectCommand));
+    //return a reference to the command
+    return this->commands[idx];
+}
+
+void OGL_DrawIndirectBuffer::setDrawCount(size_t index, uint32_t count)
+{
+    //make sure the amount exists
+    if (index >= this->counts.size()) {this->counts.resize(index+1, 0);}
+    //only changed amounts must be uploaded
+    if (this->counts[index] == count) {return;}
+    //store the amount
+    this->counts[index] = count;
+    this->countsDirty = true;
+}
+
+void OGL_DrawIndirectBuffer::upload()
+{
+    //correct the instance binding
+    correctInstanceBinding()
+    //check if the buffer exists
+    checkExistance(this->buffer, "Can't upload data to a not existing draw indirect buffer")
+    //store the size of the commands in bytes
+    size_t size = this->commands.size() * sizeof(OGL_DrawElementsIndirectCommand);
+    //count the upload, if the usage hint changed the storage is re-allocated with the new hint
+    if (this->usage.recordUpload(this->instance->getFrame())) {this->gpuSize = 0;}
+    //check if the commands fit into the storage on the GPU
+    if (size <= this->gpuSize && this->gpuSize != 0)
+    {
+        //only upload the modified commands
+        this->dirty.flush(this->instance, GL_DRAW_INDIRECT_BUFFER, this->buffer, this->commands.data(), size);
+    }
+    else
+    {
+        //upload the commands
+        this->instance->bufferData(GL_DRAW_INDIRECT_BUFFER, this->buffer, size, this->commands.data(), this->usage.getUsage());
+        this->usage.recordReallocation();
+        //store the new size of the storage
+        this->gpuSize = size;
+        //the GPU has all commands now
+        this->dirty.clear();
+    }
+
+    //the amounts of draws are only read by the GPU if the context supports it
+    if (!this->countsDirty || !this->instance->supportsDrawCount()) {return;}
+    //create the buffer for the amounts if it dose not exist
+    if (this->countBuffer == 0) {this->countBuffer = this->instance->createBuffer();}
+    //store the size of the amounts in bytes
+    size = this->counts.size() * sizeof(uint32_t);
+    //the amounts are tiny, so they are always uploaded together
+    if (size <= this->countGpuSize)
+    {
+        this->instance->bufferSubData(GL_PARAMETER_BUFFER, this->countBuffer, 0, size, this->counts.data());
+    }
+    else
+    {
+        this->instance->bufferData(GL_PARAMETER_BUFFER, this->countBuffer, size, this->counts.data(), this->usage.getUsage());
+        this->countGpuSize = size;
+    }
+    //the GPU has all amounts now
+    this->countsDirty = false;
+}
+
+void OGL_DrawIndirectBuffer::bind()
+{
+    //correct the instance binding
+    correctInstanceBinding()
+    //check if the buffer exists
+    checkExistance(this->buffer, "Can't bind a non existing draw indirect buffer")
+    //bind the buffer
+    this->instance->bindBuffer(GL_DRAW_INDIRECT_BUFFER, this->buffer);
+}
+
+void OGL_DrawIndirectBuffer::unbind()
+{
+    //correct the instance binding
+    correctInstanceBinding()
+    //unbind the buffer
+    this->instance->bindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void OGL_DrawIndirectBuffer::bindStorage(uint8_t unit)
+{
+    //correct the instance binding
+    correctInstanceBinding()
+    //check if the buffer exists
+    checkExistance(this->buffer, "Can't bind a non existing draw indirect buffer")
+    //bind the commands to the binding point
+    this->instance->bindBufferBase(GL_SHADER_STORAGE_BUFFER, unit, this->buffer);
+}
+
+void OGL_DrawIndirectBuffer::bindCountStorage(uint8_t unit)
+{
+    //correct the instance binding
+    correctInstanceBinding()
+    //check if the amounts where uploaded
+    checkExistance(this->countBuffer, "Can't bind the amounts of draws before they where uploaded")
+    //bind the amounts to the binding point
+    this->instance->bindBufferBase(GL_SHADER_STORAGE_BUFFER, unit, this->countBuffer);
+}
+
+void OGL_DrawIndirectBuffer::draw(GLenum mode, size_t first, size_t count)
+{
+    //check if the commands are in range
+    if (first > this->commands.size()) {std::__throw_runtime_error("The first command to draw is out of bunds for the draw indirect buffer");}
+    //a count of 0 draws all following commands
+    if (count == 0 || (first + count) > this->commands.size()) {count = this->commands.size() - first;}
+    //nothing to draw
+    if (count == 0) {return;}
+    //bind the commands
+    this->bind();
+    //compute the offset of the first command in the buffer
+    const void* offset = (const void*)(first * sizeof(OGL_DrawElementsIndirectCommand));
+    //draw all commands with a single call if the context supports it
+    if (this->instance->supportsMultiDrawIndirect())
+    {
+        glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, offset, (GLsizei)count, sizeof(OGL_DrawElementsIndirectCommand));
+        return;
+    }
+    //else, issue the commands one by one
+    for (size_t i = 0; i < count; ++i)
+    {
+        glDrawElementsIndirect(mode, GL_UNSIGNED_INT, (const void*)((first + i) * sizeof(OGL_DrawElementsIndirectCommand)));
+    }
+}
+
+void OGL_DrawIndirectBuffer::drawCount(GLenum mode, size_t countIndex, size_t first, size_t maxCount)
+{
+    //check if the amount exists
+    if (countIndex >= this->counts.size()) {std::__throw_runtime_error("The amount of draws to read was never set for the draw indirect buffer");}
+    //check if the commands are in range
+    if (first > this->commands.size()) {std::__throw_runtime_error("The first command to draw is out of bunds for the draw indirect buffer");}
+    //a maximum of 0 allows all following commands
+    if (maxCount == 0 || (first + maxCount) > this->commands.size()) {maxCount = this->commands.size() - first;}
+    //without support, use the amount from the CPU
+    if (!this->instance->supportsDrawCount())
+    {
+        //draw at most the maximum amount
+        size_t count = (this->counts[countIndex] < maxCount) ? this->counts[countIndex] : maxCount;
+        if (count != 0) {this->draw(mode, first, count);}
+        return;
+    }
+    //nothing can be drawn
+    if (maxCount == 0) {return;}
+    //check if the amounts where uploaded
+    checkExistance(this->countBuffer, "Can't draw with an amount of draws that was not uploaded")
+    //bind the commands and the amounts
+    this->bind();
+    this->instance->bindBuffer(GL_PARAMETER_BUFFER, this->countBuffer);
+    //compute the offsets of the first command and the amount
+    const void* offset = (const void*)(first * sizeof(OGL_DrawElementsIndirectCommand));
+    GLintptr countOffset = (GLintptr)(countIndex * sizeof(uint32_t));
+    //draw with the amount stored on the GPU
+    if (GLEW_VERSION_4_6)
+    {
+        glMultiDrawElementsIndirectCount(mode, GL_UNSIGNED_INT, offset, countOffset, (GLsizei)maxCount, sizeof(OGL_DrawElementsIndirectCommand));
+    }
+    else
+    {
+        glMultiDrawElementsIndirectCountARB(mode, GL_UNSIGNED_INT, offset, countOffset, (GLsizei)maxCount, sizeof(OGL_DrawElementsIndirectCommand));
+    }
+}
+
+void OGL_DrawIndirectBuffer::onDestroy()
+{
+    //check if the buffers are intalised
+    if (this->buffer == 0 && this->countBuffer == 0) {return;}
+    //make sure to correct the instance binding
+    correctInstanceBinding()
+    //delete the buffer for the commands
+    if (this->buffer != 0)
+    {
+        //remove the buffer from the state cache
+        this->instance->forgetBuffer(this->buffer);
+        glDeleteBuffers(1, &this->buffer);
+        this->buffer = 0;
+    }
+    //delete the buffer for the amounts
+    if (this->countBuffer != 0)
+    {
+        //remove the buffer from the state cache
+        this->instance->forgetBuffer(this->countBuffer);
+        glDeleteBuffers(1, &this->countBuffer);
+        this->countBuffer = 0;
+    }
+}
@@ -0,0 +1,444 @@
+/**
+ * @file OGL_FrameGraph.cpp
+ * @author DM8AT
+ * @brief implement a frame graph that culls, orders and executes passes and shares the memory of transient textures
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+/**
+ * @brief add a value to a list if it is not in the list yet
+ * 
+ * @param list the list to add to
+ * @param value the value to add
+ */
+static void addUnique(std::vector<uint32_t>& list, uint32_t value)
+{
+    //check if the value exists
+    for (uint32_t v : list) {if (v == value) {return;}}
+    //add the value
+    list.push_back(value);
+}
+
+/**
+ * @brief get the attachment type for a texture from its internal format
+ * 
+ * @param internalFormat the internal format of the texture
+ * @return OGL_FramebufferAttachmentType the type of attachment the texture is attached as
+ */
+static OGL_FramebufferAttachmentType getAttachmentType(GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+    case GL_DEPTH_COMPONENT16: case GL_DEPTH_COMPONENT24: case GL_DEPTH_COMPONENT32: case GL_DEPTH_COMPONENT32F: return OGL_DEPTH_ATTACHMENT;
+    case GL_DEPTH24_STENCIL8: case GL_DEPTH32F_STENCIL8: return OGL_DEPTH_STENCIL_ATTACHMENT;
+    case GL_STENCIL_INDEX8: return OGL_STENCIL_ATTACHMENT;
+    default: return OGL_COLOR_ATTACHMENT;
+    }
+}
+
+OGL_FrameGraph::OGL_FrameGraph(OGL_RenderTargetPool* pool)
+{
+    //store the pool
+    this->pool = pool;
+}
+
+OGL_FrameGraph::~OGL_FrameGraph()
+{
+    //give back all textures and delete the framebuffers
+    this->clear();
+}
+
+uint32_t OGL_FrameGraph::createTexture(const std::string& name, uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples)
+{
+    //store the description, the storage is taken from the pool when the texture is first used
+    OGL_FrameGraphResource resource;
+    resource.name = name;
+    resource.width = width;
+    resource.height = height;
+    resource.internalFormat = internalFormat;
+    resource.samples = samples;
+    this->resources.push_back(resource);
+    //the lifetimes must be calculated again
+    this->dirty = true;
+    //return the handle
+    return this->resources.size() - 1;
+}
+
+uint32_t OGL_FrameGraph::importTexture(const std::string& name, OGL_Texture* texture)
+{
+    //check if the texture is valid
+    if (!texture) {std::__throw_runtime_error((std::string("Can't import the texture ") + name + " because it is a nullpointer").c_str());}
+    //store the texture
+    OGL_FrameGraphResource resource;
+    resource.name = name;
+    resource.width = texture->getWidth();
+    resource.height = texture->getHeight();
+    resource.internalFormat = texture->getInternalFormat();
+    resource.samples = texture->getSamples();
+    resource.texture = texture;
+    resource.imported = true;
+    this->resources.push_back(resource);
+    //the passes must be culled again
+    this->dirty = true;
+    //return the handle
+    return this->resources.size() - 1;
+}
+
+uint32_t OGL_FrameGraph::importRenderbuffer(const std::string& name, OGL_Renderbuffer* renderbuffer)
+{
+    //check if the renderbuffer is valid
+    if (!renderbuffer) {std::__throw_runtime_error((std::string("Can't import the renderbuffer ") + name + " because it is a nullpointer").c_str());}
+    //store the renderbuffer
+    OGL_FrameGraphResource resource;
+    resource.name = name;
+    resource.width = renderbuffer->getWidth();
+    resource.height = renderbuffer->getHeight();
+    resource.internalFormat = renderbuffer->getInternalFormat();
+    resource.samples = renderbuffer->getSamples();
+    resource.renderbuffer = renderbuffer;
+    resource.imported = true;
+    this->resources.push_back(resource);
+    //the passes must be culled again
+    this->dirty = true;
+    //return the handle
+    return this->resources.size() - 1;
+}
+
+void OGL_FrameGraph::setTextureSize(uint32_t resource, uint32_t width, uint32_t height)
+{
+    //check if the handle is valid
+    if (resource >= this->resources.size()) {std::__throw_runtime_error("Can't resize a texture that dose not belong to the frame graph");}
+    //imported textures are resized by the user
+    if (this->resources[resource].imported) {return;}
+    //store the size, the next texture from the pool has it
+    this->resources[resource].width = width;
+    this->resources[resource].height = height;
+}
+
+void OGL_FrameGraph::markOutput(uint32_t resource)
+{
+    //check if the handle is valid
+    if (resource >= this->resources.size()) {std::__throw_runtime_error("Can't mark a texture that dose not belong to the frame graph as output");}
+    //mark the texture
+    this->resources[resource].output = true;
+    //the passes must be culled again
+    this->dirty = true;
+}
+
+uint32_t OGL_FrameGraph::addPass(const std::string& name, void (*execute)(OGL_FrameGraph*, uint32_t, void*), void* userData)
+{
+    //store the pass
+    this->passes.emplace_back();
+    OGL_FrameGraphPass& pass = this->passes.back();
+    pass.name = name;
+    pass.execute = execute;
+    pass.userData = userData;
+    //the passes must be ordered again
+    this->dirty = true;
+    //return the handle
+    return this->passes.size() - 1;
+}
+
+void OGL_FrameGraph::read(uint32_t pass, uint32_t resource)
+{
+    //check if the handles are valid
+    if (pass >= this->passes.size() || resource >= this->resources.size()) {std::__throw_runtime_error("Can't read a texture or from a pass that dose not belong to the frame graph");}
+    //renderbuffers can't be sampled
+    if (this->resources[resource].renderbuffer) {std::__throw_runtime_error((std::string("Can't read the renderbuffer ") + this->resources[resource].name + " in a pass").c_str());}
+    //store the read
+    addUnique(this->passes[pass].reads, resource);
+    //the passes must be ordered again
+    this->dirty = true;
+}
+
+void OGL_FrameGraph::write(uint32_t pass, uint32_t resource, const OGL_AttachmentOps& ops)
+{
+    //check if the handles are valid
+    if (pass >= this->passes.size() || resource >= this->resources.size()) {std::__throw_runtime_error("Can't write a texture or from a pass that dose not belong to the frame graph");}
+    //store the write
+    OGL_FrameGraphWrite write;
+    write.resource = resource;
+    write.ops = ops;
+    this->passes[pass].writes.push_back(write);
+    //the passes must be ordered again
+    this->dirty = true;
+}
+
+void OGL_FrameGraph::writeBackbuffer(uint32_t pass, const OGL_AttachmentOps& color, const OGL_AttachmentOps& depth)
+{
+    //check if the handle is valid
+    if (pass >= this->passes.size()) {std::__throw_runtime_error("Can't write to the default framebuffer from a pass that dose not belong to the frame graph");}
+    //store the operations for the default framebuffer
+    this->passes[pass].backbuffer = {color, depth};
+    //the passes must be culled again
+    this->dirty = true;
+}
+
+void OGL_FrameGraph::keepPass(uint32_t pass)
+{
+    //check if the handle is valid
+    if (pass >= this->passes.size()) {std::__throw_runtime_error("Can't keep a pass that dose not belong to the frame graph");}
+    //mark the pass
+    this->passes[pass].keep = true;
+    //the passes must be culled again
+    this->dirty = true;
+}
+
+void OGL_FrameGraph::compile()
+{
+    //reset all passes, the framebuffers are created again because the attachments may have changed
+    for (OGL_FrameGraphPass& pass : this->passes)
+    {
+        pass.dependencies.clear();
+        pass.after.clear();
+        pass.culled = true;
+        delete pass.framebuffer;
+        pass.framebuffer = 0;
+    }
+
+    //find the dependencies for every texture in the order the passes where added
+    for (uint32_t r = 0; r < this->resources.size(); ++r)
+    {
+        //store the last pass that wrote to the texture, the passes that read it since then and the passes that read it before any pass wrote to it
+        int64_t lastWriter = -1;
+        int64_t firstWriter = -1;
+        std::vector<uint32_t> readers;
+        std::vector<uint32_t> earlyReaders;
+        for (uint32_t p = 0; p < this->passes.size(); ++p)
+        {
+            OGL_FrameGraphPass& pass = this->passes[p];
+            //check how the pass uses the texture
+            bool reads = false;
+            for (uint32_t read : pass.reads) {if (read == r) {reads = true;}}
+            bool writes = false;
+            for (const OGL_FrameGraphWrite& write : pass.writes) {if (write.resource == r) {writes = true;}}
+            //a read uses the result of the last writer
+            if (reads)
+            {
+                if (lastWriter < 0) {earlyReaders.push_back(p);}
+                else
+                {
+                    if (lastWriter != p) {addUnique(pass.dependencies, lastWriter);}
+                    readers.push_back(p);
+                }
+            }
+            //a write builds on the result of the last writer and must wait for all passes that read the old content
+            if (writes)
+            {
+                if (lastWriter >= 0 && lastWriter != p) {addUnique(pass.dependencies, lastWriter);}
+                for (uint32_t reader : readers) {if (reader != p) {addUnique(pass.after, reader);}}
+                readers.clear();
+                if (firstWriter < 0) {firstWriter = p;}
+                lastWriter = p;
+            }
+        }
+        //passes that read the texture before it was written in the order of adding use the result of the first writer
+        if (firstWriter >= 0) {for (uint32_t reader : earlyReaders) {if (reader != firstWriter) {addUnique(this->passes[reader].dependencies, firstWriter);}}}
+    }
+
+    //collect the passes whose results are visible outside of the frame graph
+    std::vector<uint32_t> stack;
+    for (uint32_t p = 0; p < this->passes.size(); ++p)
+    {
+        OGL_FrameGraphPass& pass = this->passes[p];
+        bool root = pass.keep || !pass.backbuffer.empty();
+        for (const OGL_FrameGraphWrite& write : pass.writes) {if (this->resources[write.resource].imported || this->resources[write.resource].output) {root = true;}}
+        if (root) {pass.culled = false; stack.push_back(p);}
+    }
+    //keep all passes whose results are used by a kept pass
+    while (!stack.empty())
+    {
+        uint32_t p = stack.back();
+        stack.pop_back();
+        for (uint32_t dependency : this->passes[p].dependencies)
+        {
+            if (!this->passes[dependency].culled) {continue;}
+            this->passes[dependency].culled = false;
+            stack.push_back(dependency);
+        }
+    }
+
+    //the dependencies must be executed first too
+    for (OGL_FrameGraphPass& pass : this->passes) {for (uint32_t dependency : pass.dependencies) {addUnique(pass.after, dependency);}}
+    //order the passes. The earliest added pass that can run is executed next, so the order of adding is kept where possible
+    this->order.clear();
+    std::vector<bool> done(this->passes.size(), false);
+    size_t alive = this->passes.size() - this->getCulledPassCount();
+    while (this->order.size() < alive)
+    {
+        int64_t next = -1;
+        for (uint32_t p = 0; p < this->passes.size() && next < 0; ++p)
+        {
+            if (done[p] || this->passes[p].culled) {continue;}
+            //check if all passes that must run first are done or culled
+            bool ready = true;
+            for (uint32_t before : this->passes[p].after) {if (!done[before] && !this->passes[before].culled) {ready = false;}}
+            if (ready) {next = p;}
+        }
+        //without a pass that can run, the passes depend on each other
+        if (next < 0) {std::__throw_runtime_error("The passes of the frame graph depend on each other in a cycle");}
+        done[next] = true;
+        this->order.push_back(next);
+    }
+
+    //calculate the lifetimes of the textures in the execution order
+    for (OGL_FrameGraphResource& resource : this->resources) {resource.firstUse = UINT32_MAX; resource.lastUse = 0;}
+    for (uint32_t i = 0; i < this->order.size(); ++i)
+    {
+        OGL_FrameGraphPass& pass = this->passes[this->order[i]];
+        std::vector<uint32_t> used = pass.reads;
+        for (const OGL_FrameGraphWrite& write : pass.writes) {used.push_back(write.resource);}
+        for (uint32_t r : used)
+        {
+            if (this->resources[r].firstUse == UINT32_MAX) {this->resources[r].firstUse = i;}
+            this->resources[r].lastUse = i;
+        }
+    }
+    //outputs live until the next execution
+    for (OGL_FrameGraphResource& resource : this->resources) {if (resource.output) {resource.lastUse = UINT32_MAX;}}
+
+    //the frame graph is up to date
+    this->dirty = false;
+}
+
+void OGL_FrameGraph::execute()
+{
+    //check if the frame graph can get transient textures
+    if (!this->pool) {std::__throw_runtime_error("Can't execute a frame graph without a render target pool");}
+    //cull and order the passes if something changed
+    if (this->dirty) {this->compile();}
+    //give back the outputs of the last execution
+    for (uint32_t r = 0; r < this->resources.size(); ++r) {this->releaseTexture(r);}
+
+    //reset the statistics
+    this->aliases = 0;
+    this->peakMemory = 0;
+    size_t liveMemory = 0;
+    //store the textures that where handed out in this execution to count the shared ones
+    std::vector<OGL_Texture*> handedOut;
+    for (uint32_t i = 0; i < this->order.size(); ++i)
+    {
+        uint32_t p = this->order[i];
+        OGL_FrameGraphPass& pass = this->passes[p];
+        //get the storage for the transient textures that are used the first time
+        for (OGL_FrameGraphResource& resource : this->resources)
+        {
+            if (resource.imported || resource.firstUse != i) {continue;}
+            resource.texture = this->pool->acquire(resource.width, resource.height, resource.internalFormat, resource.samples);
+            //a texture that was given back in this execution shares its memory with the earlier texture
+            bool shared = false;
+            for (OGL_Texture* texture : handedOut) {if (texture == resource.texture) {shared = true;}}
+            if (shared) {++this->aliases;}
+            else {handedOut.push_back(resource.texture);}
+            //count the memory that is used now
+            liveMemory += resource.texture->getMemorySize();
+            if (liveMemory > this->peakMemory) {this->peakMemory = liveMemory;}
+        }
+
+        //render into the attachments or the default framebuffer
+        bool renders = !pass.writes.empty() || !pass.backbuffer.empty();
+        if (!pass.writes.empty()) {this->prepareFramebuffer(p, i);}
+        else if (!pass.backbuffer.empty()) {pass.renderPass = OGL_RenderPass(0, pass.backbuffer);}
+        if (renders) {pass.renderPass.begin();}
+        if (pass.execute) {pass.execute(this, p, pass.userData);}
+        if (renders) {pass.renderPass.end();}
+
+        //give back the transient textures that are not used anymore
+        for (uint32_t r = 0; r < this->resources.size(); ++r)
+        {
+            OGL_FrameGraphResource& resource = this->resources[r];
+            if (resource.imported || !resource.texture || resource.lastUse != i) {continue;}
+            liveMemory -= resource.texture->getMemorySize();
+            this->releaseTexture(r);
+        }
+    }
+    //delete textures that are not needed anymore, like textures of old sizes
+    this->pool->trim();
+}
+
+void OGL_FrameGraph::clear()
+{
+    //give back all transient textures
+    for (uint32_t r = 0; r < this->resources.size(); ++r) {this->releaseTexture(r);}
+    //delete all framebuffers
+    for (OGL_FrameGraphPass& pass : this->passes) {delete pass.framebuffer;}
+    //remove everything
+    this->resources.clear();
+    this->passes.clear();
+    this->order.clear();
+    this->dirty = true;
+}
+
+size_t OGL_FrameGraph::getCulledPassCount()
+{
+    //count the culled passes
+    size_t culled = 0;
+    for (const OGL_FrameGraphPass& pass : this->passes) {if (pass.culled) {++culled;}}
+    return culled;
+}
+
+void OGL_FrameGraph::releaseTexture(uint32_t resource)
+{
+    //imported textures and textures without storage are not given back
+    OGL_FrameGraphResource& res = this->resources[resource];
+    if (res.imported || !res.texture) {return;}
+    //give the texture back to the pool
+    if (this->pool) {this->pool->release(res.texture);}
+    res.texture = 0;
+}
+
+void OGL_FrameGraph::prepareFramebuffer(uint32_t pass, uint32_t position)
+{
+    OGL_FrameGraphPass& p = this->passes[pass];
+    //check if the framebuffer exists
+    if (p.framebuffer)
+    {
+        //use the textures of this execution, the framebuffer re-attaches them when it is bound
+        for (size_t i = 0; i < p.writes.size(); ++i)
+        {
+            (*p.framebuffer)[i].texture = this->resources[p.writes[i].resource].texture;
+            (*p.framebuffer)[i].renderbuffer = this->resources[p.writes[i].resource].renderbuffer;
+        }
+    }
+    else
+    {
+        //create the attachments in the order of the writes, color attachments are numbered in that order
+        std::vector<OGL_FramebufferAttachment> attachments;
+        uint8_t colorID = 0;
+        for (const OGL_FrameGraphWrite& write : p.writes)
+        {
+            OGL_FramebufferAttachment attachment;
+            attachment.texture = this->resources[write.resource].texture;
+            attachment.renderbuffer = this->resources[write.resource].renderbuffer;
+            attachment.type = getAttachmentType(this->resources[write.resource].internalFormat);
+            if (attachment.type == OGL_COLOR_ATTACHMENT) {attachment.attachmentID = colorID++;}
+            attachments.push_back(attachment);
+        }
+        p.framebuffer = new OGL_Framebuffer(attachments);
+    }
+    //transient content that was not written before is not loaded, content that is not read again is not stored
+    std::vector<OGL_AttachmentOps> ops;
+    for (const OGL_FrameGraphWrite& write : p.writes)
+    {
+        OGL_AttachmentOps op = write.ops;
+        const OGL_FrameGraphResource& resource = this->resources[write.resource];
+        if (!resource.imported && resource.firstUse == position && op.load == OGL_LOAD_OP_LOAD) {op.load = OGL_LOAD_OP_DONT_CARE;}
+        if (!resource.imported && resource.lastUse == position) {op.store = OGL_STORE_OP_DISCARD;}
+        ops.push_back(op);
+    }
+    p.renderPass = OGL_RenderPass(p.framebuffer, ops);
+    //render to the requested size of the first attachment, the textures of the pool may be bigger. Imported attachments may be resized by the user
+    const OGL_FrameGraphResource& first = this->resources[p.writes[0].resource];
+    if (first.renderbuffer) {p.renderPass.setViewport(0, 0, first.renderbuffer->getWidth(), first.renderbuffer->getHeight());}
+    else if (first.imported) {p.renderPass.setViewport(0, 0, first.texture->getWidth(), first.texture->getHeight());}
+    else {p.renderPass.setViewport(0, 0, first.width, first.height);}
+}
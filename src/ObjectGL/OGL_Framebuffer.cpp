@@ -17,10 +17,38 @@
 //a macro to ensure that the correct window is bound
 #define correctInstanceBinding() if (oglGetCurrentInstance() != this->instance) {this->instance->makeCurrent();}
 
+/**
+ * @brief get the OpenGL object that an attachment attaches
+ * 
+ * @param attachment the attachment
+ * @return GLuint the OpenGL renderbuffer or texture, or 0 if the attachment has neither
+ */
+static GLuint getAttachedObject(const OGL_FramebufferAttachment& attachment)
+{
+    //renderbuffers are used instead of the texture
+    if (attachment.renderbuffer) {return attachment.renderbuffer->getRenderbuffer();}
+    //else, return the texture
+    return attachment.texture ? attachment.texture->getTexture() : 0;
+}
+
+/**
+ * @brief get the storage generation of the texture an attachment attaches
+ * 
+ * @param attachment the attachment
+ * @return uint64_t the storage generation of the texture, or 0 for renderbuffers. Renderbuffers keep they're OpenGL object when they get new storage
+ */
+static uint64_t getAttachedGeneration(const OGL_FramebufferAttachment& attachment)
+{
+    //renderbuffers are used instead of the texture
+    if (attachment.renderbuffer) {return 0;}
+    //else, return the generation of the texture
+    return attachment.texture ? attachment.texture->getStorageGeneration() : 0;
+}
+
 OGL_Framebuffer::OGL_Framebuffer(std::vector<OGL_FramebufferAttachment> attachments)
 {
     //create the framebuffer
-    glGenFramebuffers(1, &this->framebuffer);
+    this->framebuffer = this->instance->createFramebuffer();
     //store the attachments
     this->attachments = attachments;
     //apply the attachments
@@ -29,41 +57,53 @@ OGL_Framebuffer::OGL_Framebuffer(std::vector<OGL_FramebufferAttachment> attachme
 
 void OGL_Framebuffer::updateAttachmentBindings()
 {
-    //bind the framebuffer
-    this->bind(GL_FRAMEBUFFER);
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //store the textures and renderbuffers that are bound now, so binding the framebuffer dose not update the attachments again
+    this->boundTextures.resize(this->attachments.size());
+    this->boundGenerations.resize(this->attachments.size());
+    for (size_t i = 0; i < this->attachments.size(); ++i)
+    {
+        this->boundTextures[i] = getAttachedObject(this->attachments[i]);
+        this->boundGenerations[i] = getAttachedGeneration(this->attachments[i]);
+    }
+    //store if direct state access is used
+    bool dsa = this->instance->usingDSA();
+    //without direct state access, bind the framebuffer
+    if (!dsa) {this->bind(GL_FRAMEBUFFER);}
     //loop over all attachments
     for (size_t i = 0; i < this->attachments.size(); ++i)
     {
         //quick safty check that the pointer is valid
-        if (!this->attachments[i].texture)
+        if (!this->attachments[i].texture && !this->attachments[i].renderbuffer)
         {
             //throw an error
-            std::__throw_runtime_error("One or more of the color attachments is a nullpointer");
+            std::__throw_runtime_error("One or more of the attachments has neither a texture nor a renderbuffer");
         }
+        //an attached object without an OpenGL object was moved from, attaching it would silently detach the attachment
+        if (!getAttachedObject(this->attachments[i])) {std::__throw_runtime_error("An attached texture or renderbuffer has no OpenGL object, it was moved from, evicted or has no storage");}
         //store the attachment
-        GLenum attachment = GL_COLOR_ATTACHMENT0;
-        //get the type of identifyer to use
-        switch (this->attachments[i].type)
+        GLenum attachment = this->getAttachmentPoint(i);
+        //check if a renderbuffer is attached
+        if (this->attachments[i].renderbuffer)
         {
-        case OGL_COLOR_ATTACHMENT:
-            //store the correct color attachment
-            attachment += this->attachments[i].attachmentID;
-            break;
-        case OGL_DEPTH_ATTACHMENT:
-            //store that this is a depth attachment
-            attachment = GL_DEPTH_ATTACHMENT;
-            break;
-        case OGL_STENCIL_ATTACHMENT:
-            //store that this is a stencil attachment
-            attachment = GL_STENCIL_ATTACHMENT;
-            break;
-        case OGL_DEPTH_STENCIL_ATTACHMENT:
-            //store that this is a depth and stencil attachment
-            attachment = GL_DEPTH_STENCIL_ATTACHMENT;
-            break;
-        
-        default:
-            break;
+            //attach the renderbuffer
+            GLuint rbo = this->attachments[i].renderbuffer->getRenderbuffer();
+            if (dsa) {glNamedFramebufferRenderbuffer(this->framebuffer, attachment, GL_RENDERBUFFER, rbo);}
+            else {glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, rbo);}
+            continue;
+        }
+        //check if direct state access is used
+        if (dsa)
+        {
+            //store the texture
+            GLuint tex = this->attachments[i].texture->getTexture();
+            //simple 2D textures and multisample textures are attached as a whole
+            OGL_TextureType type = this->attachments[i].texture->getType();
+            if (type == OGL_TEXTURE_2D || type == OGL_TEXTURE_2D_MULTISAMPLE) {glNamedFramebufferTexture(this->framebuffer, attachment, tex, 0);}
+            //cubemap faces and array slices are attached as layers
+            else {glNamedFramebufferTextureLayer(this->framebuffer, attachment, tex, 0, this->attachments[i].layerSelect);}
+            continue;
         }
         //identify the texture type
         switch (this->attachments[i].texture->getType())
@@ -73,6 +113,11 @@ void OGL_Framebuffer::updateAttachmentBindings()
             glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, this->attachments[i].texture->getTexture(), 0);
             break;
 
+        case OGL_TEXTURE_2D_MULTISAMPLE:
+            //attach all samples of a multisample texture
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D_MULTISAMPLE, this->attachments[i].texture->getTexture(), 0);
+            break;
+
         case OGL_TEXTURE_CUBEMAP:
             //attach a cubemap face
             glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_CUBE_MAP_POSITIVE_X + this->attachments[i].layerSelect, this->attachments[i].texture->getTexture(), 0);
@@ -87,8 +132,31 @@ void OGL_Framebuffer::updateAttachmentBindings()
             break;
         }
     }
+    //store the draw buffers, the draw buffer at an index writes to the color attachment with the same ID
+    std::vector<GLenum> drawBuffers;
+    for (const OGL_FramebufferAttachment& attachment : this->attachments)
+    {
+        //only color attachments are draw buffers
+        if (attachment.type != OGL_COLOR_ATTACHMENT) {continue;}
+        //make sure the draw buffer exists, unused draw buffers write nowhere
+        if (drawBuffers.size() <= attachment.attachmentID) {drawBuffers.resize(attachment.attachmentID + 1, GL_NONE);}
+        drawBuffers[attachment.attachmentID] = GL_COLOR_ATTACHMENT0 + attachment.attachmentID;
+    }
+    //without color attachments, nothing is drawn or read
+    if (drawBuffers.empty()) {drawBuffers.push_back(GL_NONE);}
+    //write to all color attachments at once
+    if (dsa)
+    {
+        glNamedFramebufferDrawBuffers(this->framebuffer, drawBuffers.size(), drawBuffers.data());
+        glNamedFramebufferReadBuffer(this->framebuffer, drawBuffers[0]);
+    }
+    else
+    {
+        glDrawBuffers(drawBuffers.size(), drawBuffers.data());
+        glReadBuffer(drawBuffers[0]);
+    }
     //store if the framebuffer is compleate
-    GLenum compleate = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    GLenum compleate = dsa ? glCheckNamedFramebufferStatus(this->framebuffer, GL_FRAMEBUFFER) : glCheckFramebufferStatus(GL_FRAMEBUFFER);
     //check if the framebuffer is compleate
     if (compleate != GL_FRAMEBUFFER_COMPLETE)
     {
@@ -97,12 +165,74 @@ void OGL_Framebuffer::updateAttachmentBindings()
     }
 }
 
+GLenum OGL_Framebuffer::getAttachmentPoint(size_t index)
+{
+    //get the type of identifyer to use
+    switch (this->attachments[index].type)
+    {
+    case OGL_COLOR_ATTACHMENT:
+        //return the correct color attachment
+        return GL_COLOR_ATTACHMENT0 + this->attachments[index].attachmentID;
+    case OGL_DEPTH_ATTACHMENT:
+        //return that this is a depth attachment
+        return GL_DEPTH_ATTACHMENT;
+    case OGL_STENCIL_ATTACHMENT:
+        //return that this is a stencil attachment
+        return GL_STENCIL_ATTACHMENT;
+    case OGL_DEPTH_STENCIL_ATTACHMENT:
+        //return that this is a depth and stencil attachment
+        return GL_DEPTH_STENCIL_ATTACHMENT;
+    
+    default:
+        return GL_COLOR_ATTACHMENT0;
+    }
+}
+
+bool OGL_Framebuffer::attachmentsChanged()
+{
+    //check if attachments where added or removed
+    if (this->boundTextures.size() != this->attachments.size()) {return true;}
+    //check if an attachment uses an other texture or renderbuffer now. Textures get a new OpenGL texture when their storage changes, which may have the name of the old one
+    for (size_t i = 0; i < this->attachments.size(); ++i)
+    {
+        if (this->boundTextures[i] != getAttachedObject(this->attachments[i])) {return true;}
+        if (this->boundGenerations[i] != getAttachedGeneration(this->attachments[i])) {return true;}
+    }
+    //nothing changed
+    return false;
+}
+
 void OGL_Framebuffer::bind(GLenum target)
 {
     //make sure to bind the correct instance
     correctInstanceBinding()
+    //re-attach textures that got new storage
+    if (this->attachmentsChanged()) {this->updateAttachmentBindings();}
     //bind to the requested buffer
-    glBindFramebuffer(target, this->framebuffer);
+    this->instance->bindFramebuffer(target, this->framebuffer);
+}
+
+void OGL_Framebuffer::blit(OGL_Framebuffer* target, GLint srcX, GLint srcY, GLint srcWidth, GLint srcHeight, GLint dstX, GLint dstY, GLint dstWidth, GLint dstHeight, GLbitfield mask, GLenum filter)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //re-attach textures that got new storage in both framebuffers
+    if (this->attachmentsChanged()) {this->updateAttachmentBindings();}
+    if (target && target->attachmentsChanged()) {target->updateAttachmentBindings();}
+    //store the framebuffer to write to, 0 is the default framebuffer
+    GLuint dst = target ? target->framebuffer : 0;
+    //check if direct state access is used
+    if (this->instance->usingDSA())
+    {
+        //copy without binding the framebuffers
+        glBlitNamedFramebuffer(this->framebuffer, dst, srcX, srcY, srcX + srcWidth, srcY + srcHeight, dstX, dstY, dstX + dstWidth, dstY + dstHeight, mask, filter);
+        return;
+    }
+    //bind this framebuffer for reading and the target for drawing
+    this->instance->bindFramebuffer(GL_READ_FRAMEBUFFER, this->framebuffer);
+    this->instance->bindFramebuffer(GL_DRAW_FRAMEBUFFER, dst);
+    //copy the pixels
+    glBlitFramebuffer(srcX, srcY, srcX + srcWidth, srcY + srcHeight, dstX, dstY, dstX + dstWidth, dstY + dstHeight, mask, filter);
 }
 
 void OGL_Framebuffer::unbind(GLenum target)
@@ -110,13 +240,15 @@ void OGL_Framebuffer::unbind(GLenum target)
     //make sure to bind the correct instance
     correctInstanceBinding()
     //unbind the requested target
-    glBindFramebuffer(target, 0);
+    this->instance->bindFramebuffer(target, 0);
 }
 
 void OGL_Framebuffer::onDestroy()
 {
     //bind the correct instance
     correctInstanceBinding()
+    //remove the framebuffer from the state cache
+    this->instance->forgetFramebuffer(this->framebuffer);
     //delete the framebuffer
     glDeleteFramebuffers(1, &this->framebuffer);
     //clear the attachments
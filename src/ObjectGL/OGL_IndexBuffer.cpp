@@ -23,14 +23,32 @@
  */
 #define checkExistance(buffer, error) if (buffer == 0) { std::__throw_runtime_error(error); }
 
-OGL_IndexBuffer::OGL_IndexBuffer(std::vector<uint32_t> indices)
+OGL_IndexBuffer::OGL_IndexBuffer(std::vector<uint32_t> indices, GLenum usage)
 {
+    //store the usage hint
+    this->usage.setUsage(usage);
     //make sure to bind the correct instance
     correctInstanceBinding()
     //create a buffer
-    glGenBuffers(1, &this->ibo);
+    this->ibo = this->instance->createBuffer();
     //store the new data
-    this->updateData(indices);
+    this->updateData(std::move(indices));
+    //upload the data
+    this->upload();
+    //bind this buffer
+    this->bind();
+}
+
+OGL_IndexBuffer::OGL_IndexBuffer(const uint32_t* indices, size_t count, GLenum usage)
+{
+    //store the usage hint
+    this->usage.setUsage(usage);
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //create a buffer
+    this->ibo = this->instance->createBuffer();
+    //store the new data
+    this->indices.assign(indices, indices + count);
     //upload the data
     this->upload();
     //bind this buffer
@@ -43,14 +61,32 @@ void OGL_IndexBuffer::upload()
     correctInstanceBinding()
     //check if the buffer exists
     checkExistance(this->ibo, "Can't upload data to a not existing index buffer")
-    //bind the buffer
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ibo);
+    //the indices must be on the CPU
+    this->checkCPUData();
+    //store the size of the indices in bytes
+    size_t size = this->indices.size() * sizeof(uint32_t);
+    //count the upload, if the usage hint changed the storage is re-allocated with the new hint
+    if (this->usage.recordUpload(this->instance->getFrame())) {this->gpuSize = 0;}
+    //check if the indices fit into the storage on the GPU
+    if (size <= this->gpuSize && this->gpuSize != 0)
+    {
+        //only upload the modified indices
+        this->dirty.flush(this->instance, GL_ELEMENT_ARRAY_BUFFER, this->ibo, this->indices.data(), size);
+        return;
+    }
     //upload the data
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(uint32_t), this->indices.data(), GL_STATIC_DRAW);
+    this->instance->bufferData(GL_ELEMENT_ARRAY_BUFFER, this->ibo, size, this->indices.data(), this->usage.getUsage());
+    this->usage.recordReallocation();
+    //store the new size of the storage
+    this->gpuSize = size;
+    //the GPU has all indices now
+    this->dirty.clear();
 }
 
 void OGL_IndexBuffer::setElement(uint32_t index, size_t idx)
 {
+    //the indices must be on the CPU
+    this->checkCPUData();
     //make sure the index is in range
     if (idx > this->indices.size())
     {
@@ -60,10 +96,14 @@ void OGL_IndexBuffer::setElement(uint32_t index, size_t idx)
     }
     //store the element
     this->indices[idx] = index;
+    //only the changed element must be uploaded
+    this->dirty.mark(idx*sizeof(uint32_t), sizeof(uint32_t));
 }
 
 uint32_t OGL_IndexBuffer::getElement(size_t idx)
 {
+    //the indices must be on the CPU
+    this->checkCPUData();
     //make sure the index is in range
     if (idx > this->indices.size())
     {
@@ -77,6 +117,8 @@ uint32_t OGL_IndexBuffer::getElement(size_t idx)
 
 uint32_t* OGL_IndexBuffer::getElementPtr(size_t idx)
 {
+    //the indices must be on the CPU
+    this->checkCPUData();
     //make sure the index is in range
     if (idx > this->indices.size())
     {
@@ -84,22 +126,59 @@ uint32_t* OGL_IndexBuffer::getElementPtr(size_t idx)
         std::__throw_runtime_error("The index to access is out of bunds for the element array buffer");
         return 0;
     }
+    //the element may be changed through the pointer
+    this->dirty.mark(idx*sizeof(uint32_t), sizeof(uint32_t));
     //return a pointer to the element
     return &this->indices[idx];
 }
 
 uint32_t& OGL_IndexBuffer::operator[](size_t idx)
 {
+    //the indices must be on the CPU
+    this->checkCPUData();
     //make sure the index is in range
     if (idx > this->indices.size())
     {
         //throw an error
         std::__throw_runtime_error("The index to access is out of bunds for the element array buffer");
     }
+    //the element may be changed through the reference
+    this->dirty.mark(idx*sizeof(uint32_t), sizeof(uint32_t));
     //return a reference to the element
     return this->indices[idx];
 }
 
+void OGL_IndexBuffer::releaseCPUData()
+{
+    //upload the changes
+    this->upload();
+    //free the indices
+    this->indices.clear();
+    this->indices.shrink_to_fit();
+    //the buffer is now only on the GPU
+    this->gpuOnly = true;
+}
+
+void OGL_IndexBuffer::uploadGPUOnly(const uint32_t* indices, size_t count)
+{
+    //correct the instance binding
+    correctInstanceBinding()
+    //create the buffer if it dose not exist
+    if (this->ibo == 0) {this->ibo = this->instance->createBuffer();}
+    //free the indices on the CPU
+    this->indices.clear();
+    this->indices.shrink_to_fit();
+    this->dirty.clear();
+    //count the upload
+    this->usage.recordUpload(this->instance->getFrame());
+    //upload the indices
+    this->gpuSize = count * sizeof(uint32_t);
+    this->instance->bufferData(GL_ELEMENT_ARRAY_BUFFER, this->ibo, this->gpuSize, indices, this->usage.getUsage());
+    this->usage.recordReallocation();
+    //the buffer is now only on the GPU
+    this->gpuOnly = true;
+}
+
 void OGL_IndexBuffer::bind()
 {
     //correct the instance binding
@@ -107,7 +186,7 @@ void OGL_IndexBuffer::bind()
     //check if the buffer exists
     checkExistance(this->ibo, "Can't bind a non existing index buffer")
     //bind the buffer
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ibo);
+    this->instance->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ibo);
 }
 
 void OGL_IndexBuffer::unbind()
@@ -115,7 +194,7 @@ void OGL_IndexBuffer::unbind()
     //correct the instance binding
     correctInstanceBinding()
     //unbind the buffer
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    this->instance->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void OGL_IndexBuffer::onDestroy()
@@ -125,6 +204,8 @@ void OGL_IndexBuffer::onDestroy()
     {
         //make sure to correct the instance binding
         correctInstanceBinding()
+        //remove the buffer from the state cache
+        this->instance->forgetBuffer(this->ibo);
         //delete the buffer
         glDeleteBuffers(1, &this->ibo);
     }
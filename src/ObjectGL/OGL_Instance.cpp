@@ -16,6 +16,8 @@
 //stdlib includes
 #include <stdexcept>
 #include <iostream>
+#include <cstring>
+#include <algorithm>
 
 /**
  * @brief set the profile to use as well as the version
@@ -57,8 +59,10 @@ static void specifyOGLVersion(float version, OGL_ProfileType profile)
 }
 
 //define the constructor
-OGL_Instance::OGL_Instance(float version, OGL_ProfileType profile)
+OGL_Instance::OGL_Instance(float version, OGL_ProfileType profile, bool allowDSA)
 {
+    //store if direct state access may be used
+    this->allowDSA = allowDSA;
     //check if the background library is intalised
     if (oglAllInstances.size() == 0)
     {
@@ -86,11 +90,18 @@ OGL_Instance::OGL_Instance(float version, OGL_ProfileType profile)
 //define the destructor
 OGL_Instance::~OGL_Instance()
 {
-    //loop over all bound bindables
-    for (size_t i = 0; i < this->bindables.size(); ++i)
+    //release all bound bindables. The bindables are owned by the user, so they are not deleted. Releasing removes them from the list
+    while (!this->bindables.empty())
+    {
+        //release the last bindable
+        this->bindables.back()->release();
+    }
+    //check if a worker pool exists
+    if (this->workerPool)
     {
-        //delete the bindable
-        delete this->bindables[i];
+        //stop the workers, they finish all queued tasks first
+        delete this->workerPool;
+        this->workerPool = 0;
     }
 
     //loop over all bound windows
@@ -177,6 +188,19 @@ void OGL_Instance::registerWindow(OGL_Window* window)
             //throw an error
             std::__throw_runtime_error("Failed to initalise GLEW");
         }
+        //use direct state access if it is allowed and the context supports it
+        this->dsa = this->allowDSA && (GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access);
+        //check if buffers with immutable storage can be created
+        this->bufferStorageSupport = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+        //check if multiple samplers can be bound with one call
+        this->multiBindSupport = GLEW_VERSION_4_4 || GLEW_ARB_multi_bind;
+        //check if many indirect draws can be issued with one call and if their amount can be read from a buffer
+        this->multiDrawIndirectSupport = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+        this->drawCountSupport = GLEW_VERSION_4_6 || GLEW_ARB_indirect_parameters;
+        //read the alignment for uniform buffer ranges
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &this->uniformBufferAlignment);
+        //read the alignment for shader storage buffer ranges
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &this->storageBufferAlignment);
         //set the correct swap interval state
         SDL_GL_SetSwapInterval(0);
         //make this the current instance
@@ -237,6 +261,150 @@ void OGL_Instance::removeBindable(OGL_BindableBase* bindable)
 
     //else, erase the window from the stack
     this->bindables.erase(this->bindables.begin() + idx);
+
+    //remove the bindable from the pending bindables
+    for (size_t i = 0; i < this->pending.size(); ++i)
+    {
+        //check if this is the bindable
+        if (this->pending[i] == bindable) {this->pending.erase(this->pending.begin() + i); break;}
+    }
+    //remove the memory of the bindable from the texture memory budget
+    auto it = this->textureResidency.find(bindable);
+    if (it != this->textureResidency.end())
+    {
+        this->textureMemory -= it->second.size;
+        this->textureResidency.erase(it);
+    }
+}
+
+void OGL_Instance::replaceBindable(OGL_BindableBase* bindable, OGL_BindableBase* replacement)
+{
+    //loop over all bindables
+    for (size_t i = 0; i < this->bindables.size(); ++i)
+    {
+        //check if this is the requested bindable
+        if (this->bindables[i] == bindable)
+        {
+            //replace it
+            this->bindables[i] = replacement;
+            //replace it in the pending bindables
+            for (OGL_BindableBase*& p : this->pending) {if (p == bindable) {p = replacement;}}
+            //move the entry in the texture memory budget
+            auto it = this->textureResidency.find(bindable);
+            if (it != this->textureResidency.end())
+            {
+                this->textureResidency[replacement] = it->second;
+                this->textureResidency.erase(bindable);
+            }
+            return;
+        }
+    }
+    //if the bindable was not registered, register the replacement
+    this->bindables.push_back(replacement);
+}
+
+void OGL_Instance::addPending(OGL_BindableBase* bindable)
+{
+    //check if the bindable is allready pending
+    for (OGL_BindableBase* p : this->pending) {if (p == bindable) {return;}}
+    //store the bindable
+    this->pending.push_back(bindable);
+}
+
+void OGL_Instance::updatePending()
+{
+    //loop over all pending bindables
+    for (size_t i = 0; i < this->pending.size();)
+    {
+        //remove the bindable if nothing is pending anymore
+        if (this->pending[i]->update()) {this->pending.erase(this->pending.begin() + i);}
+        //else, go to the next bindable
+        else {++i;}
+    }
+}
+
+void OGL_Instance::trackTexture(OGL_BindableBase* texture, size_t size)
+{
+    //get the entry of the texture, a new texture is used in this frame
+    auto it = this->textureResidency.find(texture);
+    if (it == this->textureResidency.end()) {it = this->textureResidency.insert({texture, OGL_TextureResidency{0, this->frame}}).first;}
+    //replace the old size with the new one
+    this->textureMemory += size;
+    this->textureMemory -= it->second.size;
+    it->second.size = size;
+    //make room for the texture if the budget is exceeded
+    this->enforceTextureBudget(texture);
+}
+
+void OGL_Instance::useTexture(OGL_BindableBase* texture, bool reloaded)
+{
+    //count the bind
+    if (reloaded) {++this->textureBudgetStats.misses;}
+    else {++this->textureBudgetStats.hits;}
+    //store that the texture is used in this frame
+    auto it = this->textureResidency.find(texture);
+    if (it != this->textureResidency.end()) {it->second.lastUse = this->frame;}
+}
+
+void OGL_Instance::setTextureBudget(size_t budget)
+{
+    //store the budget
+    this->textureBudget = budget;
+    //evict textures if the new budget is smaller
+    this->enforceTextureBudget(0);
+}
+
+void OGL_Instance::enforceTextureBudget(OGL_BindableBase* keep)
+{
+    //check if the budget is exceeded and no eviction is running
+    if (!this->textureBudget || this->textureMemory <= this->textureBudget || this->evictingTextures) {return;}
+    //evictions re-allocate textures, they must not start an other eviction
+    this->evictingTextures = true;
+    //store all textures that where not used in this frame
+    std::vector<std::pair<uint64_t, OGL_BindableBase*>> candidates;
+    for (const auto& entry : this->textureResidency)
+    {
+        if (entry.first == keep || entry.second.lastUse >= this->frame || !entry.second.size) {continue;}
+        candidates.push_back({entry.second.lastUse, entry.first});
+    }
+    //sort them so the least recently used texture comes first
+    std::sort(candidates.begin(), candidates.end());
+    //evict until the budget fits or nothing can be freed anymore
+    bool freed = true;
+    while (freed && this->textureMemory > this->textureBudget)
+    {
+        freed = false;
+        for (const auto& candidate : candidates)
+        {
+            //stop if the budget fits
+            if (this->textureMemory <= this->textureBudget) {break;}
+            //first try to drop the biggest mip level, the texture stays usable with a lower resolution
+            size_t size = candidate.second->evict(true);
+            if (size) {++this->textureBudgetStats.droppedMips;}
+            //else, free the whole texture
+            else if ((size = candidate.second->evict(false)) != 0) {++this->textureBudgetStats.evictions;}
+            //count the freed memory
+            this->textureBudgetStats.evictedBytes += size;
+            freed |= (size != 0);
+        }
+    }
+    //the eviction is done
+    this->evictingTextures = false;
+}
+
+OGL_WorkerPool* OGL_Instance::getWorkerPool()
+{
+    //check if the pool exists
+    if (!this->workerPool)
+    {
+        //use one thread less than the CPU has cores, the rendering thread keeps one
+        uint32_t threads = std::thread::hardware_concurrency();
+        threads = (threads > 1) ? threads - 1 : 1;
+        //create the pool
+        this->workerPool = new OGL_WorkerPool(threads);
+    }
+    //return the pool
+    return this->workerPool;
 }
 
 //implement the function to handle events
@@ -267,4 +435,614 @@ void OGL_Instance::setVSync(bool useVsync)
     SDL_GL_SetSwapInterval(useVsync);
     //store if vsync is eanbled
     this->vsync = useVsync;
-}
\ No newline at end of file
+}
+/**
+ * @brief get the slot of a generic buffer target in the state cache
+ * 
+ * @param target the buffer target
+ * @return int the slot in the state cache or -1 if the target is not tracked
+ */
+static int getBufferTargetSlot(GLenum target)
+{
+    //switch over all tracked targets
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:               return 0;
+    case GL_UNIFORM_BUFFER:             return 1;
+    case GL_SHADER_STORAGE_BUFFER:      return 2;
+    case GL_COPY_READ_BUFFER:           return 3;
+    case GL_COPY_WRITE_BUFFER:          return 4;
+    case GL_PIXEL_PACK_BUFFER:          return 5;
+    case GL_PIXEL_UNPACK_BUFFER:        return 6;
+    case GL_DRAW_INDIRECT_BUFFER:       return 7;
+    case GL_DISPATCH_INDIRECT_BUFFER:   return 8;
+    case GL_TEXTURE_BUFFER:             return 9;
+    case GL_ATOMIC_COUNTER_BUFFER:      return 10;
+    case GL_PARAMETER_BUFFER:           return 11;
+    //the target is not tracked
+    default:                            return -1;
+    }
+}
+
+/**
+ * @brief get the slot of a texture target in the state cache
+ * 
+ * @param target the texture target
+ * @return int the slot in the state cache or -1 if the target is not tracked
+ */
+static int getTextureTargetSlot(GLenum target)
+{
+    //switch over all tracked targets
+    switch (target)
+    {
+    case GL_TEXTURE_2D:                     return 0;
+    case GL_TEXTURE_2D_ARRAY:               return 1;
+    case GL_TEXTURE_CUBE_MAP:               return 2;
+    case GL_TEXTURE_2D_MULTISAMPLE:         return 3;
+    case GL_TEXTURE_3D:                     return 4;
+    case GL_TEXTURE_CUBE_MAP_ARRAY:         return 5;
+    case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:   return 6;
+    //the target is not tracked
+    default:                                return -1;
+    }
+}
+
+/**
+ * @brief get the indexed bindings of the state cache for an indexed buffer target
+ * 
+ * @param state the state cache to get the bindings from
+ * @param target the indexed buffer target
+ * @return std::vector<OGL_IndexedBufferBinding>* a pointer to the bindings or 0 if the target is not tracked
+ */
+static std::vector<OGL_IndexedBufferBinding>* getIndexedBindings(OGL_StateCache* state, GLenum target)
+{
+    //check for uniform buffers
+    if (target == GL_UNIFORM_BUFFER) {return &state->uniformBuffers;}
+    //check for shader storage buffers
+    if (target == GL_SHADER_STORAGE_BUFFER) {return &state->storageBuffers;}
+    //else, the target is not tracked
+    return 0;
+}
+
+void OGL_Instance::bindBuffer(GLenum target, GLuint buffer)
+{
+    //check for the element array buffer, it is part of the vertex array state
+    if (target == GL_ELEMENT_ARRAY_BUFFER)
+    {
+        //only track the binding if the bound vertex array is known
+        if (this->state.vertexArray != OGL_STATE_UNKNOWN)
+        {
+            //search the binding of the current vertex array
+            auto it = this->state.elementBuffers.find(this->state.vertexArray);
+            //if the buffer is allready bound, skip the call
+            if (it != this->state.elementBuffers.end() && it->second == buffer) {++this->state.elidedCalls; return;}
+            //store the new binding
+            this->state.elementBuffers[this->state.vertexArray] = buffer;
+        }
+        //bind the buffer
+        glBindBuffer(target, buffer);
+        ++this->state.issuedCalls;
+        return;
+    }
+
+    //get the slot of the target
+    int slot = getBufferTargetSlot(target);
+    //if the target is tracked and the buffer is allready bound, skip the call
+    if (slot >= 0 && this->state.buffers[slot] == buffer) {++this->state.elidedCalls; return;}
+    //store the new binding
+    if (slot >= 0) {this->state.buffers[slot] = buffer;}
+    //bind the buffer
+    glBindBuffer(target, buffer);
+    ++this->state.issuedCalls;
+}
+
+void OGL_Instance::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    //get the indexed bindings for the target
+    std::vector<OGL_IndexedBufferBinding>* bindings = getIndexedBindings(&this->state, target);
+    //check if the target is tracked
+    if (bindings)
+    {
+        //make sure the binding point exists in the cache
+        if (bindings->size() <= index) {bindings->resize(index+1, OGL_IndexedBufferBinding{this->state.growValue, 0, -1});}
+        //get the binding
+        OGL_IndexedBufferBinding& binding = (*bindings)[index];
+        //if the whole buffer is allready bound, skip the call
+        if (binding.buffer == buffer && binding.size == -1) {++this->state.elidedCalls; return;}
+        //store the new binding
+        binding = OGL_IndexedBufferBinding{buffer, 0, -1};
+    }
+    //bind the buffer
+    glBindBufferBase(target, index, buffer);
+    ++this->state.issuedCalls;
+    //binding to an indexed point also binds to the generic target
+    int slot = getBufferTargetSlot(target);
+    if (slot >= 0) {this->state.buffers[slot] = buffer;}
+}
+
+void OGL_Instance::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    //get the indexed bindings for the target
+    std::vector<OGL_IndexedBufferBinding>* bindings = getIndexedBindings(&this->state, target);
+    //check if the target is tracked
+    if (bindings)
+    {
+        //make sure the binding point exists in the cache
+        if (bindings->size() <= index) {bindings->resize(index+1, OGL_IndexedBufferBinding{this->state.growValue, 0, -1});}
+        //get the binding
+        OGL_IndexedBufferBinding& binding = (*bindings)[index];
+        //if the range is allready bound, skip the call
+        if (binding.buffer == buffer && binding.offset == offset && binding.size == size) {++this->state.elidedCalls; return;}
+        //store the new binding
+        binding = OGL_IndexedBufferBinding{buffer, offset, size};
+    }
+    //bind the range
+    glBindBufferRange(target, index, buffer, offset, size);
+    ++this->state.issuedCalls;
+    //binding to an indexed point also binds to the generic target
+    int slot = getBufferTargetSlot(target);
+    if (slot >= 0) {this->state.buffers[slot] = buffer;}
+}
+
+void OGL_Instance::useProgram(GLuint program)
+{
+    //if the program is allready in use, skip the call
+    if (this->state.program == program) {++this->state.elidedCalls; return;}
+    //store and use the program
+    this->state.program = program;
+    glUseProgram(program);
+    ++this->state.issuedCalls;
+}
+
+void OGL_Instance::bindVertexArray(GLuint vao)
+{
+    //if the vertex array is allready bound, skip the call
+    if (this->state.vertexArray == vao) {++this->state.elidedCalls; return;}
+    //store and bind the vertex array
+    this->state.vertexArray = vao;
+    glBindVertexArray(vao);
+    ++this->state.issuedCalls;
+}
+
+void OGL_Instance::activeTexture(uint8_t unit)
+{
+    //if the unit is allready active, skip the call
+    if (this->state.activeUnit == unit) {++this->state.elidedCalls; return;}
+    //store and activate the unit
+    this->state.activeUnit = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+    ++this->state.issuedCalls;
+}
+
+void OGL_Instance::bindTexture(uint8_t unit, GLenum target, GLuint texture)
+{
+    //always activate the unit, the non-DSA edit paths change the texture on the active unit after binding it
+    this->activeTexture(unit);
+    //get the slot of the target
+    int slot = getTextureTargetSlot(target);
+    //check if the target is tracked
+    if (slot >= 0)
+    {
+        //store the index of the binding
+        size_t idx = (size_t)unit * OGL_STATE_TEXTURE_TARGET_COUNT + slot;
+        //make sure the unit exists in the cache
+        if (this->state.textures.size() <= idx) {this->state.textures.resize(((size_t)unit+1) * OGL_STATE_TEXTURE_TARGET_COUNT, this->state.growValue);}
+        //if the texture is allready bound, skip the binding
+        if (this->state.textures[idx] == texture) {++this->state.elidedCalls; return;}
+        //store the new binding
+        this->state.textures[idx] = texture;
+    }
+    //bind the texture
+    glBindTexture(target, texture);
+    ++this->state.issuedCalls;
+}
+
+void OGL_Instance::bindSampler(uint8_t unit, GLuint sampler)
+{
+    //make sure the unit exists in the cache
+    if (this->state.samplers.size() <= unit) {this->state.samplers.resize((size_t)unit+1, this->state.growValue);}
+    //if the sampler is allready bound, skip the call
+    if (this->state.samplers[unit] == sampler) {++this->state.elidedCalls; return;}
+    //store the new binding
+    this->state.samplers[unit] = sampler;
+    //bind the sampler, the active unit is not needed for that
+    glBindSampler(unit, sampler);
+    ++this->state.issuedCalls;
+}
+
+void OGL_Instance::bindSamplers(uint8_t first, GLsizei count, const GLuint* samplers)
+{
+    //without multi bind, bind unit by unit
+    if (!this->multiBindSupport)
+    {
+        for (GLsizei i = 0; i < count; ++i) {this->bindSampler(first + i, samplers[i]);}
+        return;
+    }
+    //make sure all units exist in the cache
+    if (this->state.samplers.size() < (size_t)first + count) {this->state.samplers.resize((size_t)first + count, this->state.growValue);}
+    //find the first and the last unit that change
+    GLsizei begin = count;
+    GLsizei end = 0;
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        //skip units that allready have their sampler
+        if (this->state.samplers[first + i] == samplers[i]) {continue;}
+        //store the new binding
+        this->state.samplers[first + i] = samplers[i];
+        //extend the range of changed units
+        if (i < begin) {begin = i;}
+        end = i + 1;
+    }
+    //if nothing changes, skip the call
+    if (begin >= end) {this->state.elidedCalls += count; return;}
+    //bind the changed range with a single call
+    glBindSamplers(first + begin, end - begin, samplers + begin);
+    ++this->state.issuedCalls;
+    //the units outside of the range where skipped
+    this->state.elidedCalls += count - (end - begin);
+}
+
+GLuint OGL_Instance::acquireSampler(const OGL_SamplerDesc& desc)
+{
+    //search for a sampler with the same description. The description has no padding, so the bytes can be compared
+    for (OGL_CachedSampler& cached : this->samplers)
+    {
+        if (memcmp(&cached.desc, &desc, sizeof(OGL_SamplerDesc)) != 0) {continue;}
+        //share the existing sampler
+        ++cached.references;
+        return cached.sampler;
+    }
+    //store the new sampler
+    OGL_CachedSampler cached;
+    cached.desc = desc;
+    cached.references = 1;
+    //with direct state access, create the sampler object, else only reserve the name
+    if (this->dsa) {glCreateSamplers(1, &cached.sampler);}
+    else {glGenSamplers(1, &cached.sampler);}
+    //set the parameters, samplers are never bound to edit them
+    glSamplerParameteri(cached.sampler, GL_TEXTURE_MIN_FILTER, desc.minFilter);
+    glSamplerParameteri(cached.sampler, GL_TEXTURE_MAG_FILTER, desc.magFilter);
+    glSamplerParameteri(cached.sampler, GL_TEXTURE_WRAP_S, desc.wrapS);
+    glSamplerParameteri(cached.sampler, GL_TEXTURE_WRAP_T, desc.wrapT);
+    glSamplerParameteri(cached.sampler, GL_TEXTURE_WRAP_R, desc.wrapR);
+    glSamplerParameteri(cached.sampler, GL_TEXTURE_COMPARE_MODE, desc.compareMode);
+    glSamplerParameteri(cached.sampler, GL_TEXTURE_COMPARE_FUNC, desc.compareFunc);
+    glSamplerParameterf(cached.sampler, GL_TEXTURE_MIN_LOD, desc.minLod);
+    glSamplerParameterf(cached.sampler, GL_TEXTURE_MAX_LOD, desc.maxLod);
+    glSamplerParameterf(cached.sampler, GL_TEXTURE_LOD_BIAS, desc.lodBias);
+    glSamplerParameterfv(cached.sampler, GL_TEXTURE_BORDER_COLOR, desc.borderColor);
+    //anisotropic filtering is only set if it is used, so contexts without it don't raise an error
+    if (desc.maxAnisotropy > 1.f) {glSamplerParameterf(cached.sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT, desc.maxAnisotropy);}
+    //add the sampler to the cache
+    this->samplers.push_back(cached);
+    //return the new sampler
+    return cached.sampler;
+}
+
+void OGL_Instance::releaseSampler(GLuint sampler)
+{
+    //search the sampler in the cache
+    for (size_t i = 0; i < this->samplers.size(); ++i)
+    {
+        if (this->samplers[i].sampler != sampler) {continue;}
+        //keep the sampler while it is still used
+        if (--this->samplers[i].references > 0) {return;}
+        //deleting a bound sampler reverts the bindings of all units to 0
+        for (GLuint& s : this->state.samplers) {if (s == sampler) {s = 0;}}
+        //delete the sampler
+        glDeleteSamplers(1, &sampler);
+        //remove it from the cache
+        this->samplers.erase(this->samplers.begin() + i);
+        return;
+    }
+}
+
+void OGL_Instance::bindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    //check if the binding changes the read framebuffer
+    bool read = (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER);
+    //check if the binding changes the draw framebuffer
+    bool draw = (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER);
+    //if nothing would change, skip the call
+    if ((!read || this->state.readFramebuffer == framebuffer) && (!draw || this->state.drawFramebuffer == framebuffer)) {++this->state.elidedCalls; return;}
+    //store the new bindings
+    if (read) {this->state.readFramebuffer = framebuffer;}
+    if (draw) {this->state.drawFramebuffer = framebuffer;}
+    //bind the framebuffer
+    glBindFramebuffer(target, framebuffer);
+    ++this->state.issuedCalls;
+}
+
+void OGL_Instance::setPixelUnpack(GLint alignment, GLint rowLength)
+{
+    //set the alignment if it changes
+    if (this->state.unpackAlignment != alignment)
+    {
+        this->state.unpackAlignment = alignment;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+        ++this->state.issuedCalls;
+    }
+    else {++this->state.elidedCalls;}
+    //set the row length if it changes
+    if (this->state.unpackRowLength != rowLength)
+    {
+        this->state.unpackRowLength = rowLength;
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+        ++this->state.issuedCalls;
+    }
+    else {++this->state.elidedCalls;}
+}
+
+GLuint OGL_Instance::getBoundBufferBase(GLenum target, GLuint index)
+{
+    //get the indexed bindings for the target
+    std::vector<OGL_IndexedBufferBinding>* bindings = getIndexedBindings(&this->state, target);
+    //if the binding point is not tracked, it is not known
+    if (!bindings || bindings->size() <= index) {return OGL_STATE_UNKNOWN;}
+    //return the cached binding
+    return (*bindings)[index].buffer;
+}
+
+GLuint OGL_Instance::getBoundBuffer(GLenum target)
+{
+    //the element array buffer is part of the vertex array state, it is known if the binding of the current vertex array is cached
+    if (target == GL_ELEMENT_ARRAY_BUFFER && this->state.vertexArray != OGL_STATE_UNKNOWN)
+    {
+        auto it = this->state.elementBuffers.find(this->state.vertexArray);
+        if (it != this->state.elementBuffers.end()) {return it->second;}
+    }
+    //get the slot of the target
+    int slot = getBufferTargetSlot(target);
+    //if the binding is known, return it
+    if (slot >= 0 && this->state.buffers[slot] != OGL_STATE_UNKNOWN) {return this->state.buffers[slot];}
+    //store the binding query for the target
+    GLenum query = 0;
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:               query = GL_ARRAY_BUFFER_BINDING; break;
+    case GL_ELEMENT_ARRAY_BUFFER:       query = GL_ELEMENT_ARRAY_BUFFER_BINDING; break;
+    case GL_UNIFORM_BUFFER:             query = GL_UNIFORM_BUFFER_BINDING; break;
+    case GL_SHADER_STORAGE_BUFFER:      query = GL_SHADER_STORAGE_BUFFER_BINDING; break;
+    case GL_COPY_READ_BUFFER:           query = GL_COPY_READ_BUFFER_BINDING; break;
+    case GL_COPY_WRITE_BUFFER:          query = GL_COPY_WRITE_BUFFER_BINDING; break;
+    case GL_PIXEL_PACK_BUFFER:          query = GL_PIXEL_PACK_BUFFER_BINDING; break;
+    case GL_PIXEL_UNPACK_BUFFER:        query = GL_PIXEL_UNPACK_BUFFER_BINDING; break;
+    case GL_DRAW_INDIRECT_BUFFER:       query = GL_DRAW_INDIRECT_BUFFER_BINDING; break;
+    case GL_DISPATCH_INDIRECT_BUFFER:   query = GL_DISPATCH_INDIRECT_BUFFER_BINDING; break;
+    case GL_TEXTURE_BUFFER:             query = GL_TEXTURE_BUFFER_BINDING; break;
+    case GL_ATOMIC_COUNTER_BUFFER:      query = GL_ATOMIC_COUNTER_BUFFER_BINDING; break;
+    case GL_PARAMETER_BUFFER:           query = GL_PARAMETER_BUFFER_BINDING; break;
+    //the targets that are not cached can still be queried
+    case GL_TRANSFORM_FEEDBACK_BUFFER:  query = GL_TRANSFORM_FEEDBACK_BUFFER_BINDING; break;
+    case GL_QUERY_BUFFER:               query = GL_QUERY_BUFFER_BINDING; break;
+    default:
+        //throw an error
+        std::__throw_runtime_error("The buffer target can't be queried");
+        return 0;
+    }
+    //query the binding from OpenGL
+    GLint bound = 0;
+    glGetIntegerv(query, &bound);
+    //store the queried binding
+    if (slot >= 0) {this->state.buffers[slot] = bound;}
+    else if (target == GL_ELEMENT_ARRAY_BUFFER && this->state.vertexArray != OGL_STATE_UNKNOWN) {this->state.elementBuffers[this->state.vertexArray] = bound;}
+    //return the binding
+    return bound;
+}
+
+void OGL_Instance::forgetBuffer(GLuint buffer)
+{
+    //deleting a bound buffer reverts the generic bindings to 0
+    for (GLuint& b : this->state.buffers) {if (b == buffer) {b = 0;}}
+    //the element array binding of the current vertex array reverts to 0, the others keep the buffer alive
+    auto it = this->state.elementBuffers.find(this->state.vertexArray);
+    if (it != this->state.elementBuffers.end() && it->second == buffer) {it->second = 0;}
+    //the indexed bindings revert to 0
+    for (OGL_IndexedBufferBinding& b : this->state.uniformBuffers) {if (b.buffer == buffer) {b = OGL_IndexedBufferBinding{0, 0, -1};}}
+    for (OGL_IndexedBufferBinding& b : this->state.storageBuffers) {if (b.buffer == buffer) {b = OGL_IndexedBufferBinding{0, 0, -1};}}
+}
+
+void OGL_Instance::forgetTexture(GLuint texture)
+{
+    //deleting a bound texture reverts the bindings of all units to 0
+    for (GLuint& t : this->state.textures) {if (t == texture) {t = 0;}}
+}
+
+void OGL_Instance::forgetProgram(GLuint program)
+{
+    //a program in use is only flagged for deletion, so the binding is not known any more
+    if (this->state.program == program) {this->state.program = OGL_STATE_UNKNOWN;}
+}
+
+void OGL_Instance::forgetVertexArray(GLuint vao)
+{
+    //deleting the bound vertex array reverts the binding to 0
+    if (this->state.vertexArray == vao) {this->state.vertexArray = 0;}
+    //remove the element array binding of the vertex array
+    this->state.elementBuffers.erase(vao);
+}
+
+void OGL_Instance::forgetFramebuffer(GLuint framebuffer)
+{
+    //deleting a bound framebuffer reverts the bindings to the default framebuffer
+    if (this->state.readFramebuffer == framebuffer) {this->state.readFramebuffer = 0;}
+    if (this->state.drawFramebuffer == framebuffer) {this->state.drawFramebuffer = 0;}
+}
+
+void OGL_Instance::invalidateStateCache()
+{
+    //mark all generic buffer bindings as unknown
+    for (GLuint& b : this->state.buffers) {b = OGL_STATE_UNKNOWN;}
+    //forget all element array bindings
+    this->state.elementBuffers.clear();
+    //mark all indexed bindings as unknown
+    for (OGL_IndexedBufferBinding& b : this->state.uniformBuffers) {b.buffer = OGL_STATE_UNKNOWN;}
+    for (OGL_IndexedBufferBinding& b : this->state.storageBuffers) {b.buffer = OGL_STATE_UNKNOWN;}
+    //mark all texture bindings as unknown
+    for (GLuint& t : this->state.textures) {t = OGL_STATE_UNKNOWN;}
+    //mark all sampler bindings as unknown
+    for (GLuint& s : this->state.samplers) {s = OGL_STATE_UNKNOWN;}
+    //new entries are unknown too
+    this->state.growValue = OGL_STATE_UNKNOWN;
+    //mark the single bindings as unknown
+    this->state.program = OGL_STATE_UNKNOWN;
+    this->state.vertexArray = OGL_STATE_UNKNOWN;
+    this->state.activeUnit = OGL_STATE_UNKNOWN;
+    this->state.readFramebuffer = OGL_STATE_UNKNOWN;
+    this->state.drawFramebuffer = OGL_STATE_UNKNOWN;
+    this->state.unpackAlignment = (GLint)OGL_STATE_UNKNOWN;
+    this->state.unpackRowLength = (GLint)OGL_STATE_UNKNOWN;
+}
+
+GLuint OGL_Instance::createBuffer()
+{
+    //store the new buffer
+    GLuint buffer = 0;
+    //with direct state access, create the buffer object
+    if (this->dsa) {glCreateBuffers(1, &buffer);}
+    //else, only reserve the name. The object is created on the first bind
+    else {glGenBuffers(1, &buffer);}
+    //return the buffer
+    return buffer;
+}
+
+void OGL_Instance::bufferData(GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLenum usage)
+{
+    //check if direct state access is used
+    if (this->dsa)
+    {
+        //fill the buffer without binding it
+        glNamedBufferData(buffer, size, data, usage);
+        return;
+    }
+    //bind the buffer to edit it
+    this->bindBuffer(target, buffer);
+    //fill the buffer
+    glBufferData(target, size, data, usage);
+}
+
+void OGL_Instance::bufferSubData(GLenum target, GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    //check if direct state access is used
+    if (this->dsa)
+    {
+        //update the buffer without binding it
+        glNamedBufferSubData(buffer, offset, size, data);
+        return;
+    }
+    //bind the buffer to edit it
+    this->bindBuffer(target, buffer);
+    //update the buffer
+    glBufferSubData(target, offset, size, data);
+}
+
+void OGL_Instance::getBufferSubData(GLenum target, GLuint buffer, GLintptr offset, GLsizeiptr size, void* data)
+{
+    //check if direct state access is used
+    if (this->dsa)
+    {
+        //read the buffer without binding it
+        glGetNamedBufferSubData(buffer, offset, size, data);
+        return;
+    }
+    //bind the buffer to read it
+    this->bindBuffer(target, buffer);
+    //read the buffer
+    glGetBufferSubData(target, offset, size, data);
+}
+
+void OGL_Instance::copyBufferSubData(GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+    //check if direct state access is used
+    if (this->dsa)
+    {
+        //copy without binding the buffers
+        glCopyNamedBufferSubData(readBuffer, writeBuffer, readOffset, writeOffset, size);
+        return;
+    }
+    //bind the buffers to the copy targets
+    this->bindBuffer(GL_COPY_READ_BUFFER, readBuffer);
+    this->bindBuffer(GL_COPY_WRITE_BUFFER, writeBuffer);
+    //copy the range
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, size);
+}
+
+void OGL_Instance::bufferStorage(GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags)
+{
+    //check if direct state access is used
+    if (this->dsa)
+    {
+        //allocate the storage without binding the buffer
+        glNamedBufferStorage(buffer, size, data, flags);
+        return;
+    }
+    //bind the buffer to edit it
+    this->bindBuffer(target, buffer);
+    //allocate the storage
+    glBufferStorage(target, size, data, flags);
+}
+
+void* OGL_Instance::mapBufferRange(GLenum target, GLuint buffer, GLintptr offset, GLsizeiptr size, GLbitfield access)
+{
+    //check if direct state access is used
+    if (this->dsa)
+    {
+        //map the buffer without binding it
+        return glMapNamedBufferRange(buffer, offset, size, access);
+    }
+    //bind the buffer to map it
+    this->bindBuffer(target, buffer);
+    //map the buffer
+    return glMapBufferRange(target, offset, size, access);
+}
+
+void OGL_Instance::unmapBuffer(GLenum target, GLuint buffer)
+{
+    //check if direct state access is used
+    if (this->dsa)
+    {
+        //unmap the buffer without binding it
+        glUnmapNamedBuffer(buffer);
+        return;
+    }
+    //bind the buffer to unmap it
+    this->bindBuffer(target, buffer);
+    //unmap the buffer
+    glUnmapBuffer(target);
+}
+
+GLuint OGL_Instance::createTexture(GLenum target)
+{
+    //store the new texture
+    GLuint texture = 0;
+    //with direct state access, create the texture object for the target
+    if (this->dsa) {glCreateTextures(target, 1, &texture);}
+    //else, only reserve the name. The object is created on the first bind
+    else {glGenTextures(1, &texture);}
+    //return the texture
+    return texture;
+}
+
+GLuint OGL_Instance::createFramebuffer()
+{
+    //store the new framebuffer
+    GLuint framebuffer = 0;
+    //with direct state access, create the framebuffer object
+    if (this->dsa) {glCreateFramebuffers(1, &framebuffer);}
+    //else, only reserve the name. The object is created on the first bind
+    else {glGenFramebuffers(1, &framebuffer);}
+    //return the framebuffer
+    return framebuffer;
+}
+
+GLuint OGL_Instance::createRenderbuffer()
+{
+    //store the new renderbuffer
+    GLuint renderbuffer = 0;
+    //with direct state access, create the renderbuffer object
+    if (this->dsa) {glCreateRenderbuffers(1, &renderbuffer);}
+    //else, only reserve the name. The object is created on the first bind
+    else {glGenRenderbuffers(1, &renderbuffer);}
+    //return the renderbuffer
+    return renderbuffer;
+}
@@ -0,0 +1,481 @@
+/**
+ * @file OGL_PixelConvert.cpp
+ * @author DM8AT
+ * @brief implement the conversion kernels for pixel data
+ * @version 0.1
+ * @date 2024-08-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+//include memcpy
+#include <cstring>
+
+//the vector kernels need the x86 intrinsics and the CPU detection of GCC or Clang
+#if !defined(OGL_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OGL_PIXEL_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief the instruction sets the kernels can use on this CPU
+ */
+enum OGL_PixelSIMDLevel {
+    /**
+     * @brief only the scalar kernels are used
+     */
+    OGL_PIXEL_SIMD_NONE = 0,
+    /**
+     * @brief SSE2 is available
+     */
+    OGL_PIXEL_SIMD_SSE2,
+    /**
+     * @brief SSSE3 is available, it adds byte shuffles
+     */
+    OGL_PIXEL_SIMD_SSSE3,
+    /**
+     * @brief AVX2 is available
+     */
+    OGL_PIXEL_SIMD_AVX2
+};
+
+/**
+ * @brief store if the vector kernels may be used, it is turned off to compare them with the scalar kernels
+ */
+static std::atomic<bool> oglPixelSIMDEnabled{true};
+
+void oglSetPixelSIMD(bool enabled)
+{
+    //store the new state
+    oglPixelSIMDEnabled.store(enabled);
+}
+
+bool oglIsPixelSIMDEnabled()
+{
+    //return the stored state
+    return oglPixelSIMDEnabled.load();
+}
+
+/**
+ * @brief get the best instruction set of the CPU. It is only detected on the first call
+ * 
+ * @return OGL_PixelSIMDLevel the best instruction set that can be used
+ */
+static OGL_PixelSIMDLevel getSIMDLevel()
+{
+#ifdef OGL_PIXEL_X86
+    //the vector kernels may be turned off
+    if (!oglPixelSIMDEnabled.load()) {return OGL_PIXEL_SIMD_NONE;}
+    //detect the instruction set once
+    static OGL_PixelSIMDLevel level = []() {
+        //initalise the detection
+        __builtin_cpu_init();
+        //check from the best to the worst instruction set
+        if (__builtin_cpu_supports("avx2")) {return OGL_PIXEL_SIMD_AVX2;}
+        if (__builtin_cpu_supports("ssse3")) {return OGL_PIXEL_SIMD_SSSE3;}
+        if (__builtin_cpu_supports("sse2")) {return OGL_PIXEL_SIMD_SSE2;}
+        return OGL_PIXEL_SIMD_NONE;
+    }();
+    //return the cached level
+    return level;
+#else
+    //no vector kernels are compiled
+    return OGL_PIXEL_SIMD_NONE;
+#endif
+}
+
+/**
+ * @brief check if the CPU can convert floats to half floats in hardware
+ * 
+ * @return true : F16C is available |
+ * @return false : the conversion uses a table
+ */
+static bool hasF16C()
+{
+#ifdef OGL_PIXEL_X86
+    //the vector kernels may be turned off
+    if (!oglPixelSIMDEnabled.load()) {return false;}
+    //detect the support once
+    static bool f16c = []() {
+        //initalise the detection
+        __builtin_cpu_init();
+        //the kernel uses AVX2 to widen the bytes
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+    }();
+    //return the cached support
+    return f16c;
+#else
+    //no vector kernels are compiled
+    return false;
+#endif
+}
+
+/**
+ * @brief convert a float to a half float, rounding to the nearest even value. Only used for values between 0 and 1
+ * 
+ * @param value the value to convert
+ * @return uint16_t the bits of the half float
+ */
+static uint16_t floatToHalf(float value)
+{
+    //get the bits of the float
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    //get the sign
+    uint16_t sign = (bits >> 16) & 0x8000;
+    //get the exponent for a half float
+    int32_t exponent = (int32_t)((bits >> 23) & 0xFF) - 127 + 15;
+    //get the mantissa
+    uint32_t mantissa = bits & 0x7FFFFF;
+    //too small values become 0
+    if (exponent <= 0) {return sign;}
+    //too big values become infinity
+    if (exponent >= 31) {return sign | 0x7C00;}
+    //combine the half, round the mantissa to the nearest even value. A carry into the exponent is correct
+    uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {++half;}
+    //return the half
+    return sign | (uint16_t)half;
+}
+
+/**
+ * @brief get the table that converts a normalized byte to a half float
+ * 
+ * @return const uint16_t* a table with 256 half floats
+ */
+static const uint16_t* getHalfTable()
+{
+    //fill the table once
+    static struct HalfTable {
+        uint16_t values[256];
+        HalfTable() {for (int i = 0; i < 256; ++i) {values[i] = floatToHalf((float)i * (1.f / 255.f));}}
+    } table;
+    //return the values
+    return table.values;
+}
+
+/**
+ * @brief multiply a color channel by an alpha value and divide by 255 with correct rounding
+ * 
+ * @param color the color channel
+ * @param alpha the alpha value
+ * @return uint8_t the premultiplied color channel
+ */
+static inline uint8_t premultiplyChannel(uint32_t color, uint32_t alpha)
+{
+    //round(color * alpha / 255) without a division
+    uint32_t t = color * alpha + 128;
+    return (uint8_t)((t + (t >> 8)) >> 8);
+}
+
+#ifdef OGL_PIXEL_X86
+
+/**
+ * @brief expand RGB pixels to RGBA using SSSE3
+ * 
+ * @param src the RGB pixels
+ * @param dst the RGBA pixels
+ * @param count the amount of pixels
+ * @return size_t the amount of converted pixels, the rest must be converted by the caller
+ */
+__attribute__((target("ssse3")))
+static size_t rgbToRGBA_SSSE3(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    //move each 3 byte pixel to 4 bytes, the alpha byte is set to 0
+    const __m128i shuffle = _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+    //the alpha value to add
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+    //convert 4 pixels at once, the load reads 16 bytes, so 6 pixels must be left
+    size_t i = 0;
+    for (; i + 6 <= count; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(src + i*3));
+        _mm_storeu_si128((__m128i*)(dst + i*4), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha));
+    }
+    //return the amount of converted pixels
+    return i;
+}
+
+/**
+ * @brief expand RGB pixels to RGBA using AVX2
+ * 
+ * @param src the RGB pixels
+ * @param dst the RGBA pixels
+ * @param count the amount of pixels
+ * @return size_t the amount of converted pixels, the rest must be converted by the caller
+ */
+__attribute__((target("avx2")))
+static size_t rgbToRGBA_AVX2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    //move each 3 byte pixel to 4 bytes, the shuffle works on both 128 bit lanes
+    const __m256i shuffle = _mm256_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1,
+                                             0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+    //the alpha value to add
+    const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+    //convert 8 pixels at once, the second load reads 16 bytes after pixel 4, so 10 pixels must be left
+    size_t i = 0;
+    for (; i + 10 <= count; i += 8)
+    {
+        //load pixel 0-3 to the low lane and pixel 4-7 to the high lane
+        __m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src + i*3))),
+                                                 _mm_loadu_si128((const __m128i*)(src + i*3 + 12)), 1);
+        _mm256_storeu_si256((__m256i*)(dst + i*4), _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha));
+    }
+    //return the amount of converted pixels
+    return i;
+}
+
+/**
+ * @brief swap the red and blue channel of 4 channel pixels using SSE2
+ * 
+ * @param src the source pixels
+ * @param dst the swizzled pixels
+ * @param count the amount of pixels
+ * @return size_t the amount of converted pixels, the rest must be converted by the caller
+ */
+__attribute__((target("sse2")))
+static size_t swizzle_SSE2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    //the masks for the channels that stay and the channels that swap
+    const __m128i keep = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i swap = _mm_set1_epi32(0x00FF00FF);
+    //convert 4 pixels at once
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(src + i*4));
+        //rotate each pixel by 16 bits to swap byte 0 and 2, then keep the swapped bytes
+        __m128i rotated = _mm_or_si128(_mm_slli_epi32(pixels, 16), _mm_srli_epi32(pixels, 16));
+        _mm_storeu_si128((__m128i*)(dst + i*4), _mm_or_si128(_mm_and_si128(pixels, keep), _mm_and_si128(rotated, swap)));
+    }
+    //return the amount of converted pixels
+    return i;
+}
+
+/**
+ * @brief swap the red and blue channel of 4 channel pixels using AVX2
+ * 
+ * @param src the source pixels
+ * @param dst the swizzled pixels
+ * @param count the amount of pixels
+ * @return size_t the amount of converted pixels, the rest must be converted by the caller
+ */
+__attribute__((target("avx2")))
+static size_t swizzle_AVX2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    //swap byte 0 and 2 of every pixel
+    const __m256i shuffle = _mm256_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15,
+                                             2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+    //convert 8 pixels at once
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i pixels = _mm256_loadu_si256((const __m256i*)(src + i*4));
+        _mm256_storeu_si256((__m256i*)(dst + i*4), _mm256_shuffle_epi8(pixels, shuffle));
+    }
+    //return the amount of converted pixels
+    return i;
+}
+
+/**
+ * @brief premultiply 4 pixels that are widened to 16 bit per channel
+ * 
+ * @param pixels the widened pixels
+ * @param alphaOne a vector with 255 at the alpha channels, so the alpha is multiplied by 1
+ * @param alphaMask a vector with all bits set at the alpha channels
+ * @return __m128i the premultiplied widened pixels
+ */
+__attribute__((target("sse2")))
+static inline __m128i premultiplyWide_SSE2(__m128i pixels, __m128i alphaOne, __m128i alphaMask)
+{
+    //broadcast the alpha of each pixel to its channels
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3));
+    //the alpha channel is multiplied with 255, so it keeps its value
+    alpha = _mm_or_si128(_mm_andnot_si128(alphaMask, alpha), alphaOne);
+    //round(color * alpha / 255)
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/**
+ * @brief premultiply the alpha of RGBA or BGRA pixels using SSE2
+ * 
+ * @param pixels the pixels to premultiply
+ * @param count the amount of pixels
+ * @return size_t the amount of converted pixels, the rest must be converted by the caller
+ */
+__attribute__((target("sse2")))
+static size_t premultiply_SSE2(uint8_t* pixels, size_t count)
+{
+    //the masks for the alpha channel of the widened pixels
+    const __m128i alphaMask = _mm_set_epi16(-1,0,0,0,-1,0,0,0);
+    const __m128i alphaOne = _mm_set_epi16(255,0,0,0,255,0,0,0);
+    const __m128i zero = _mm_setzero_si128();
+    //convert 4 pixels at once
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)(pixels + i*4));
+        //widen to 16 bit per channel, premultiply and narrow again
+        __m128i lo = premultiplyWide_SSE2(_mm_unpacklo_epi8(p, zero), alphaOne, alphaMask);
+        __m128i hi = premultiplyWide_SSE2(_mm_unpackhi_epi8(p, zero), alphaOne, alphaMask);
+        _mm_storeu_si128((__m128i*)(pixels + i*4), _mm_packus_epi16(lo, hi));
+    }
+    //return the amount of converted pixels
+    return i;
+}
+
+/**
+ * @brief premultiply 8 pixels that are widened to 16 bit per channel
+ * 
+ * @param pixels the widened pixels
+ * @param alphaOne a vector with 255 at the alpha channels, so the alpha is multiplied by 1
+ * @param alphaMask a vector with all bits set at the alpha channels
+ * @return __m256i the premultiplied widened pixels
+ */
+__attribute__((target("avx2")))
+static inline __m256i premultiplyWide_AVX2(__m256i pixels, __m256i alphaOne, __m256i alphaMask)
+{
+    //broadcast the alpha of each pixel to its channels
+    __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3));
+    //the alpha channel is multiplied with 255, so it keeps its value
+    alpha = _mm256_or_si256(_mm256_andnot_si256(alphaMask, alpha), alphaOne);
+    //round(color * alpha / 255)
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(pixels, alpha), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+/**
+ * @brief premultiply the alpha of RGBA or BGRA pixels using AVX2
+ * 
+ * @param pixels the pixels to premultiply
+ * @param count the amount of pixels
+ * @return size_t the amount of converted pixels, the rest must be converted by the caller
+ */
+__attribute__((target("avx2")))
+static size_t premultiply_AVX2(uint8_t* pixels, size_t count)
+{
+    //the masks for the alpha channel of the widened pixels
+    const __m256i alphaMask = _mm256_set_epi16(-1,0,0,0,-1,0,0,0,-1,0,0,0,-1,0,0,0);
+    const __m256i alphaOne = _mm256_set_epi16(255,0,0,0,255,0,0,0,255,0,0,0,255,0,0,0);
+    const __m256i zero = _mm256_setzero_si256();
+    //convert 8 pixels at once, the unpacking and packing work per lane, so the order is kept
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i p = _mm256_loadu_si256((const __m256i*)(pixels + i*4));
+        //widen to 16 bit per channel, premultiply and narrow again
+        __m256i lo = premultiplyWide_AVX2(_mm256_unpacklo_epi8(p, zero), alphaOne, alphaMask);
+        __m256i hi = premultiplyWide_AVX2(_mm256_unpackhi_epi8(p, zero), alphaOne, alphaMask);
+        _mm256_storeu_si256((__m256i*)(pixels + i*4), _mm256_packus_epi16(lo, hi));
+    }
+    //return the amount of converted pixels
+    return i;
+}
+
+/**
+ * @brief convert normalized bytes to half floats using AVX2 and F16C
+ * 
+ * @param src the bytes
+ * @param dst the half floats
+ * @param count the amount of values
+ * @return size_t the amount of converted values, the rest must be converted by the caller
+ */
+__attribute__((target("avx2,f16c")))
+static size_t u8ToHalf_F16C(const uint8_t* src, uint16_t* dst, size_t count)
+{
+    //the scale to normalize the bytes
+    const __m256 scale = _mm256_set1_ps(1.f / 255.f);
+    //convert 8 values at once
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        //widen the bytes to floats and normalize them
+        __m256 values = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)))), scale);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+    }
+    //return the amount of converted values
+    return i;
+}
+
+#endif
+
+void oglConvertRGBToRGBA(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    //store the amount of converted pixels
+    size_t i = 0;
+#ifdef OGL_PIXEL_X86
+    //use the best vector kernel
+    OGL_PixelSIMDLevel level = getSIMDLevel();
+    if (level >= OGL_PIXEL_SIMD_AVX2) {i = rgbToRGBA_AVX2(src, dst, count);}
+    else if (level >= OGL_PIXEL_SIMD_SSSE3) {i = rgbToRGBA_SSSE3(src, dst, count);}
+#endif
+    //convert the rest
+    for (; i < count; ++i)
+    {
+        dst[i*4 + 0] = src[i*3 + 0];
+        dst[i*4 + 1] = src[i*3 + 1];
+        dst[i*4 + 2] = src[i*3 + 2];
+        dst[i*4 + 3] = 0xFF;
+    }
+}
+
+void oglSwizzleRedBlue(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    //store the amount of converted pixels
+    size_t i = 0;
+#ifdef OGL_PIXEL_X86
+    //use the best vector kernel
+    OGL_PixelSIMDLevel level = getSIMDLevel();
+    if (level >= OGL_PIXEL_SIMD_AVX2) {i = swizzle_AVX2(src, dst, count);}
+    else if (level >= OGL_PIXEL_SIMD_SSE2) {i = swizzle_SSE2(src, dst, count);}
+#endif
+    //convert the rest, the red channel is stored first so src and dst may be the same
+    for (; i < count; ++i)
+    {
+        uint8_t red = src[i*4 + 0];
+        dst[i*4 + 0] = src[i*4 + 2];
+        dst[i*4 + 1] = src[i*4 + 1];
+        dst[i*4 + 2] = red;
+        dst[i*4 + 3] = src[i*4 + 3];
+    }
+}
+
+void oglPremultiplyAlpha(uint8_t* pixels, size_t count)
+{
+    //store the amount of converted pixels
+    size_t i = 0;
+#ifdef OGL_PIXEL_X86
+    //use the best vector kernel
+    OGL_PixelSIMDLevel level = getSIMDLevel();
+    if (level >= OGL_PIXEL_SIMD_AVX2) {i = premultiply_AVX2(pixels, count);}
+    else if (level >= OGL_PIXEL_SIMD_SSE2) {i = premultiply_SSE2(pixels, count);}
+#endif
+    //convert the rest
+    for (; i < count; ++i)
+    {
+        uint8_t* p = pixels + i*4;
+        p[0] = premultiplyChannel(p[0], p[3]);
+        p[1] = premultiplyChannel(p[1], p[3]);
+        p[2] = premultiplyChannel(p[2], p[3]);
+    }
+}
+
+void oglConvertU8ToHalf(const uint8_t* src, uint16_t* dst, size_t count)
+{
+    //store the amount of converted values
+    size_t i = 0;
+#ifdef OGL_PIXEL_X86
+    //use the hardware conversion if it exists
+    if (hasF16C()) {i = u8ToHalf_F16C(src, dst, count);}
+#endif
+    //convert the rest with the table
+    const uint16_t* table = getHalfTable();
+    for (; i < count; ++i) {dst[i] = table[src[i]];}
+}
@@ -0,0 +1,134 @@
+/**
+ * @file OGL_RenderPass.cpp
+ * @author DM8AT
+ * @brief implement render passes with load and store operations
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+OGL_RenderPass::OGL_RenderPass(OGL_Framebuffer* framebuffer, std::vector<OGL_AttachmentOps> ops)
+{
+    //store the framebuffer
+    this->framebuffer = framebuffer;
+    //store the operations
+    this->ops = ops;
+}
+
+void OGL_RenderPass::setViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    //store the area
+    this->viewport[0] = x;
+    this->viewport[1] = y;
+    this->viewport[2] = width;
+    this->viewport[3] = height;
+}
+
+void OGL_RenderPass::begin()
+{
+    //get the current instance
+    OGL_Instance* instance = oglGetCurrentInstance();
+    //check if an instance exists
+    if (!instance) {std::__throw_runtime_error("Can't begin a render pass without an instance");}
+    //bind the framebuffer for drawing. Framebuffers re-attach changed textures when they are bound
+    if (this->framebuffer) {this->framebuffer->bind(GL_DRAW_FRAMEBUFFER);}
+    else {instance->bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);}
+    //set the area that is rendered to
+    if (this->viewport[2] > 0) {glViewport(this->viewport[0], this->viewport[1], this->viewport[2], this->viewport[3]);}
+
+    //store the attachments whose content is not needed
+    std::vector<GLenum> invalid;
+    for (size_t i = 0; i < this->ops.size(); ++i) {if (this->ops[i].load == OGL_LOAD_OP_DONT_CARE) {this->getInvalidationPoints(i, invalid);}}
+    //invalidate them before anything is rendered
+    this->invalidate(invalid);
+
+    //loop over all attachments to clear
+    for (size_t i = 0; i < this->ops.size(); ++i)
+    {
+        //skip attachments that are not cleared
+        if (this->ops[i].load != OGL_LOAD_OP_CLEAR) {continue;}
+        const OGL_AttachmentOps& op = this->ops[i];
+        //check for the default framebuffer
+        if (!this->framebuffer)
+        {
+            //the first entry is the color buffer, the second the depth and stencil buffer
+            if (i == 0) {glClearBufferfv(GL_COLOR, 0, op.clearColor);}
+            else if (i == 1) {glClearBufferfi(GL_DEPTH_STENCIL, 0, op.clearDepth, op.clearStencil);}
+            continue;
+        }
+        //skip operations without an attachment
+        if (i >= this->framebuffer->getAttachmentCount()) {break;}
+        //clear the attachment with the buffer type of the attachment. Color attachments are cleared through their draw buffer, which has the index of their ID
+        const OGL_FramebufferAttachment& attachment = (*this->framebuffer)[i];
+        switch (attachment.type)
+        {
+        case OGL_COLOR_ATTACHMENT:
+            glClearBufferfv(GL_COLOR, attachment.attachmentID, op.clearColor);
+            break;
+        case OGL_DEPTH_ATTACHMENT:
+            glClearBufferfv(GL_DEPTH, 0, &op.clearDepth);
+            break;
+        case OGL_STENCIL_ATTACHMENT:
+            glClearBufferiv(GL_STENCIL, 0, &op.clearStencil);
+            break;
+        case OGL_DEPTH_STENCIL_ATTACHMENT:
+            glClearBufferfi(GL_DEPTH_STENCIL, 0, op.clearDepth, op.clearStencil);
+            break;
+        
+        default:
+            break;
+        }
+    }
+}
+
+void OGL_RenderPass::end()
+{
+    //store the attachments whose content is not needed anymore
+    std::vector<GLenum> invalid;
+    for (size_t i = 0; i < this->ops.size(); ++i) {if (this->ops[i].store == OGL_STORE_OP_DISCARD) {this->getInvalidationPoints(i, invalid);}}
+    //invalidate them
+    this->invalidate(invalid);
+}
+
+void OGL_RenderPass::getInvalidationPoints(size_t index, std::vector<GLenum>& points)
+{
+    //check for the default framebuffer
+    if (!this->framebuffer)
+    {
+        //the first entry is the color buffer
+        if (index == 0) {points.push_back(GL_COLOR);}
+        //the second entry is the depth and stencil buffer
+        else if (index == 1) {points.push_back(GL_DEPTH); points.push_back(GL_STENCIL);}
+        return;
+    }
+    //add the attachment point if the attachment exists
+    if (index < this->framebuffer->getAttachmentCount()) {points.push_back(this->framebuffer->getAttachmentPoint(index));}
+}
+
+void OGL_RenderPass::invalidate(const std::vector<GLenum>& points)
+{
+    //check if something is invalidated
+    if (points.empty()) {return;}
+    //invalidation is only a hint, so it is skipped if the context dose not support it (OpenGL 4.3 or newer)
+    if (!(GLEW_VERSION_4_3 || GLEW_ARB_invalidate_subdata)) {return;}
+    //get the current instance
+    OGL_Instance* instance = oglGetCurrentInstance();
+    //with direct state access, invalidate without binding
+    if (instance->usingDSA())
+    {
+        glInvalidateNamedFramebufferData(this->framebuffer ? this->framebuffer->getFramebuffer() : 0, points.size(), points.data());
+        return;
+    }
+    //bind the framebuffer for drawing
+    if (this->framebuffer) {this->framebuffer->bind(GL_DRAW_FRAMEBUFFER);}
+    else {instance->bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);}
+    //invalidate the attachments
+    glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, points.size(), points.data());
+}
@@ -0,0 +1,158 @@
+/**
+ * @file OGL_RenderTargetPool.cpp
+ * @author DM8AT
+ * @brief implement a pool that re-uses render targets
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+/**
+ * @brief round a size up to the next size class
+ * 
+ * @param size the size in pixels
+ * @return uint32_t the size of the size class, a multiple of OGL_RENDER_TARGET_GRANULARITY
+ */
+static uint32_t getSizeClass(uint32_t size)
+{
+    //a size of 0 still needs one class
+    if (size == 0) {size = 1;}
+    //round up to the granularity
+    return ((size + OGL_RENDER_TARGET_GRANULARITY - 1) / OGL_RENDER_TARGET_GRANULARITY) * OGL_RENDER_TARGET_GRANULARITY;
+}
+
+/**
+ * @brief get the index of the current frame
+ * 
+ * @return uint64_t the frame of the current instance, or 0 if no instance exists
+ */
+static uint64_t getCurrentFrame()
+{
+    //get the current instance
+    OGL_Instance* instance = oglGetCurrentInstance();
+    //return the frame
+    return instance ? instance->getFrame() : 0;
+}
+
+/**
+ * @brief allocate storage for the texture of a render target
+ * 
+ * @param target the render target with the size class, format and sample count
+ */
+static void allocateTarget(OGL_PooledRenderTarget& target)
+{
+    //multisampled render targets use multisample textures, the layers are the amount of samples
+    OGL_TextureType type = (target.samples > 1) ? OGL_TEXTURE_2D_MULTISAMPLE : OGL_TEXTURE_2D;
+    //check if the texture exists
+    if (!target.texture)
+    {
+        //create the texture with a single level
+        target.texture = new OGL_Texture(type, target.width, target.height, target.samples, target.internalFormat, GL_RGBA, 1);
+        return;
+    }
+    //re-allocate the storage without data
+    target.texture->setStorage(type, target.width, target.height, target.samples, target.internalFormat, GL_RGBA, 1);
+}
+
+OGL_RenderTargetPool::~OGL_RenderTargetPool()
+{
+    //delete all textures
+    for (OGL_PooledRenderTarget& target : this->targets) {delete target.texture;}
+    this->targets.clear();
+}
+
+OGL_Texture* OGL_RenderTargetPool::acquire(uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples)
+{
+    //store the size class
+    uint32_t w = getSizeClass(width);
+    uint32_t h = getSizeClass(height);
+    //search a free render target with the same key
+    for (OGL_PooledRenderTarget& target : this->targets)
+    {
+        if (target.used || target.width != w || target.height != h || target.internalFormat != internalFormat || target.samples != samples) {continue;}
+        //hand out the render target
+        target.used = true;
+        ++this->reuses;
+        return target.texture;
+    }
+    //create a new render target
+    OGL_PooledRenderTarget target;
+    target.width = w;
+    target.height = h;
+    target.internalFormat = internalFormat;
+    target.samples = samples;
+    target.used = true;
+    allocateTarget(target);
+    ++this->allocations;
+    //store the render target
+    this->targets.push_back(target);
+    //return the texture
+    return target.texture;
+}
+
+bool OGL_RenderTargetPool::resize(OGL_Texture* texture, uint32_t width, uint32_t height)
+{
+    //find the render target
+    OGL_PooledRenderTarget* target = this->find(texture);
+    if (!target) {std::__throw_runtime_error("The texture is not a render target of the pool");}
+    //store the new size class
+    uint32_t w = getSizeClass(width);
+    uint32_t h = getSizeClass(height);
+    //if the size class stays the same, the storage is kept
+    if (target->width == w && target->height == h) {++this->reuses; return false;}
+    //store the new size class
+    target->width = w;
+    target->height = h;
+    //allocate new storage
+    allocateTarget(*target);
+    ++this->allocations;
+    return true;
+}
+
+void OGL_RenderTargetPool::release(OGL_Texture* texture)
+{
+    //find the render target
+    OGL_PooledRenderTarget* target = this->find(texture);
+    if (!target) {return;}
+    //the render target is free now
+    target->used = false;
+    target->lastUse = getCurrentFrame();
+}
+
+void OGL_RenderTargetPool::trim(uint32_t frames)
+{
+    //store the current frame
+    uint64_t frame = getCurrentFrame();
+    //loop over all render targets
+    for (size_t i = 0; i < this->targets.size();)
+    {
+        //keep used and recently used render targets
+        if (this->targets[i].used || this->targets[i].lastUse + frames >= frame) {++i; continue;}
+        //delete the render target
+        delete this->targets[i].texture;
+        this->targets.erase(this->targets.begin() + i);
+    }
+}
+
+size_t OGL_RenderTargetPool::getMemorySize()
+{
+    //sum up the memory of all textures
+    size_t size = 0;
+    for (OGL_PooledRenderTarget& target : this->targets) {size += target.texture->getMemorySize();}
+    return size;
+}
+
+OGL_PooledRenderTarget* OGL_RenderTargetPool::find(OGL_Texture* texture)
+{
+    //search the render target of the texture
+    for (OGL_PooledRenderTarget& target : this->targets) {if (target.texture == texture) {return &target;}}
+    //the texture is not from this pool
+    return 0;
+}
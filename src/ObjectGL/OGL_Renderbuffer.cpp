@@ -0,0 +1,99 @@
+/**
+ * @file OGL_Renderbuffer.cpp
+ * @author DM8AT
+ * @brief implement renderbuffers as storage for framebuffer attachments that are never sampled
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+//a macro to ensure that the correct window is bound
+#define correctInstanceBinding() if (oglGetCurrentInstance() != this->instance) {this->instance->makeCurrent();}
+
+OGL_Renderbuffer::OGL_Renderbuffer(uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples)
+{
+    //allocate the storage
+    this->setStorage(width, height, internalFormat, samples);
+}
+
+OGL_Renderbuffer::OGL_Renderbuffer(OGL_Renderbuffer&& other)
+ : OGL_BindableBase(std::move(other))
+{
+    //take the state of the other renderbuffer
+    this->takeState(other);
+}
+
+OGL_Renderbuffer& OGL_Renderbuffer::operator=(OGL_Renderbuffer&& other)
+{
+    //moving into itself changes nothing
+    if (this == &other) {return *this;}
+    //destroy the own renderbuffer and take the place of the other one in the instance
+    OGL_BindableBase::operator=(std::move(other));
+    //take the state of the other renderbuffer
+    this->takeState(other);
+    //return a reference to this
+    return *this;
+}
+
+void OGL_Renderbuffer::takeState(OGL_Renderbuffer& other)
+{
+    //take the renderbuffer and its description
+    this->renderbuffer = other.renderbuffer;
+    this->width = other.width;
+    this->height = other.height;
+    this->internalFormat = other.internalFormat;
+    this->samples = other.samples;
+    //the other renderbuffer owns nothing anymore, so using it through an old pointer fails instead of using the renderbuffer of this one
+    other.renderbuffer = 0;
+}
+
+void OGL_Renderbuffer::setStorage(uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //create the renderbuffer if it dose not exist
+    if (!this->renderbuffer) {this->renderbuffer = this->instance->createRenderbuffer();}
+    //store the size and the format
+    this->width = width;
+    this->height = height;
+    this->internalFormat = internalFormat;
+    this->samples = (samples > 1) ? samples : 1;
+    //a single sample is allocated without multisampling
+    GLsizei count = (this->samples > 1) ? this->samples : 0;
+    //check if direct state access is used
+    if (this->instance->usingDSA())
+    {
+        //allocate the storage without binding the renderbuffer
+        glNamedRenderbufferStorageMultisample(this->renderbuffer, count, internalFormat, width, height);
+        return;
+    }
+    //bind the renderbuffer, renderbuffers are only bound to change their storage
+    glBindRenderbuffer(GL_RENDERBUFFER, this->renderbuffer);
+    //allocate the storage
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, count, internalFormat, width, height);
+    //unbind the renderbuffer again
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+}
+
+size_t OGL_Renderbuffer::getMemorySize()
+{
+    //each sample of each pixel is stored
+    return (size_t)this->width * this->height * this->samples * oglGetTexelSize(this->internalFormat);
+}
+
+void OGL_Renderbuffer::onDestroy()
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //delete the renderbuffer
+    if (this->renderbuffer) {glDeleteRenderbuffers(1, &this->renderbuffer);}
+    //set the renderbuffer to 0
+    this->renderbuffer = 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file OGL_Sampler.cpp
+ * @author DM8AT
+ * @brief implement samplers that share OpenGL sampler objects
+ * @version 0.1
+ * @date 2024-08-24
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+//a macro to ensure that the correct window is bound
+#define correctInstanceBinding() if (oglGetCurrentInstance() != this->instance) {this->instance->makeCurrent();}
+
+OGL_Sampler::OGL_Sampler(const OGL_SamplerDesc& desc)
+{
+    //store the description
+    this->desc = desc;
+    //get the shared sampler object
+    this->sampler = this->instance->acquireSampler(desc);
+}
+
+OGL_Sampler::OGL_Sampler(GLenum minFilter, GLenum magFilter, GLenum wrap)
+{
+    //store the filters
+    this->desc.minFilter = minFilter;
+    this->desc.magFilter = magFilter;
+    //store the wrap mode for all coordinates
+    this->desc.wrapS = wrap;
+    this->desc.wrapT = wrap;
+    this->desc.wrapR = wrap;
+    //get the shared sampler object
+    this->sampler = this->instance->acquireSampler(this->desc);
+}
+
+OGL_Sampler::OGL_Sampler(OGL_Sampler&& other)
+ : OGL_BindableBase(std::move(other))
+{
+    //take the state of the other sampler
+    this->takeState(other);
+}
+
+OGL_Sampler& OGL_Sampler::operator=(OGL_Sampler&& other)
+{
+    //moving into itself changes nothing
+    if (this == &other) {return *this;}
+    //give back the own sampler object and take the place of the other one in the instance
+    OGL_BindableBase::operator=(std::move(other));
+    //take the state of the other sampler
+    this->takeState(other);
+    //return a reference to this
+    return *this;
+}
+
+void OGL_Sampler::takeState(OGL_Sampler& other)
+{
+    //take the sampler object and its description
+    this->desc = other.desc;
+    this->sampler = other.sampler;
+    //the other sampler owns nothing anymore, so textures that still point to it fail instead of using the object of this one
+    other.sampler = 0;
+}
+
+void OGL_Sampler::setDesc(const OGL_SamplerDesc& desc)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //get the sampler object for the new description first, so an object used only by this sampler is not deleted if the description stays the same
+    GLuint sampler = this->instance->acquireSampler(desc);
+    //give back the old object
+    if (this->sampler) {this->instance->releaseSampler(this->sampler);}
+    //store the new sampler
+    this->sampler = sampler;
+    this->desc = desc;
+}
+
+void OGL_Sampler::bind(uint8_t unit)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //bind the sampler to the unit
+    this->instance->bindSampler(unit, this->sampler);
+}
+
+void OGL_Sampler::unbind(uint8_t unit)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //unbind the sampler from the unit
+    this->instance->bindSampler(unit, 0);
+}
+
+void OGL_Sampler::onDestroy()
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //give back the sampler object, it is deleted when no other sampler uses it
+    if (this->sampler) {this->instance->releaseSampler(this->sampler);}
+    //set the sampler to 0
+    this->sampler = 0;
+}
+
+void oglBindTextures(uint8_t first, const std::vector<OGL_Texture*>& textures)
+{
+    //get the instance the textures belong to
+    OGL_Instance* instance = oglGetCurrentInstance();
+    //check if an instance exists
+    if (!instance) {std::__throw_runtime_error("Can't bind textures without an instance");}
+    //store the samplers for all units
+    std::vector<GLuint> samplers(textures.size(), 0);
+    //loop over all textures
+    for (size_t i = 0; i < textures.size(); ++i)
+    {
+        //units without a texture only lose their sampler
+        if (!textures[i]) {continue;}
+        //upload a pending load, load an evicted texture again and count the use for the texture memory budget, like binding a single texture
+        textures[i]->prepareBind();
+        //bind the texture
+        instance->bindTexture(first + i, textures[i]->getTarget(), textures[i]->getTexture());
+        //store the sampler of the texture
+        if (textures[i]->getSampler()) {samplers[i] = textures[i]->getSampler()->getSampler();}
+    }
+    //bind all samplers at once
+    instance->bindSamplers(first, samplers.size(), samplers.data());
+}
@@ -206,6 +206,10 @@ void OGL_Shader::recompileShader(std::string vs, std::string fs, OGL_ShaderInput
     default:
         break;
     }
+    //the new program has none of the uniform values
+    for (OGL_UniformInfo& ui : this->uniforms) {ui.invalidate();}
+    //read the active uniforms of the new program
+    this->reflectUniforms();
 }
 
 void OGL_Shader::bind()
@@ -214,33 +218,26 @@ void OGL_Shader::bind()
     correctInstanceBinding()
 
     //bind the shader
-    glUseProgram(this->shader);
+    this->instance->useProgram(this->shader);
+    //upload the uniforms
+    this->uploadUniforms();
+}
+
+void OGL_Shader::uploadUniforms()
+{
+    //make sure to bind the correct instace
+    correctInstanceBinding()
+    //store if the uniforms can be set without binding the shader
+    bool dsa = this->instance->usingDSA();
     //loop over all uniforms
     for (OGL_UniformInfo& ui : this->uniforms)
     {
-        //switch over the type
-        switch (ui.type)
-        {
-        case OGL_TYPE_FLOAT:
-            //set the float
-            glUniform1fv(ui.location, 1, (float*)((void*)ui.data));
-            break;
-        
-        case OGL_TYPE_INT:
-            //set the int
-            glUniform1iv(ui.location, 1, (int*)((void*)ui.data));
-            break;
-
-        case OGL_TYPE_UINT:
-            //set the unsigned int
-            glUniform1uiv(ui.location, 1, (unsigned int*)((void*)ui.data));
-            break;
-
-        default:
-            //throw an error
-            std::__throw_runtime_error("The requested type is not a valid type for an uniform");
-            break;
-        }
+        //skip all uniforms that where not changed since the last upload
+        if (!ui.dirty) {continue;}
+        //without direct state access, the shader must be in use
+        if (!dsa) {this->instance->useProgram(this->shader);}
+        //upload the uniform if the program dose not have the value yet
+        ui.uploadIfChanged(this->shader, dsa);
     }
 }
 
@@ -249,39 +246,83 @@ void OGL_Shader::unbind()
     //make sure to bind the correct instace
     correctInstanceBinding()
     //unbind the shader
-    glUseProgram(0);
+    this->instance->useProgram(0);
 }
 
-OGL_UniformInfo& OGL_Shader::operator[](std::string name)
+OGL_UniformInfo& OGL_Shader::operator[](const std::string& name)
 {
-    //store the element index
-    size_t idx = -1;
-    //iterate over all uniforms
-    for (size_t i = 0; i < this->uniforms.size(); ++i)
-    {
-        //check if this is the correct element
-        if (this->uniforms[i].name == name)
-        {
-            //if it is, store the index
-            idx = i;
-            //stop the loop
-            break;
-        }
-    }
-    //check if the element was found
-    if (idx != (size_t)-1)
-    {
-        //return a reference to the element
-        return this->uniforms[idx];
-    }
+    //return the element at the index of the name, it is added if it dosn't exist
+    return this->uniforms[this->addUniform(name)];
+}
+
+size_t OGL_Shader::getUniformIndex(const std::string& name)
+{
+    //search the name in the lookup table
+    std::unordered_map<std::string, size_t>::iterator it = this->uniformLookup.find(name);
+    //return the index if the name is known, else -1
+    return (it != this->uniformLookup.end()) ? it->second : (size_t)-1;
+}
+
+size_t OGL_Shader::addUniform(const std::string& name)
+{
+    //search the name in the lookup table
+    std::unordered_map<std::string, size_t>::iterator it = this->uniformLookup.find(name);
+    //if the name is known, return the index
+    if (it != this->uniformLookup.end()) {return it->second;}
+    //make sure the correct instance is bound
+    correctInstanceBinding()
     //store the index of the new element
-    idx = this->uniforms.size();
+    size_t idx = this->uniforms.size();
     //create a new element
     this->uniforms.push_back(OGL_UniformInfo());
     //set the name to the requested one
     this->uniforms[idx].name = name;
-    //return a reference to the requested element
-    return this->uniforms[idx];
+    //the uniform was not active when reflecting, but it may be requested with a different spelling like name[1]
+    this->uniforms[idx].location = glGetUniformLocation(this->shader, name.c_str());
+    //store the index for the name
+    this->uniformLookup[name] = idx;
+    //return the index of the new element
+    return idx;
+}
+
+void OGL_Shader::setUniforms(std::vector<OGL_UniformInfo> uniforms)
+{
+    //make sure the correct instance is bound
+    correctInstanceBinding()
+    //loop over all given uniforms
+    for (OGL_UniformInfo& given : uniforms)
+    {
+        //search the uniform by name
+        std::unordered_map<std::string, size_t>::iterator it = this->uniformLookup.find(given.name);
+        //check if the uniform is new
+        if (it == this->uniformLookup.end())
+        {
+            //the uniform was not reflected, so it asks for its location like a uniform added by name
+            given.location = glGetUniformLocation(this->shader, given.name.c_str());
+            given.invalidate();
+            //store the index of the uniform
+            this->uniformLookup[given.name] = this->uniforms.size();
+            //add the uniform
+            this->uniforms.push_back(std::move(given));
+            continue;
+        }
+        //get the existing uniform, the index and the location stay the same
+        OGL_UniformInfo& ui = this->uniforms[it->second];
+        //untyped uniforms take the layout of the given uniform, reflected uniforms keep the layout the program reports
+        if (!ui.uploader)
+        {
+            //copy the layout
+            ui.type = given.type;
+            ui.components = given.components;
+            ui.columns = given.columns;
+            ui.count = given.count;
+            ui.uploader = given.uploader;
+        }
+        //take the value
+        memcpy(ui.data, given.data, sizeof(ui.data));
+        //the value must be uploaded
+        ui.invalidate();
+    }
 }
 
 OGL_UniformInfo& OGL_Shader::operator[](size_t index)
@@ -303,6 +344,57 @@ void OGL_Shader::recalculateUniforms()
     {
         //get the location
         ui.location = glGetUniformLocation(this->shader, ui.name.c_str());
+        //if the location changed, the value must be uploaded again
+        if (ui.location != ui.gpuLocation) {ui.invalidate();}
+    }
+}
+
+void OGL_Shader::reflectUniforms()
+{
+    //store which of the known uniforms are still active
+    std::vector<bool> active(this->uniforms.size(), false);
+    //loop over all uniforms that are active in the program
+    for (const OGL_UniformInfo& reflected : oglReflectUniforms(this->shader))
+    {
+        //search the uniform by name
+        std::unordered_map<std::string, size_t>::iterator it = this->uniformLookup.find(reflected.name);
+        //check if the uniform is new
+        if (it == this->uniformLookup.end())
+        {
+            //store the index of the uniform
+            this->uniformLookup[reflected.name] = this->uniforms.size();
+            //add the reflected uniform
+            this->uniforms.push_back(reflected);
+            continue;
+        }
+        //the uniform is still active
+        active[it->second] = true;
+        //get the existing uniform, the index and the value stay the same
+        OGL_UniformInfo& ui = this->uniforms[it->second];
+        //update the location
+        ui.location = reflected.location;
+        //untyped uniforms take the layout the program reports
+        if (!ui.uploader)
+        {
+            //copy the layout
+            ui.type = reflected.type;
+            ui.components = reflected.components;
+            ui.columns = reflected.columns;
+            ui.count = reflected.count;
+            ui.uploader = reflected.uploader;
+        }
+        //the value was set by the user, so it must be uploaded to the new program
+        ui.invalidate();
+    }
+    //the reflected uniforms allready have the correct location, only the others must be updated
+    for (size_t i = 0; i < active.size(); ++i)
+    {
+        //skip uniforms that where reflected
+        if (active[i]) {continue;}
+        //elements of arrays like name[1] are not reflected on they're own, so they must ask for they're location
+        if (this->uniforms[i].name.find('[') != std::string::npos) {this->uniforms[i].location = glGetUniformLocation(this->shader, this->uniforms[i].name.c_str());}
+        //all other uniforms are not active anymore
+        else {this->uniforms[i].location = -1;}
     }
 }
 
@@ -310,6 +402,8 @@ void OGL_Shader::onDestroy()
 {
     //make sure to bind the correct instance
     correctInstanceBinding()
+    //remove the program from the state cache
+    this->instance->forgetProgram(this->shader);
     //delete the program
     glDeleteProgram(this->shader);
 }
\ No newline at end of file
@@ -23,12 +23,14 @@
  */
 #define checkExistance(buffer, error) if (buffer == 0) { std::__throw_runtime_error(error); }
 
-OGL_ShaderStorageBuffer::OGL_ShaderStorageBuffer(void* data, size_t size)
+OGL_ShaderStorageBuffer::OGL_ShaderStorageBuffer(void* data, size_t size, GLenum usage)
 {
+    //store the usage hint
+    this->usage.setUsage(usage);
     //bind the correct instance
     correctInstanceBinding()
     //create the SSBO
-    glGenBuffers(1, &this->ssbo);
+    this->ssbo = this->instance->createBuffer();
     //cast to a function
     this->updateData(data, size);
     //upload the data
@@ -47,6 +49,20 @@ void OGL_ShaderStorageBuffer::updateData(void* data, size_t size)
         //copy the data
         memcpy(this->data.data(), data, size);
     }
+    //all data must be uploaded
+    this->dirty.markAll();
+    //the data is on the CPU again
+    this->gpuOnly = false;
+}
+
+void OGL_ShaderStorageBuffer::updateData(std::vector<uint8_t>&& data)
+{
+    //take the data
+    this->data = std::move(data);
+    //all data must be uploaded
+    this->dirty.markAll();
+    //the data is on the CPU again
+    this->gpuOnly = false;
 }
 
 void OGL_ShaderStorageBuffer::upload()
@@ -55,22 +71,174 @@ void OGL_ShaderStorageBuffer::upload()
     correctInstanceBinding()
     //check if the buffer exists
     checkExistance(this->ssbo, "Can't upload an unitalised buffer")
-    //bind the buffer
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->ssbo);
+    //the data must be on the CPU
+    if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+    //count the upload, if the usage hint changed the storage is re-allocated with the new hint
+    if (this->usage.recordUpload(this->instance->getFrame())) {this->gpuSize = 0;}
+    //check if the data fits into the storage on the GPU
+    if (this->data.size() <= this->gpuSize && this->gpuSize != 0)
+    {
+        //only upload the modified bytes
+        this->dirty.flush(this->instance, GL_SHADER_STORAGE_BUFFER, this->ssbo, this->data.data(), this->data.size());
+        return;
+    }
     //upload the data
-    glBufferData(GL_SHADER_STORAGE_BUFFER, this->data.size(), this->data.data(), GL_DYNAMIC_READ);
-    //unbind the buffer
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    this->instance->bufferData(GL_SHADER_STORAGE_BUFFER, this->ssbo, this->data.size(), this->data.data(), this->usage.getUsage());
+    this->usage.recordReallocation();
+    //store the new size of the storage
+    this->gpuSize = this->data.size();
+    //the GPU has all data now
+    this->dirty.clear();
 }
 
 void OGL_ShaderStorageBuffer::download()
 {
     //correct the instance
     correctInstanceBinding()
-    //bind the buffer
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->ssbo);
+    //check if the buffer is only on the GPU
+    if (this->gpuOnly)
+    {
+        //create the copy on the CPU again
+        this->data.resize(this->gpuSize);
+        this->gpuOnly = false;
+    }
     //download the data
-    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, this->data.size(), this->data.data());
+    this->instance->getBufferSubData(GL_SHADER_STORAGE_BUFFER, this->ssbo, 0, this->data.size(), this->data.data());
+    //the CPU has the same data as the GPU now
+    this->dirty.clear();
+}
+
+void OGL_ShaderStorageBuffer::downloadAsync(size_t offset, size_t size, void (*callback)(OGL_ShaderStorageBuffer* buffer, size_t offset, size_t size, void* userData), void* userData)
+{
+    //correct the instance
+    correctInstanceBinding()
+    //check if the buffer exists
+    checkExistance(this->ssbo, "Can't download an unitalised buffer")
+    //the data is stored in the CPU copy
+    if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released, use download to get it back");}
+    //check if the range is in bounds
+    if ((offset + size) > this->data.size())
+    {
+        //if not, throw an error
+        std::__throw_runtime_error("The range to download is not in bounds of the shader storage buffer");
+        return;
+    }
+    //store the new download
+    OGL_PendingDownload download;
+    //search a free staging buffer that is big enough
+    for (size_t i = 0; i < this->freeStaging.size(); ++i)
+    {
+        //skip too small buffers
+        if (this->freeStaging[i].stagingSize < size) {continue;}
+        //use the buffer
+        download = this->freeStaging[i];
+        this->freeStaging.erase(this->freeStaging.begin() + i);
+        break;
+    }
+    //check if a new staging buffer is needed
+    if (download.staging == 0)
+    {
+        //create the staging buffer, it is only written by the GPU and read by the CPU
+        download.staging = this->instance->createBuffer();
+        download.stagingSize = size;
+        this->instance->bufferData(GL_COPY_WRITE_BUFFER, download.staging, size, 0, GL_STREAM_READ);
+    }
+    //copy the range to the staging buffer on the GPU, this dose not wait
+    if (size != 0) {this->instance->copyBufferSubData(this->ssbo, download.staging, offset, 0, size);}
+    //the copy is done when the fence is signaled
+    download.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    //store the range and the callback
+    download.offset = offset;
+    download.size = size;
+    download.callback = callback;
+    download.userData = userData;
+    //add the download
+    this->downloads.push_back(download);
+}
+
+size_t OGL_ShaderStorageBuffer::pollDownloads()
+{
+    //correct the instance
+    correctInstanceBinding()
+    //downloads finish in order, so only the oldest ones need to be checked
+    while (!this->downloads.empty())
+    {
+        //check if the GPU is done without waiting. The flush makes sure the fence is send to the GPU at all
+        GLenum result = glClientWaitSync(this->downloads[0].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        //stop if the GPU is not done yet
+        if (result == GL_TIMEOUT_EXPIRED) {break;}
+        //get the download
+        OGL_PendingDownload download = this->downloads[0];
+        this->downloads.erase(this->downloads.begin());
+        //the fence is not needed anymore
+        glDeleteSync(download.fence);
+        download.fence = 0;
+        //only a signaled fence says that the copy is done
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+        {
+            //the staging buffer can still be used for other downloads
+            this->freeStaging.push_back(download);
+            //the data is not known, so the download failed
+            std::__throw_runtime_error("Failed to wait for the GPU to finish an asynchronous download of a shader storage buffer");
+        }
+        //read the staging buffer, the copy is done so this dose not wait. The data may have shrunk since the download started
+        if (download.offset + download.size <= this->data.size() && download.size != 0)
+        {
+            //store the data
+            this->instance->getBufferSubData(GL_COPY_READ_BUFFER, download.staging, 0, download.size, this->data.data() + download.offset);
+        }
+        //keep the staging buffer for the next download
+        this->freeStaging.push_back(download);
+        //call the callback
+        if (download.callback) {(*download.callback)(this, download.offset, download.size, download.userData);}
+    }
+    //return the amount of pending downloads
+    return this->downloads.size();
+}
+
+void OGL_ShaderStorageBuffer::waitDownloads()
+{
+    //correct the instance
+    correctInstanceBinding()
+    //loop until all downloads are done
+    while (!this->downloads.empty())
+    {
+        //wait for the oldest download, keep waiting if it is not done yet
+        if (glClientWaitSync(this->downloads[0].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {continue;}
+        //store all finished downloads. If the wait failed, this throws
+        this->pollDownloads();
+    }
+}
+
+void OGL_ShaderStorageBuffer::releaseCPUData()
+{
+    //upload the changes
+    this->upload();
+    //free the data
+    this->data.clear();
+    this->data.shrink_to_fit();
+    //the buffer is now only on the GPU
+    this->gpuOnly = true;
+}
+
+void OGL_ShaderStorageBuffer::uploadGPUOnly(const void* data, size_t size)
+{
+    //correct the instance
+    correctInstanceBinding()
+    //create the buffer if it dose not exist
+    if (this->ssbo == 0) {this->ssbo = this->instance->createBuffer();}
+    //free the data on the CPU
+    this->data.clear();
+    this->data.shrink_to_fit();
+    this->dirty.clear();
+    //count the upload
+    this->usage.recordUpload(this->instance->getFrame());
+    //upload the data
+    this->gpuSize = size;
+    this->instance->bufferData(GL_SHADER_STORAGE_BUFFER, this->ssbo, size, data, this->usage.getUsage());
+    this->usage.recordReallocation();
+    //the buffer is now only on the GPU
+    this->gpuOnly = true;
 }
 
 void OGL_ShaderStorageBuffer::bind(uint8_t unit)
@@ -80,7 +248,17 @@ void OGL_ShaderStorageBuffer::bind(uint8_t unit)
     //check if the buffer exists
     checkExistance(this->ssbo, "Can't bind an unitalised buffer")
     //simply bind the buffer
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, unit, this->ssbo);
+    this->instance->bindBufferBase(GL_SHADER_STORAGE_BUFFER, unit, this->ssbo);
+}
+
+void OGL_ShaderStorageBuffer::bindRange(uint8_t unit, GLintptr offset, GLsizeiptr size)
+{
+    //bind the correct instance
+    correctInstanceBinding()
+    //check if the buffer exists
+    checkExistance(this->ssbo, "Can't bind an unitalised buffer")
+    //bind the range
+    this->instance->bindBufferRange(GL_SHADER_STORAGE_BUFFER, unit, this->ssbo, offset, size);
 }
 
 void OGL_ShaderStorageBuffer::unbind()
@@ -88,7 +266,7 @@ void OGL_ShaderStorageBuffer::unbind()
     //bind the correct instance
     correctInstanceBinding()
     //unbind all buffers
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    this->instance->bindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
 void OGL_ShaderStorageBuffer::onDestroy()
@@ -98,6 +276,21 @@ void OGL_ShaderStorageBuffer::onDestroy()
     {
         //bind the correct instance
         correctInstanceBinding()
+        //delete the pending downloads and the staging buffers
+        for (OGL_PendingDownload& download : this->downloads) {this->freeStaging.push_back(download);}
+        for (OGL_PendingDownload& download : this->freeStaging)
+        {
+            //delete the fence if it exists
+            if (download.fence) {glDeleteSync(download.fence);}
+            //delete the staging buffer
+            this->instance->forgetBuffer(download.staging);
+            glDeleteBuffers(1, &download.staging);
+        }
+        //clear the downloads
+        this->downloads.clear();
+        this->freeStaging.clear();
+        //remove the buffer from the state cache
+        this->instance->forgetBuffer(this->ssbo);
         //delete the object
         glDeleteBuffers(1, &this->ssbo);
     }
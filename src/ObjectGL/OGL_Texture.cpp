@@ -13,6 +13,10 @@
 #define OGL_KEEP_BG_ACCESS
 //include the main header
 #include "ObjectGL.hpp"
+//include the file system for the compression cache
+#include <filesystem>
+//include memcpy
+#include <cstring>
 
 //a macro to ensure that the correct window is bound
 #define correctInstanceBinding() if (oglGetCurrentInstance() != this->instance) {this->instance->makeCurrent();}
@@ -23,252 +27,784 @@
  */
 #define checkExistance(buffer, error) if (buffer == 0) { std::__throw_runtime_error(error); }
 
+bool oglDescribeSurface(SDL_Surface* surf, OGL_PixelData& image)
+{
+    //the pixels must be readable without locking the surface
+    if (SDL_MUSTLOCK(surf)) {return false;}
+    //store the bytes per pixel
+    int32_t bpp = 0;
+    //only formats OpenGL can read directly are uploaded in place
+    switch (surf->format->format)
+    {
+    case SDL_PIXELFORMAT_RGBA32: image.format = GL_RGBA; bpp = 4; break;
+    case SDL_PIXELFORMAT_BGRA32: image.format = GL_BGRA; bpp = 4; break;
+    case SDL_PIXELFORMAT_RGB24:  image.format = GL_RGB;  bpp = 3; break;
+    case SDL_PIXELFORMAT_BGR24:  image.format = GL_BGR;  bpp = 3; break;
+    default: return false;
+    }
+    //the channels are bytes
+    image.type = GL_UNSIGNED_BYTE;
+    //store the size of a row without padding
+    int32_t row = surf->w * bpp;
+    //find an alignment that pads the rows to the pitch of the surface
+    for (GLint alignment = 8; alignment >= 1; alignment /= 2)
+    {
+        if ((row + alignment - 1) / alignment * alignment != surf->pitch) {continue;}
+        image.alignment = alignment;
+        image.rowLength = 0;
+        return true;
+    }
+    //else, describe the pitch as a row length in pixels
+    if (surf->pitch % bpp != 0) {return false;}
+    image.alignment = 1;
+    image.rowLength = surf->pitch / bpp;
+    return true;
+}
+
+/**
+ * @brief check if an internal format stores half floats
+ * 
+ * @param internalFormat the internal format to check
+ * @return true : the format stores half floats | 
+ * @return false : the format stores an other type
+ */
+static bool isHalfFormat(GLenum internalFormat)
+{
+    return internalFormat == GL_RGBA16F || internalFormat == GL_RGB16F || internalFormat == GL_RG16F || internalFormat == GL_R16F;
+}
+
+/**
+ * @brief get the amount of channels of a pixel format
+ * 
+ * @param format the pixel format, like GL_RGB
+ * @return uint32_t the amount of channels
+ */
+static uint32_t getFormatChannels(GLenum format)
+{
+    switch (format)
+    {
+    case GL_RED: case GL_DEPTH_COMPONENT: return 1;
+    case GL_RG: case GL_DEPTH_STENCIL: return 2;
+    case GL_RGB: case GL_BGR: return 3;
+    default: return 4;
+    }
+}
+
+size_t oglGetTexelSize(GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+    case GL_R8: return 1;
+    case GL_RG8: case GL_R16F: case GL_DEPTH_COMPONENT16: return 2;
+    case GL_RGB8: case GL_SRGB8: return 3;
+    case GL_RGBA8: case GL_SRGB8_ALPHA8: case GL_RG16F: case GL_R32F: case GL_R11F_G11F_B10F: 
+    case GL_DEPTH_COMPONENT24: case GL_DEPTH_COMPONENT32F: case GL_DEPTH24_STENCIL8: return 4;
+    case GL_RGB16F: return 6;
+    case GL_RGBA16F: case GL_RG32F: case GL_DEPTH32F_STENCIL8: return 8;
+    case GL_RGB32F: return 12;
+    case GL_RGBA32F: return 16;
+    default: return 4;
+    }
+}
+
 /**
- * @brief add a side to a cubemap texture
+ * @brief select the internal format for a render target from the pixel format it is created with
+ * 
+ * @param policy the rules for the selection
+ * @param format the pixel format of the render target, like GL_RGBA or GL_DEPTH_COMPONENT
+ * @return GLenum the internal format
+ */
+static GLenum selectTargetFormat(const OGL_TextureFormatPolicy& policy, GLenum format)
+{
+    //depth targets only need 24 bits
+    if (format == GL_DEPTH_COMPONENT) {return GL_DEPTH_COMPONENT24;}
+    if (format == GL_DEPTH_STENCIL) {return GL_DEPTH24_STENCIL8;}
+    //select the color format by the amount of channels
+    switch (getFormatChannels(format))
+    {
+    case 1: return policy.hdrTargets ? GL_R16F : GL_R8;
+    case 2: return policy.hdrTargets ? GL_RG16F : GL_RG8;
+    case 3: return policy.hdrTargets ? (policy.packedHDR ? GL_R11F_G11F_B10F : GL_RGB16F) : GL_RGB8;
+    default: return policy.hdrTargets ? GL_RGBA16F : GL_RGBA8;
+    }
+}
+
+/**
+ * @brief select the internal format for data from the user, the precision of the data is kept
+ * 
+ * @param policy the rules for the selection
+ * @param format the pixel format of the data, like GL_RGBA
+ * @param type the type of the channels, like GL_UNSIGNED_BYTE
+ * @return GLenum the internal format
+ */
+static GLenum selectDataFormat(const OGL_TextureFormatPolicy& policy, GLenum format, GLenum type)
+{
+    //depth data uses the same formats as depth targets
+    if (format == GL_DEPTH_COMPONENT || format == GL_DEPTH_STENCIL) {return selectTargetFormat(policy, format);}
+    //store the amount of channels
+    uint32_t channels = getFormatChannels(format);
+    //half floats stay half floats
+    if (type == GL_HALF_FLOAT)
+    {
+        const GLenum formats[] = {GL_R16F, GL_RG16F, GL_RGB16F, GL_RGBA16F};
+        return formats[channels-1];
+    }
+    //floats stay floats
+    if (type == GL_FLOAT)
+    {
+        const GLenum formats[] = {GL_R32F, GL_RG32F, GL_RGB32F, GL_RGBA32F};
+        return formats[channels-1];
+    }
+    //everything else is stored as 8-Bit
+    if (policy.srgb && channels == 3) {return GL_SRGB8;}
+    if (policy.srgb && channels == 4) {return GL_SRGB8_ALPHA8;}
+    const GLenum formats[] = {GL_R8, GL_RG8, GL_RGB8, GL_RGBA8};
+    return formats[channels-1];
+}
+
+/**
+ * @brief check if the pixels of an 8-Bit image are opaque and gray
+ * 
+ * @param image the image to check, the result is stored in it
+ * @param pitch the amount of bytes per row
+ */
+static void analyzeImage(OGL_PixelData& image, int32_t pitch)
+{
+    //store the amount of channels
+    uint32_t channels = getFormatChannels(image.format);
+    //start with the best case
+    image.opaque = true;
+    image.gray = true;
+    //check all rows until both are known to be false
+    for (uint32_t y = 0; y < image.height && (image.opaque || image.gray); ++y)
+    {
+        //get the row
+        const uint8_t* p = (const uint8_t*)image.pixels + y*pitch;
+        for (uint32_t x = 0; x < image.width; ++x, p += channels)
+        {
+            //check the alpha channel
+            if (channels == 4 && p[3] != 0xFF) {image.opaque = false;}
+            //check if all colors are the same
+            if (p[0] != p[1] || p[1] != p[2]) {image.gray = false;}
+        }
+    }
+}
+
+/**
+ * @brief get the amount of bytes per row of a decoded 8-Bit image
+ * 
+ * @param image the image
+ * @return size_t the distance between two rows in bytes
+ */
+static size_t getImagePitch(const OGL_PixelData& image)
+{
+    //store the bytes per pixel
+    size_t bpp = getFormatChannels(image.format);
+    //the row length or the alignment define the padding of the rows
+    return image.rowLength ? (size_t)image.rowLength * bpp : ((size_t)image.width * bpp + image.alignment - 1) / image.alignment * image.alignment;
+}
+
+/**
+ * @brief convert a decoded 8-Bit image to tightly packed RGBA pixels
+ * 
+ * @param image the image to convert
+ * @return std::vector<uint8_t> the RGBA pixels
+ */
+static std::vector<uint8_t> toRGBA(const OGL_PixelData& image)
+{
+    //store the pixels
+    std::vector<uint8_t> rgba((size_t)image.width * image.height * 4);
+    //store the bytes per row of the source
+    size_t pitch = getImagePitch(image);
+    //convert row by row
+    for (uint32_t y = 0; y < image.height; ++y)
+    {
+        const uint8_t* src = (const uint8_t*)image.pixels + y*pitch;
+        uint8_t* dst = rgba.data() + (size_t)y*image.width*4;
+        switch (image.format)
+        {
+        case GL_RGBA: memcpy(dst, src, (size_t)image.width*4); break;
+        case GL_BGRA: oglSwizzleRedBlue(src, dst, image.width); break;
+        case GL_RGB: oglConvertRGBToRGBA(src, dst, image.width); break;
+        case GL_BGR: oglConvertRGBToRGBA(src, dst, image.width); oglSwizzleRedBlue(dst, dst, image.width); break;
+        default: break;
+        }
+    }
+    //return the pixels
+    return rgba;
+}
+
+/**
+ * @brief repack a gray 8-Bit image with alpha to two channels, gray and alpha
+ * 
+ * @param image the image to repack
+ */
+static void packGrayAlpha(OGL_PixelData& image)
+{
+    //nothing to do if the image has no alpha channel
+    if (getFormatChannels(image.format) != 4) {return;}
+    //allocate the new pixels
+    uint8_t* packed = new uint8_t[(size_t)image.width * image.height * 2];
+    //store the amount of bytes per row of the source
+    size_t pitch = getImagePitch(image);
+    //copy the first channel and the alpha
+    for (uint32_t y = 0; y < image.height; ++y)
+    {
+        const uint8_t* src = (const uint8_t*)image.pixels + y*pitch;
+        uint8_t* dst = packed + (size_t)y*image.width*2;
+        for (uint32_t x = 0; x < image.width; ++x) {dst[x*2] = src[x*4]; dst[x*2+1] = src[x*4+3];}
+    }
+    //replace the pixels, the own buffer is only used for half floats, so it is empty
+    delete[] image.buffer;
+    image.buffer = packed;
+    image.pixels = packed;
+    image.format = GL_RG;
+    image.alignment = 2;
+    image.rowLength = 0;
+}
+
+/**
+ * @brief select the internal format for decoded 8-Bit images. All images of a texture share the format
+ * 
+ * @param policy the rules for the selection
+ * @param images the decoded images, gray images with alpha are repacked to two channels if that format is selected
+ * @param gray is set to true if a one or two channel format for gray images is selected
+ * @return GLenum the internal format
+ */
+static GLenum selectImageFormat(const OGL_TextureFormatPolicy& policy, std::vector<OGL_PixelData>& images, bool* gray)
+{
+    //check if all images are opaque or gray
+    bool opaque = true;
+    bool allGray = true;
+    for (const OGL_PixelData& image : images) {opaque &= image.opaque; allGray &= image.gray;}
+    //only linear gray formats exist
+    *gray = allGray && policy.reduceChannels && !policy.srgb;
+    //one channel for opaque gray images
+    if (*gray && opaque) {return GL_R8;}
+    //two channels for gray images with alpha
+    if (*gray)
+    {
+        for (OGL_PixelData& image : images) {packGrayAlpha(image);}
+        return GL_RG8;
+    }
+    //color images
+    if (opaque) {return policy.srgb ? GL_SRGB8 : GL_RGB8;}
+    return policy.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+}
+
+/**
+ * @brief free the pixels of a decoded image
+ * 
+ * @param image the image to free
+ */
+static void freeImage(OGL_PixelData& image)
+{
+    //free the surface
+    if (image.surface) {SDL_FreeSurface(image.surface);}
+    //free the own buffer
+    delete[] image.buffer;
+    //reset the image
+    image = OGL_PixelData();
+}
+
+/**
+ * @brief load an image file and prepare it for the upload. Surfaces OpenGL can read are kept as they are, others are converted to 8-Bit RGBA. This can run on any thread
  * 
- * @param side the side to add
  * @param texFile path to the texture file
+ * @param image the image to store the pixels in. It must be freed by the caller
+ * @param premultiply say if the color should be multiplied with the alpha
+ * @param halfFloat say if the pixels should be converted to half floats
+ * @param analyze say if the image should be checked for alpha and color to select the internal format
+ * @return true : the image was decoded | 
+ * @return false : the file could not be read
  */
-void addTextureCubemap(GLenum side, const char* texFile, uint32_t* width, uint32_t* height, GLenum internalFormat)
+static bool decodeImage(const char* texFile, OGL_PixelData& image, bool premultiply, bool halfFloat, bool analyze)
 {
+    //start with an empty image
+    image = OGL_PixelData();
     //read the texture file
     SDL_Surface* surf = IMG_Load(texFile);
     //check if the surface could load
-    if (!surf)
+    if (!surf) {return false;}
+
+    //check if the surface must be converted
+    if (!oglDescribeSurface(surf, image))
     {
-        //if not, print an error
-        std::__throw_runtime_error((std::string("Failed to open file ") + texFile).c_str());
+        //convert the surface to RGBA
+        SDL_Surface* formated = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
+        //free the loaded surface
+        SDL_FreeSurface(surf);
+        //check if the conversion worked
+        if (!formated) {return false;}
+        surf = formated;
+        //a converted surface is always readable
+        oglDescribeSurface(surf, image);
     }
 
-    //store a formated surface
-    SDL_Surface* formated = SDL_CreateRGBSurface(0,surf->w,surf->h,32,0x000000FF,0x0000FF00,0x00FF0000,0xFF000000);
-    //blit the texture
-    SDL_BlitSurface(surf, 0, formated, 0);
+    //store the surface
+    image.surface = surf;
+    image.pixels = surf->pixels;
+    image.width = surf->w;
+    image.height = surf->h;
+    //store the amount of channels
+    uint32_t channels = (image.format == GL_RGBA || image.format == GL_BGRA) ? 4 : 3;
 
-    //store the width
-    *width = surf->w;
-    //store the height
-    *height = surf->h;
+    //check the content before the alpha is premultiplied
+    if (analyze) {analyzeImage(image, surf->pitch);}
 
-    //upload the texture data
-    glTexImage2D(side, 0, internalFormat, surf->w,surf->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, formated->pixels);
+    //premultiply the alpha row by row, the rows may be padded
+    if (premultiply && channels == 4)
+    {
+        for (uint32_t y = 0; y < image.height; ++y) {oglPremultiplyAlpha((uint8_t*)surf->pixels + y*surf->pitch, image.width);}
+    }
 
-    //free the surfaces
-    SDL_FreeSurface(surf);
-    SDL_FreeSurface(formated);
+    //convert to half floats, so the storage can be filled without a conversion by the driver
+    if (halfFloat)
+    {
+        //store the amount of values per row
+        size_t row = (size_t)image.width * channels;
+        //allocate the buffer
+        image.buffer = new uint8_t[row * image.height * sizeof(uint16_t)];
+        //convert row by row
+        for (uint32_t y = 0; y < image.height; ++y) {oglConvertU8ToHalf((uint8_t*)surf->pixels + y*surf->pitch, (uint16_t*)image.buffer + y*row, row);}
+        //the rows are tightly packed
+        image.pixels = image.buffer;
+        image.type = GL_HALF_FLOAT;
+        image.alignment = 2;
+        image.rowLength = 0;
+        //the surface is not needed anymore
+        SDL_FreeSurface(surf);
+        image.surface = 0;
+    }
+    //the image is decoded
+    return true;
 }
 
-OGL_Texture::OGL_Texture(OGL_TextureType type, uint32_t width, uint32_t height, uint32_t layers, GLenum internalFormat, GLenum format)
+/**
+ * @brief load an image file and prepare it for the upload
+ * 
+ * @param texFile path to the texture file
+ * @param premultiply say if the color should be multiplied with the alpha
+ * @param halfFloat say if the pixels should be converted to half floats
+ * @param analyze say if the image should be checked for alpha and color to select the internal format
+ * @return OGL_PixelData the decoded image. It must be freed by the caller
+ */
+static OGL_PixelData loadImage(const char* texFile, bool premultiply, bool halfFloat, bool analyze)
 {
-    //create the texture
-    glGenTextures(1, &this->texture);
-    //store the type
-    this->type = type;
-    //store the width
-    this->width = width;
-    //store the height
-    this->height = height;
-
-    //switch over the type
-    switch (type)
+    //store the image
+    OGL_PixelData image;
+    //check if the file could load
+    if (!decodeImage(texFile, image, premultiply, halfFloat, analyze))
     {
-    case OGL_TEXTURE_2D:
-        //store the type
-        this->format = GL_TEXTURE_2D;
-        //bind the texture
-        this->bind(0);
-        //create a clear 2D texture
-        glTexImage2D(this->format, 0, internalFormat, width, height, 0, format, GL_FLOAT, 0);
-        break;
+        //if not, print an error
+        std::__throw_runtime_error((std::string("Failed to open file ") + texFile).c_str());
+    }
+    //return the image
+    return image;
+}
 
-    case OGL_TEXTURE_CUBEMAP:
-        //store the type
-        this->format = GL_TEXTURE_CUBE_MAP;
-        //set the layers to 6
-        this->layers = 6;
-        //bind the texture
-        this->bind(0);
-        //loop over all 6 faces
-        for (int i = 0; i < 6; ++i)
+/**
+ * @brief load an image file compressed to a block format. The compressed image is read from the cache if it exists, else it is compressed and written to the cache
+ * 
+ * @param texFile path to the texture file
+ * @param format the block format to compress to
+ * @param srgb say if the sRGB variant of the format should be used
+ * @param premultiply say if the color should be multiplied with the alpha before the compression
+ * @param cacheDir the directory of the cache or 0 to not use a cache
+ * @return OGL_CompressedImage the compressed image
+ */
+static OGL_CompressedImage loadCompressed(const char* texFile, OGL_BlockFormat format, bool srgb, bool premultiply, const char* cacheDir)
+{
+    //store the path of the cached file
+    std::string cacheFile;
+    if (cacheDir)
+    {
+        //the key changes if the file or the settings change. The version must be increased when the encoder changes
+        std::error_code error;
+        std::string key = std::string(texFile) + '|' + std::to_string(std::filesystem::file_size(texFile, error)) + '|' +
+                          std::to_string(std::filesystem::last_write_time(texFile, error).time_since_epoch().count()) + '|' +
+                          std::to_string(format) + '|' + std::to_string(srgb) + '|' + std::to_string(premultiply) + "|1";
+        //hash the key with FNV-1a, so the name is the same across runs
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : key) {hash = (hash ^ (uint8_t)c) * 0x100000001b3ull;}
+        char name[17];
+        snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+        cacheFile = std::string(cacheDir) + "/" + name + ".ktx";
+        //use the cached file if it exists and can be read, a broken file is created again
+        if (std::filesystem::exists(cacheFile, error))
         {
-            //store a clear 2D texture
-            glTextureStorage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X+i, layers, internalFormat, width, height);
+            try {return OGL_CompressedImage(cacheFile.c_str());}
+            catch (const std::exception&) {}
         }
-        break;
+    }
+    //load the file and convert it to RGBA
+    OGL_PixelData image = loadImage(texFile, premultiply, false, false);
+    std::vector<uint8_t> rgba = toRGBA(image);
+    uint32_t width = image.width, height = image.height;
+    freeImage(image);
+    //compress the image with all mip levels
+    OGL_CompressedImage compressed;
+    compressed.compress(rgba.data(), width, height, format, srgb, true);
+    //write the cache, a failed write only means it is compressed again next time
+    if (cacheDir)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(cacheDir, error);
+        compressed.save(cacheFile.c_str());
+    }
+    //return the compressed image
+    return compressed;
+}
 
-    case OGL_TEXTURE_ARRAY_2D:
-        //store the type
-        this->format = GL_TEXTURE_2D_ARRAY;
-        //store the layers
-        this->layers = layers;
-        //make the format ready
-        glTexStorage3D(this->texture, 1, internalFormat, width, height, layers);
-        break;
-    
-    default:
-        break;
+/**
+ * @brief check if the amount of files is correct for a texture type
+ * 
+ * @param count the amount of files
+ * @param type the type of the texture
+ */
+static void checkFileCount(size_t count, OGL_TextureType type)
+{
+    //2D textures are made from a single file
+    if (type == OGL_TEXTURE_2D && count != 1)
+    {
+        //throw an error
+        std::__throw_runtime_error("The amount of files is not correct to create a 2D texture");
+    }
+    //cubemaps are made from 6 faces
+    if (type == OGL_TEXTURE_CUBEMAP && count != 6)
+    {
+        //throw an error
+        std::__throw_runtime_error("The amount of files is not correct to create a cubemap texture");
     }
+    //no size-check needed for arrays, every size is good
+}
+
+/**
+ * @brief free a decode job and all surfaces in it
+ * 
+ * @param job the job to free
+ */
+static void freeDecodeJob(OGL_TextureDecodeJob* job)
+{
+    //free all images
+    for (OGL_PixelData& image : job->images) {freeImage(image);}
+    //free the job
+    delete job;
+}
+
+/**
+ * @brief decode a single file of a decode job. This runs on a worker thread
+ * 
+ * @param data a pointer to the decode job
+ * @param index the index of the file to decode
+ */
+static void decodeJobFile(void* data, size_t index)
+{
+    //get the job
+    OGL_TextureDecodeJob* job = (OGL_TextureDecodeJob*)data;
+    //decode the file, a failed file is reported by the texture
+    decodeImage(job->files[index].c_str(), job->images[index], job->premultiply, isHalfFormat(job->internalFormat), job->internalFormat == OGL_TEXTURE_FORMAT_AUTO);
+    //this task is done, if it was the last user, free the job
+    if (--job->references == 0) {freeDecodeJob(job);}
+}
+
+/**
+ * @brief store the storage generation the next allocation of any texture gets. It is unique across all textures, so a framebuffer notices new storage even if OpenGL re-uses the texture name
+ */
+static uint64_t nextStorageGeneration = 1;
+
+/**
+ * @brief calculate the amount of mip levels of a full mip chain
+ * 
+ * @param width the width of the base level
+ * @param height the height of the base level
+ * @return GLsizei the amount of mip levels
+ */
+static GLsizei getFullMipCount(uint32_t width, uint32_t height)
+{
+    //store the amount of levels
+    GLsizei levels = 1;
+    //halve the biggest side until it reaches 1
+    for (uint32_t size = (width > height) ? width : height; size > 1; size >>= 1) {++levels;}
+    //return the amount of levels
+    return levels;
+}
+
+OGL_Texture::OGL_Texture(OGL_TextureType type, uint32_t width, uint32_t height, uint32_t layers, GLenum internalFormat, GLenum format, uint32_t mipLevels)
+{
+    //allocate the storage
+    this->setStorage(type, width, height, layers, internalFormat, format, mipLevels);
 }
 
 OGL_Texture::OGL_Texture(const char* texFile, GLenum internalFormat)
 {
-    //create the texture
-    glGenTextures(1, &this->texture);
     //set the texture
     this->setTexture(texFile, internalFormat);
 }
 
 OGL_Texture::OGL_Texture(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat)
 {
-    //create the texture
-    glGenTextures(1, &this->texture);
     //set the texture
     this->setTexture(texFiles, type, internalFormat);
 }
 
 OGL_Texture::OGL_Texture(void* data, uint32_t width, uint32_t height, GLenum format, GLenum type, GLenum internalFormat)
 {
-    //create the texture
-    glGenTextures(1, &this->texture);
     //set the texture
     this->setTexture(data, width, height, format, type, internalFormat);
 }
 
+OGL_Texture::OGL_Texture(OGL_Texture&& other)
+ : OGL_BindableBase(std::move(other))
+{
+    //take the state of the other texture
+    this->takeState(other);
+}
+
+OGL_Texture& OGL_Texture::operator=(OGL_Texture&& other)
+{
+    //moving into itself changes nothing
+    if (this == &other) {return *this;}
+    //destroy the own texture and take the place of the other one in the instance
+    OGL_BindableBase::operator=(std::move(other));
+    //take the state of the other texture
+    this->takeState(other);
+    //return a reference to this
+    return *this;
+}
+
+void OGL_Texture::takeState(OGL_Texture& other)
+{
+    //copy the description of the storage
+    this->type = other.type;
+    this->format = other.format;
+    this->width = other.width;
+    this->height = other.height;
+    this->layers = other.layers;
+    this->samples = other.samples;
+    this->mipLevels = other.mipLevels;
+    this->levels = other.levels;
+    this->storageGeneration = other.storageGeneration;
+    this->premultiply = other.premultiply;
+    this->internalFormat = other.internalFormat;
+    this->graySwizzle = other.graySwizzle;
+    this->sampler = other.sampler;
+    this->source = std::move(other.source);
+    this->evicted = other.evicted;
+    this->loadError = std::move(other.loadError);
+    this->texParameters = std::move(other.texParameters);
+    //take the OpenGL texture and the pending load
+    this->texture = other.texture;
+    this->job = other.job;
+    //the other texture owns nothing anymore, so using it through an old pointer fails instead of using the texture of this one
+    other.texture = 0;
+    other.job = 0;
+    other.levels = 0;
+}
+
 void OGL_Texture::setTexture(const char* texFile, GLenum internalFormat)
 {
-    //open the surface
-    SDL_Surface* surf = IMG_Load(texFile);
-    //check if the surface could load
-    if (!surf)
+    //pass to the function for multiple files
+    this->setTexture(std::vector<const char*>{texFile}, OGL_TEXTURE_2D, internalFormat);
+}
+
+void OGL_Texture::setTexture(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat)
+{
+    //check if the amount of files is correct
+    checkFileCount(texFiles.size(), type);
+    //the new data replaces a pending background load
+    this->abandonJob();
+    //store the images
+    std::vector<OGL_PixelData> images;
+    images.reserve(texFiles.size());
+    //load all files, free the loaded ones if one fails
+    try {for (const char* file : texFiles) {images.push_back(loadImage(file, this->premultiply, isHalfFormat(internalFormat), internalFormat == OGL_TEXTURE_FORMAT_AUTO));}}
+    catch (...) {for (OGL_PixelData& image : images) {freeImage(image);} throw;}
+    //upload the images
+    this->uploadImages(images, type, internalFormat);
+    //free the images
+    for (OGL_PixelData& image : images) {freeImage(image);}
+    //the files can be loaded again if the texture is evicted
+    this->setSource(OGL_TEXTURE_SOURCE_IMAGE, texFiles, type, internalFormat);
+}
+
+void OGL_Texture::setTextureAsync(const char* texFile, GLenum internalFormat)
+{
+    //pass to the function for multiple files
+    this->setTextureAsync(std::vector<const char*>{texFile}, OGL_TEXTURE_2D, internalFormat);
+}
+
+void OGL_Texture::setTextureAsync(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //check if the amount of files is correct
+    checkFileCount(texFiles.size(), type);
+    //the new load replaces a pending one
+    this->abandonJob();
+    //create the job
+    this->job = new OGL_TextureDecodeJob;
+    this->job->files.assign(texFiles.begin(), texFiles.end());
+    this->job->images.resize(texFiles.size());
+    this->job->type = type;
+    this->job->internalFormat = internalFormat;
+    this->job->premultiply = this->premultiply;
+    //the job is used by every decode task and the texture
+    this->job->references = texFiles.size() + 1;
+    //get the worker pool
+    OGL_WorkerPool* pool = this->instance->getWorkerPool();
+    //decode all files in parallel
+    for (size_t i = 0; i < texFiles.size(); ++i) {pool->push(decodeJobFile, this->job, i);}
+    //check every frame if the load finished
+    this->instance->addPending(this);
+    //the files can be loaded again if the texture is evicted
+    this->setSource(OGL_TEXTURE_SOURCE_IMAGE, texFiles, type, internalFormat);
+}
+
+bool OGL_Texture::isReady()
+{
+    //without a pending load, the texture is ready
+    if (!this->job) {return true;}
+    //the texture is the last user when all files are decoded
+    if (this->job->references.load() != 1) {return false;}
+    //store the job, the texture is not waiting for it anymore
+    OGL_TextureDecodeJob* done = this->job;
+    this->job = 0;
+    //check if all files where decoded
+    for (size_t i = 0; i < done->images.size(); ++i)
     {
-        //if not, print an error
-        std::__throw_runtime_error((std::string("Failed to open file ") + texFile).c_str());
+        //skip files that could be decoded
+        if (done->images[i].pixels) {continue;}
+        //store the error, this runs while a window is flipped so it is not thrown. The texture keeps it's old data
+        this->loadError = std::string("Failed to open file ") + done->files[i];
+        //free the job
+        freeDecodeJob(done);
+        //the texture dose not have the data of the load
+        return false;
     }
+    //upload the images
+    this->uploadImages(done->images, done->type, done->internalFormat);
+    //free the job
+    freeDecodeJob(done);
+    //the texture is ready
+    return true;
+}
 
-    //store a formated surface
-    SDL_Surface* formated = SDL_CreateRGBSurface(0,surf->w,surf->h,32,0x000000FF,0x0000FF00,0x00FF0000,0xFF000000);
-    //blit the texture
-    SDL_BlitSurface(surf, 0, formated, 0);
+void OGL_Texture::waitReady()
+{
+    //wait until all files are decoded, the upload happens in the check
+    while (!this->isReady())
+    {
+        //a failed load never gets ready, so the error is given to the caller
+        if (this->hasLoadFailed()) {std::__throw_runtime_error(this->loadError.c_str());}
+        std::this_thread::yield();
+    }
+}
 
-    //store the width
-    this->width = surf->w;
-    //store the height
-    this->height = surf->h;
-    //set the amount of layers to 0
-    this->layers = 0;
-    //store the format as 2D texture
-    this->type = OGL_TEXTURE_2D;
-    //store the internal format
-    this->format = GL_TEXTURE_2D;
-    //bind to unit 0
-    this->bind(0);
-    //upload the texture data
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, surf->w,surf->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, formated->pixels);
-    //unbind the texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+bool OGL_Texture::onUpdate()
+{
+    //upload the data if it is decoded, a failed load is not pending anymore
+    return this->isReady() || this->hasLoadFailed();
+}
 
-    //free the surfaces
-    SDL_FreeSurface(surf);
-    SDL_FreeSurface(formated);
+void OGL_Texture::abandonJob()
+{
+    //a new load replaces the error of the old one
+    this->loadError.clear();
+    //check if a load is pending
+    if (!this->job) {return;}
+    //the texture stops using the job, if it was the last user, free it
+    if (--this->job->references == 0) {freeDecodeJob(this->job);}
+    //the texture has no pending load anymore
+    this->job = 0;
 }
 
-void OGL_Texture::setTexture(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat)
+void OGL_Texture::uploadImages(std::vector<OGL_PixelData>& images, OGL_TextureType type, GLenum internalFormat)
 {
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //store if the selected format stores gray images
+    bool gray = false;
+    //select the internal format if requested
+    if (internalFormat == OGL_TEXTURE_FORMAT_AUTO) {internalFormat = selectImageFormat(this->instance->getTextureFormatPolicy(), images, &gray);}
+    //store the internal format
+    this->internalFormat = internalFormat;
+    //store if direct state access is used
+    bool dsa = this->instance->usingDSA();
+    //store the size of the base level
+    this->width = images[0].width;
+    this->height = images[0].height;
     //switch over the type
     switch (type)
     {
     //check for the 2D texture
     case OGL_TEXTURE_2D:
-        //check if the amount of layers is correct
-        if (texFiles.size() != 1)
-        {
-            //throw an error
-            std::__throw_runtime_error("The amount of files is not correct to create a 2D texture");
-            return;
-        }
-        //else, pass to another function
-        this->setTexture(texFiles[0], internalFormat);
+        //set the amount of layers to 0
+        this->layers = 0;
+        //store the format as 2D texture
+        this->type = OGL_TEXTURE_2D;
+        //allocate the storage
+        this->allocateStorage(GL_TEXTURE_2D, this->mipLevels);
+        //set how the pixels are read
+        this->instance->setPixelUnpack(images[0].alignment, images[0].rowLength);
+        //upload the base level
+        if (dsa) {glTextureSubImage2D(this->texture, 0, 0, 0, this->width, this->height, images[0].format, images[0].type, images[0].pixels);}
+        else {glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, this->width, this->height, images[0].format, images[0].type, images[0].pixels);}
         break;
 
     case OGL_TEXTURE_CUBEMAP:
-        //check if the amount of layers is correct
-        if (texFiles.size() != 6)
-        {
-            //throw an error
-            std::__throw_runtime_error("The amount of files is not correct to create a cubemap texture");
-            return;
-        }
         //set the inetrnal format
         this->type = OGL_TEXTURE_CUBEMAP;
-        //set the format
-        this->format = GL_TEXTURE_CUBE_MAP;
         //set the amount of layers to 0
         this->layers = 0;
-        //bind the texture
-        this->bind(0);
+        //allocate the storage for all faces
+        this->allocateStorage(GL_TEXTURE_CUBE_MAP, this->mipLevels);
         //loop over all 6 sides
         for (int i = 0; i < 6; ++i)
         {
-            //add the face
-            addTextureCubemap(GL_TEXTURE_CUBE_MAP_POSITIVE_X+i, texFiles[i], &this->width, &this->height, internalFormat);
+            //set how the pixels of the face are read
+            this->instance->setPixelUnpack(images[i].alignment, images[i].rowLength);
+            //with direct state access, upload the face as a layer of the cubemap
+            if (dsa) {glTextureSubImage3D(this->texture, 0, 0, 0, i, this->width, this->height, 1, images[i].format, images[i].type, images[i].pixels);}
+            else {glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X+i, 0, 0, 0, this->width, this->height, images[i].format, images[i].type, images[i].pixels);}
         }
-        //unbind the texture
-        this->unbind(0);
         break;
     
     case OGL_TEXTURE_ARRAY_2D:
-        //no size-check needed, every size is good
         //store the internal format
         this->type = OGL_TEXTURE_ARRAY_2D;
-        //store the format
-        this->format = GL_TEXTURE_2D_ARRAY;
-        //bind the texture
-        this->bind(0);
+        //store the layers
+        this->layers = images.size();
+        //allocate the storage for all layers
+        this->allocateStorage(GL_TEXTURE_2D_ARRAY, this->mipLevels);
         //loop over all layers
-        for (size_t i = 0; i < texFiles.size(); ++i)
+        for (size_t i = 0; i < images.size(); ++i)
         {
-            //read the texture file
-            SDL_Surface* surf = IMG_Load(texFiles[i]);
-            //check if the surface could load
-            if (!surf)
-            {
-                //if not, print an error
-                std::__throw_runtime_error((std::string("Failed to open file ") + texFiles[i]).c_str());
-            }
-
-            //store a formated surface
-            SDL_Surface* formated = SDL_CreateRGBSurface(0,surf->w,surf->h,32,0x000000FF,0x0000FF00,0x00FF0000,0xFF000000);
-            //blit the texture
-            SDL_BlitSurface(surf, 0, formated, 0);
-
-            //check if this is the first image
-            if (i == 0)
-            {
-                //store the width
-                this->width = surf->w;
-                //store the height
-                this->height = surf->h;
-                //store the layers
-                this->layers = texFiles.size();
-                //prepare the storage
-                glTexStorage3D(this->format, 1, internalFormat, this->width, this->height, this->layers);
-            }
-
+            //set how the pixels of the layer are read
+            this->instance->setPixelUnpack(images[i].alignment, images[i].rowLength);
             //upload the texture data
-            glTexSubImage3D(this->format, 0, 0, 0, i, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, formated->pixels);
-
-            //free the surfaces
-            SDL_FreeSurface(surf);
-            SDL_FreeSurface(formated);
+            if (dsa) {glTextureSubImage3D(this->texture, 0, 0, 0, i, this->width, this->height, 1, images[i].format, images[i].type, images[i].pixels);}
+            else {glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, this->width, this->height, 1, images[i].format, images[i].type, images[i].pixels);}
         }
+        break;
 
     default:
         break;
     }
+    //fill the other mip levels from the uploaded base level
+    this->createMipmap();
+    //read gray formats as gray
+    this->applySwizzle(gray);
 }
 
 void OGL_Texture::setTexture(void* data, uint32_t width, uint32_t height, GLenum format, GLenum type, GLenum internalFormat)
 {
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //select the internal format if requested
+    if (internalFormat == OGL_TEXTURE_FORMAT_AUTO) {internalFormat = selectDataFormat(this->instance->getTextureFormatPolicy(), format, type);}
+    //store the internal format
+    this->internalFormat = internalFormat;
     //store the width
     this->width = width;
     //store the height
@@ -277,58 +813,539 @@ void OGL_Texture::setTexture(void* data, uint32_t width, uint32_t height, GLenum
     this->layers = 0;
     //store the type
     this->type = OGL_TEXTURE_2D;
-    //store the format
-    this->format = GL_TEXTURE_2D;
-    //bind to unit 0
-    this->bind(0);
-    //store the inputed user data
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, data);
+    //user data can't be loaded again, so the texture is never evicted
+    this->source = OGL_TextureSource();
+    //allocate the storage. Without data no mip levels are generated, so render targets get a single level instead of an unfilled mip chain
+    this->allocateStorage(GL_TEXTURE_2D, data ? this->mipLevels : 1);
+    //check if there is data to upload
+    if (data)
+    {
+        //user data is read with the default rules of OpenGL
+        this->instance->setPixelUnpack(4, 0);
+        //store the inputed user data
+        if (this->instance->usingDSA()) {glTextureSubImage2D(this->texture, 0, 0, 0, width, height, format, type, data);}
+        else {glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, data);}
+        //fill the other mip levels from the uploaded base level
+        this->createMipmap();
+    }
+    //the channels are read as they are
+    this->applySwizzle(false);
+}
+
+void OGL_Texture::setCompressedTexture(const char* file)
+{
+    //load and upload the image
+    this->setCompressedTexture(OGL_CompressedImage(file));
+    //the file can be loaded again if the texture is evicted
+    this->setSource(OGL_TEXTURE_SOURCE_COMPRESSED, std::vector<const char*>{file}, this->type, OGL_TEXTURE_FORMAT_AUTO);
+}
+
+void OGL_Texture::setCompressedTexture(const OGL_CompressedImage& image)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //the new data replaces a pending background load
+    this->abandonJob();
+    //check if the image has data
+    if (!image.getInternalFormat()) {std::__throw_runtime_error("Can't create a texture from an empty compressed image");}
+    //an image in memory can't be loaded again, so the texture is never evicted
+    this->source = OGL_TextureSource();
+    //cubemap arrays are not supported
+    if (image.getFaceCount() == 6 && image.getLayerCount() > 1) {std::__throw_runtime_error("Cubemap arrays are not supported");}
+    //store the size and format
+    this->width = image.getWidth();
+    this->height = image.getHeight();
+    this->internalFormat = image.getInternalFormat();
+    //store the amount of levels
+    GLsizei levels = image.getLevelCount();
+    //store if direct state access is used
+    bool dsa = this->instance->usingDSA();
+
+    //check for a cubemap
+    if (image.getFaceCount() == 6)
+    {
+        //store the type
+        this->type = OGL_TEXTURE_CUBEMAP;
+        this->layers = 0;
+        //allocate the storage for all faces
+        this->allocateStorage(GL_TEXTURE_CUBE_MAP, levels);
+        for (GLsizei i = 0; i < levels; ++i)
+        {
+            const OGL_CompressedLevel& level = image.getLevel(i);
+            //with direct state access, upload all faces of a level as layers
+            if (dsa) {glCompressedTextureSubImage3D(this->texture, i, 0, 0, 0, level.width, level.height, 6, this->internalFormat, level.size, image.getLevelData(i)); continue;}
+            //without direct state access, upload face by face
+            for (int face = 0; face < 6; ++face)
+            {
+                glCompressedTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X+face, i, 0, 0, level.width, level.height, this->internalFormat, level.size / 6, image.getLevelData(i) + face*(level.size / 6));
+            }
+        }
+    }
+    //check for an array
+    else if (image.getLayerCount() > 1)
+    {
+        //store the type
+        this->type = OGL_TEXTURE_ARRAY_2D;
+        this->layers = image.getLayerCount();
+        //allocate the storage for all layers
+        this->allocateStorage(GL_TEXTURE_2D_ARRAY, levels);
+        //upload all layers of a level at once
+        for (GLsizei i = 0; i < levels; ++i)
+        {
+            const OGL_CompressedLevel& level = image.getLevel(i);
+            if (dsa) {glCompressedTextureSubImage3D(this->texture, i, 0, 0, 0, level.width, level.height, this->layers, this->internalFormat, level.size, image.getLevelData(i));}
+            else {glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, 0, level.width, level.height, this->layers, this->internalFormat, level.size, image.getLevelData(i));}
+        }
+    }
+    //else, it is a 2D texture
+    else
+    {
+        //store the type
+        this->type = OGL_TEXTURE_2D;
+        this->layers = 0;
+        //allocate the storage
+        this->allocateStorage(GL_TEXTURE_2D, levels);
+        //upload all levels
+        for (GLsizei i = 0; i < levels; ++i)
+        {
+            const OGL_CompressedLevel& level = image.getLevel(i);
+            if (dsa) {glCompressedTextureSubImage2D(this->texture, i, 0, 0, level.width, level.height, this->internalFormat, level.size, image.getLevelData(i));}
+            else {glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, level.width, level.height, this->internalFormat, level.size, image.getLevelData(i));}
+        }
+    }
+
+    //the channels are read as they are
+    this->applySwizzle(false);
+}
+
+void OGL_Texture::compressTexture(const char* texFile, OGL_BlockFormat format, const char* cacheDir)
+{
+    //pass to the function for multiple files
+    this->compressTexture(std::vector<const char*>{texFile}, OGL_TEXTURE_2D, format, cacheDir);
+}
+
+void OGL_Texture::compressTexture(std::vector<const char*> texFiles, OGL_TextureType type, OGL_BlockFormat format, const char* cacheDir)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //check if the amount of files is correct
+    checkFileCount(texFiles.size(), type);
+    //store if sRGB formats should be used
+    bool srgb = this->instance->getTextureFormatPolicy().srgb;
+    //load the first file
+    OGL_CompressedImage image = loadCompressed(texFiles[0], format, srgb, this->premultiply, cacheDir);
+    //add all other files as layers
+    for (size_t i = 1; i < texFiles.size(); ++i) {image.addLayers(loadCompressed(texFiles[i], format, srgb, this->premultiply, cacheDir));}
+    //the 6 layers of a cubemap are its faces
+    if (type == OGL_TEXTURE_CUBEMAP) {image.makeCubemap();}
+    //upload the image
+    this->setCompressedTexture(image);
+    //the files can be loaded again from the cache if the texture is evicted
+    this->setSource(OGL_TEXTURE_SOURCE_COMPRESS, texFiles, type, OGL_TEXTURE_FORMAT_AUTO, format, cacheDir);
+}
+
+void OGL_Texture::prepareBind()
+{
+    //make sure to activate the instance
+    correctInstanceBinding()
+    //upload a pending background load if it is done
+    if (this->job) {this->isReady();}
+    //load the data again if the texture was evicted
+    bool reloaded = this->evicted;
+    if (reloaded) {this->reload();}
+    //say that the texture is used in this frame
+    this->instance->useTexture(this, reloaded);
+    //a sampler without an OpenGL object was moved from, binding it would use the parameters of the texture instead
+    if (this->sampler && !this->sampler->getSampler()) {std::__throw_runtime_error("The sampler of the texture has no OpenGL sampler, it was moved from");}
 }
 
 void OGL_Texture::bind(uint8_t unit)
+{
+    //get the texture ready for the draw
+    this->prepareBind();
+    //bind the texture to the requested unit
+    this->instance->bindTexture(unit, this->format, this->texture);
+    //bind the sampler with it, without a sampler the parameters of the texture are used
+    this->instance->bindSampler(unit, this->sampler ? this->sampler->getSampler() : 0);
+}
+
+void OGL_Texture::bindForEdit()
 {
     //make sure to activate the instance
     correctInstanceBinding()
-    //activate the requested unit
-    glActiveTexture(GL_TEXTURE0 + unit);
-    //bind the texture
-    glBindTexture(this->format, this->texture);
+    //bind the texture to unit 0, the unit is active afterwards so the texture can be changed
+    this->instance->bindTexture(0, this->format, this->texture);
 }
 
 void OGL_Texture::unbind(uint8_t unit)
 {
     //make sure to activate the instance
     correctInstanceBinding()
-    //activate the requested unit
-    glActiveTexture(GL_TEXTURE0 + unit);
-    //unbind the texture
-    glBindTexture(this->format, 0);
+    //unbind the texture from the requested unit
+    this->instance->bindTexture(unit, this->format, 0);
+    //unbind the sampler of the texture
+    if (this->sampler) {this->instance->bindSampler(unit, 0);}
 }
 
 void OGL_Texture::setTexParameter(GLenum parameter, GLenum value)
+{
+    //store the parameter, so it is set again when the texture gets new storage
+    bool known = false;
+    for (std::pair<GLenum, GLenum>& p : this->texParameters) {if (p.first == parameter) {p.second = value; known = true; break;}}
+    if (!known) {this->texParameters.push_back(std::pair<GLenum, GLenum>(parameter, value));}
+    //set the parameter on the current texture
+    this->applyTexParameter(parameter, value);
+}
+
+void OGL_Texture::applyTexParameter(GLenum parameter, GLenum value)
 {
     //make sure to activate the instance
     correctInstanceBinding()
-    //bind to unit 0
-    this->bind(0);
+    //check if direct state access is used
+    if (this->instance->usingDSA())
+    {
+        //set the texture parameter without binding the texture
+        glTextureParameteri(this->texture, parameter, value);
+        return;
+    }
+    //bind to unit 0 for the change
+    this->bindForEdit();
     //set the texture parameter
     glTexParameteri(this->format, parameter, value);
 }
 
+void OGL_Texture::applySwizzle(bool gray)
+{
+    //skip the calls if the texture is and stays unswizzled
+    if (!this->graySwizzle && !gray) {return;}
+    this->graySwizzle = gray;
+    //one channel formats have no alpha, two channel formats store it in green
+    bool alpha = (this->internalFormat == GL_RG8);
+    //read red as the color. The swizzle follows the uploaded data, so it is not stored with the parameters of the user
+    this->applyTexParameter(GL_TEXTURE_SWIZZLE_R, GL_RED);
+    this->applyTexParameter(GL_TEXTURE_SWIZZLE_G, gray ? GL_RED : GL_GREEN);
+    this->applyTexParameter(GL_TEXTURE_SWIZZLE_B, gray ? GL_RED : GL_BLUE);
+    this->applyTexParameter(GL_TEXTURE_SWIZZLE_A, gray ? (alpha ? GL_GREEN : GL_ONE) : GL_ALPHA);
+}
+
+void OGL_Texture::setStorage(OGL_TextureType type, uint32_t width, uint32_t height, uint32_t layers, GLenum internalFormat, GLenum format, uint32_t mipLevels)
+{
+    //select the internal format if requested
+    if (internalFormat == OGL_TEXTURE_FORMAT_AUTO) {internalFormat = selectTargetFormat(this->instance->getTextureFormatPolicy(), format);}
+    //store the internal format
+    this->internalFormat = internalFormat;
+    //store the type
+    this->type = type;
+    //store the width
+    this->width = width;
+    //store the height
+    this->height = height;
+    //store the amount of mip levels, later uploads keep it
+    this->mipLevels = mipLevels;
+
+    //switch over the type
+    switch (type)
+    {
+    case OGL_TEXTURE_2D:
+        //2D textures have no layers
+        this->layers = 0;
+        //allocate the storage
+        this->allocateStorage(GL_TEXTURE_2D, mipLevels);
+        break;
+
+    case OGL_TEXTURE_CUBEMAP:
+        //set the layers to 6
+        this->layers = 6;
+        //allocate all 6 faces at once
+        this->allocateStorage(GL_TEXTURE_CUBE_MAP, mipLevels);
+        break;
+
+    case OGL_TEXTURE_ARRAY_2D:
+        //store the layers
+        this->layers = layers;
+        //allocate all layers at once
+        this->allocateStorage(GL_TEXTURE_2D_ARRAY, mipLevels);
+        break;
+
+    case OGL_TEXTURE_2D_MULTISAMPLE:
+        //multisample textures have no layers, the layers are the amount of samples
+        this->layers = 0;
+        this->samples = (layers > 1) ? layers : 1;
+        //allocate the samples, multisample textures have a single level
+        this->allocateStorage(GL_TEXTURE_2D_MULTISAMPLE, 1);
+        break;
+    
+    default:
+        break;
+    }
+}
+
+size_t OGL_Texture::getTexelCount()
+{
+    //cubemaps have 6 faces, arrays have a face per layer
+    size_t faces = 1;
+    if (this->type == OGL_TEXTURE_CUBEMAP) {faces = 6;}
+    else if (this->type == OGL_TEXTURE_ARRAY_2D && this->layers > 0) {faces = this->layers;}
+    //sum up the texels of all levels
+    size_t texels = 0;
+    for (uint32_t i = 0; i < this->levels; ++i)
+    {
+        //each level halves the size, but is at least 1 texel wide and high
+        size_t width = (this->width >> i) ? (this->width >> i) : 1;
+        size_t height = (this->height >> i) ? (this->height >> i) : 1;
+        texels += width * height;
+    }
+    //return the amount of texels, each sample of multisample textures is stored on its own
+    return texels * faces * this->samples;
+}
+
+size_t OGL_Texture::getMemorySize()
+{
+    //without storage, no memory is used
+    if (!this->internalFormat || !this->levels) {return 0;}
+    //check for a compressed format
+    if (oglGetCompressedImageSize(this->internalFormat, this->width, this->height))
+    {
+        //cubemaps have 6 faces, arrays have a face per layer
+        size_t faces = 1;
+        if (this->type == OGL_TEXTURE_CUBEMAP) {faces = 6;}
+        else if (this->type == OGL_TEXTURE_ARRAY_2D && this->layers > 0) {faces = this->layers;}
+        //compressed formats store blocks of texels, so the size of each level is calculated on its own
+        size_t size = 0;
+        for (uint32_t i = 0; i < this->levels; ++i)
+        {
+            uint32_t width = (this->width >> i) ? (this->width >> i) : 1;
+            uint32_t height = (this->height >> i) ? (this->height >> i) : 1;
+            size += oglGetCompressedImageSize(this->internalFormat, width, height);
+        }
+        return size * faces;
+    }
+    //return the size of all levels
+    return this->getTexelCount() * oglGetTexelSize(this->internalFormat);
+}
+
+size_t OGL_Texture::getSavedMemory()
+{
+    //without storage, nothing is saved
+    if (!this->internalFormat) {return 0;}
+    //store the size with the old default format
+    size_t old = this->getTexelCount() * oglGetTexelSize(GL_RGBA32F);
+    //store the size now
+    size_t now = this->getMemorySize();
+    //return the difference, a bigger format saves nothing
+    return (old > now) ? old - now : 0;
+}
+
 void OGL_Texture::createMipmap()
 {
     //make sure to activate the instance
     correctInstanceBinding()
-    //bind to unit 0
-    this->bind(0);
+    //a single level has nothing to fill
+    if (this->levels < 2) {return;}
+    //check if direct state access is used
+    if (this->instance->usingDSA())
+    {
+        //create the mip chain without binding the texture
+        glGenerateTextureMipmap(this->texture);
+        return;
+    }
+    //bind to unit 0 for the change
+    this->bindForEdit();
     //create the mip chain
     glGenerateMipmap(this->format);
 }
 
+void OGL_Texture::prepareTexture(GLenum target)
+{
+    //make sure to activate the instance
+    correctInstanceBinding()
+    //check if an old texture exists
+    if (this->texture != 0)
+    {
+        //remove the texture from the state cache
+        this->instance->forgetTexture(this->texture);
+        //delete the old texture
+        glDeleteTextures(1, &this->texture);
+    }
+    //create a new texture
+    this->texture = this->instance->createTexture(target);
+    //a new texture is not swizzled
+    this->graySwizzle = false;
+    //store the target
+    this->format = target;
+    //a new texture has no storage
+    this->levels = 0;
+}
+
+void OGL_Texture::allocateStorage(GLenum target, uint32_t mipLevels)
+{
+    //create a new texture, immutable storage can't be re-allocated
+    this->prepareTexture(target);
+    //new storage has all its data
+    this->evicted = false;
+    //framebuffers must attach the new storage
+    this->storageGeneration = nextStorageGeneration++;
+    //store the amount of levels, clamped to a full mip chain
+    GLsizei full = getFullMipCount(this->width, this->height);
+    GLsizei levels = (mipLevels == OGL_TEXTURE_MIPS_FULL || mipLevels > (uint32_t)full) ? full : (GLsizei)mipLevels;
+    this->levels = levels;
+    //check for a multisample texture
+    if (target == GL_TEXTURE_2D_MULTISAMPLE)
+    {
+        //multisample textures have a single level
+        this->levels = 1;
+        //allocate the samples with fixed sample locations, so the texture can be mixed with multisample renderbuffers
+        if (this->instance->usingDSA()) {glTextureStorage2DMultisample(this->texture, this->samples, this->internalFormat, this->width, this->height, GL_TRUE);}
+        else
+        {
+            //bind to unit 0 for the change
+            this->bindForEdit();
+            //allocate the storage for the bound texture
+            glTexStorage2DMultisample(target, this->samples, this->internalFormat, this->width, this->height, GL_TRUE);
+        }
+        //count the storage for the texture memory budget
+        this->instance->trackTexture(this, this->getMemorySize());
+        //the new texture has the default parameters, so set the stored ones again
+        this->replayTexParameters();
+        return;
+    }
+    //all other textures have a single sample
+    this->samples = 1;
+    //check if direct state access is used
+    if (this->instance->usingDSA())
+    {
+        //allocate the storage without binding the texture. Cubemaps allocate all faces with 2D storage
+        if (target == GL_TEXTURE_2D_ARRAY) {glTextureStorage3D(this->texture, levels, this->internalFormat, this->width, this->height, this->layers);}
+        else {glTextureStorage2D(this->texture, levels, this->internalFormat, this->width, this->height);}
+    }
+    else
+    {
+        //bind to unit 0 for the change
+        this->bindForEdit();
+        //allocate the storage for the bound texture
+        if (target == GL_TEXTURE_2D_ARRAY) {glTexStorage3D(target, levels, this->internalFormat, this->width, this->height, this->layers);}
+        else {glTexStorage2D(target, levels, this->internalFormat, this->width, this->height);}
+    }
+    //count the storage for the texture memory budget, this may evict other textures
+    this->instance->trackTexture(this, this->getMemorySize());
+    //evicting an other texture may have bound it to unit 0, but the callers upload to the bound texture without direct state access
+    if (!this->instance->usingDSA()) {this->bindForEdit();}
+    //the new texture has the default parameters, so set the stored ones again
+    this->replayTexParameters();
+}
+
+void OGL_Texture::replayTexParameters()
+{
+    //set all parameters that where set with setTexParameter
+    for (const std::pair<GLenum, GLenum>& p : this->texParameters) {this->applyTexParameter(p.first, p.second);}
+}
+
+size_t OGL_Texture::onEvict(bool mipsOnly)
+{
+    //make sure to bind the correct instance
+    correctInstanceBinding()
+    //textures without a source can't be loaded again, and pending loads are not interrupted
+    if (this->source.type == OGL_TEXTURE_SOURCE_NONE || this->job || !this->texture) {return 0;}
+    //store the size before the eviction
+    size_t size = this->getMemorySize();
+    //check if the whole storage should be freed
+    if (!mipsOnly)
+    {
+        //remove the texture from the state cache
+        this->instance->forgetTexture(this->texture);
+        //delete the texture, the target is kept so it can be bound again
+        glDeleteTextures(1, &this->texture);
+        this->texture = 0;
+        this->levels = 0;
+        //the texture must be loaded again
+        this->evicted = true;
+        //the texture uses no memory anymore
+        this->instance->trackTexture(this, 0);
+        return size;
+    }
+    //dropping a mip level needs a second level and copies between textures (OpenGL 4.3 or newer)
+    if (this->levels < 2 || !(GLEW_VERSION_4_3 || GLEW_ARB_copy_image)) {return 0;}
+    //store the old texture, so the smaller levels can be copied from it
+    GLuint old = this->texture;
+    //faces of cubemaps and layers of arrays are copied as the depth
+    GLsizei depth = (this->format == GL_TEXTURE_CUBE_MAP) ? 6 : ((this->format == GL_TEXTURE_2D_ARRAY) ? this->layers : 1);
+    //store if the texture was swizzled
+    bool gray = this->graySwizzle;
+    //the second level becomes the base level
+    this->width = (this->width > 1) ? this->width / 2 : 1;
+    this->height = (this->height > 1) ? this->height / 2 : 1;
+    //allocate storage with one level less. The old texture is kept until the copy is done
+    this->texture = 0;
+    this->allocateStorage(this->format, this->levels - 1);
+    //copy all remaining levels
+    for (uint32_t i = 0; i < this->levels; ++i)
+    {
+        GLsizei width = (this->width >> i) ? (this->width >> i) : 1;
+        GLsizei height = (this->height >> i) ? (this->height >> i) : 1;
+        glCopyImageSubData(old, this->format, i + 1, 0, 0, 0, this->texture, this->format, i, 0, 0, 0, width, height, depth);
+    }
+    //keep reading gray formats as gray
+    this->applySwizzle(gray);
+    //delete the old texture
+    this->instance->forgetTexture(old);
+    glDeleteTextures(1, &old);
+    //the full resolution is loaded again when the texture is bound
+    this->evicted = true;
+    //return the freed memory
+    return size - this->getMemorySize();
+}
+
+void OGL_Texture::reload()
+{
+    //the texture is loaded now
+    this->evicted = false;
+    //copy the source, because the setters store it again
+    OGL_TextureSource source = this->source;
+    std::vector<const char*> files;
+    for (const std::string& file : source.files) {files.push_back(file.c_str());}
+    //switch over the type of the source
+    switch (source.type)
+    {
+    case OGL_TEXTURE_SOURCE_IMAGE:
+        //if the smaller mip levels are still there, use them while the files are decoded in the background
+        if (this->texture) {this->setTextureAsync(files, source.textureType, source.internalFormat);}
+        else {this->setTexture(files, source.textureType, source.internalFormat);}
+        break;
+
+    case OGL_TEXTURE_SOURCE_COMPRESSED:
+        //load the compressed file again
+        this->setCompressedTexture(files[0]);
+        break;
+
+    case OGL_TEXTURE_SOURCE_COMPRESS:
+        //load the compressed images from the cache
+        this->compressTexture(files, source.textureType, source.blockFormat, source.cacheDir.empty() ? 0 : source.cacheDir.c_str());
+        break;
+    
+    default:
+        break;
+    }
+}
+
+void OGL_Texture::setSource(OGL_TextureSourceType type, const std::vector<const char*>& files, OGL_TextureType textureType, GLenum internalFormat, OGL_BlockFormat blockFormat, const char* cacheDir)
+{
+    //store the source
+    this->source.type = type;
+    this->source.files.assign(files.begin(), files.end());
+    this->source.textureType = textureType;
+    this->source.internalFormat = internalFormat;
+    this->source.blockFormat = blockFormat;
+    this->source.cacheDir = cacheDir ? cacheDir : "";
+}
+
 void OGL_Texture::onDestroy()
 {
     //make sure to bind the correct instance
     correctInstanceBinding()
+    //stop waiting for a pending background load
+    this->abandonJob();
+    //remove the texture from the state cache
+    this->instance->forgetTexture(this->texture);
     //delete the texture
     glDeleteTextures(1, &this->texture);
     //set the texture to 0
@@ -24,12 +24,14 @@
  */
 #define checkExistance(buffer, error) if (buffer == 0) { std::__throw_runtime_error(error); }
 
-OGL_UniformBuffer::OGL_UniformBuffer(void* data, size_t size)
+OGL_UniformBuffer::OGL_UniformBuffer(void* data, size_t size, GLenum usage)
 {
+    //store the usage hint
+    this->usage.setUsage(usage);
     //bind the correct instance
     correctInstanceBinding()
     //create the UBO
-    glGenBuffers(1, &this->ubo);
+    this->ubo = this->instance->createBuffer();
     //cast to a function
     this->updateData(data, size);
     //upload the data
@@ -48,6 +50,20 @@ void OGL_UniformBuffer::updateData(void* data, size_t size)
         //copy the data
         memcpy(this->data.data(), data, size);
     }
+    //all data must be uploaded
+    this->dirty.markAll();
+    //the data is on the CPU again
+    this->gpuOnly = false;
+}
+
+void OGL_UniformBuffer::updateData(std::vector<uint8_t>&& data)
+{
+    //take the data
+    this->data = std::move(data);
+    //all data must be uploaded
+    this->dirty.markAll();
+    //the data is on the CPU again
+    this->gpuOnly = false;
 }
 
 void OGL_UniformBuffer::upload()
@@ -56,12 +72,150 @@ void OGL_UniformBuffer::upload()
     correctInstanceBinding()
     //check if the buffer exists
     checkExistance(this->ubo, "Can't upload an unitalised buffer")
-    //bind the buffer
-    glBindBuffer(GL_UNIFORM_BUFFER, this->ubo);
+    //the data must be on the CPU
+    if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+    //check if the buffer is not streamed
+    if (!this->streaming)
+    {
+        //count the upload, if the usage hint changed the storage is re-allocated with the new hint
+        if (this->usage.recordUpload(this->instance->getFrame())) {this->gpuSize = 0;}
+        //check if the data fits into the storage on the GPU
+        if (this->data.size() <= this->gpuSize && this->gpuSize != 0)
+        {
+            //only upload the modified bytes
+            this->dirty.flush(this->instance, GL_UNIFORM_BUFFER, this->ubo, this->data.data(), this->data.size());
+            return;
+        }
+        //upload the data
+        this->instance->bufferData(GL_UNIFORM_BUFFER, this->ubo, this->data.size(), this->data.data(), this->usage.getUsage());
+        this->usage.recordReallocation();
+        //store the new size of the storage
+        this->gpuSize = this->data.size();
+        //the GPU has all data now
+        this->dirty.clear();
+        return;
+    }
+    //every upload gets the whole data, so the modified ranges are not needed
+    this->dirty.clear();
+
+    //get the alignment for the uploads
+    size_t align = (size_t)this->instance->getUniformBufferOffsetAlignment();
+    //round the size of the upload up to the alignment, an upload is never empty
+    size_t slice = ((this->data.size() + align - 1) / align) * align;
+    if (slice == 0) {slice = align;}
+    //get the frame of the instance
+    uint64_t frame = this->instance->getFrame();
+    //check if the data dose not fit into a frame region
+    if (slice > this->frameSize)
+    {
+        //re-allocate the ring with at least the double size, so growing data dose not re-allocate every frame
+        this->createRing((slice > this->frameSize*2) ? slice : this->frameSize*2);
+    }
+    //a new frame starts in the next region, the first upload after creating the ring uses the first region
+    else if (this->regionUsed != 0 && this->ringFrame != frame)
+    {
+        //the GPU is done with the current region when all commands issued until now are done
+        this->fences[this->currentFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        //go to the next region
+        this->currentFrame = (this->currentFrame + 1) % this->frameCount;
+        this->regionUsed = 0;
+        //delete the ring the buffer grew out of if the GPU is done with it
+        this->freeRetiredRing(false);
+        //check if the GPU may still read from the next region
+        GLsync& fence = this->fences[this->currentFrame];
+        if (fence)
+        {
+            //check if the GPU is allready done without waiting
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            //else, wait for the GPU. This only happens if the CPU is more frames ahead than the ring is deep
+            while (result == GL_TIMEOUT_EXPIRED) {result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);}
+            //the fence is not needed anymore
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+    //earlier draws of this frame may still read the older uploads, so they are not overwritten. If the region is full, the ring grows
+    if (this->regionUsed + slice > this->frameSize) {this->createRing(this->frameSize*2);}
+    //the region belongs to this frame
+    this->ringFrame = frame;
+    //place the data behind the uploads of this frame
+    this->sliceOffset = this->currentFrame*this->frameSize + this->regionUsed;
+    this->sliceSize = slice;
+    this->regionUsed += slice;
+    //write the data to the mapped memory, the mapping is coherent so no flush is needed
+    if (!this->data.empty()) {memcpy(this->mapped + this->sliceOffset, this->data.data(), this->data.size());}
+
+    //move all units the buffer is still bound to to the new region
+    for (uint8_t unit = 0; unit < 64; ++unit)
+    {
+        //skip units the buffer was not bound to
+        if (!(this->boundUnits & ((uint64_t)1 << unit))) {continue;}
+        //check if an other buffer was bound to the unit since then
+        if (this->instance->getBoundBufferBase(GL_UNIFORM_BUFFER, unit) != this->ubo)
+        {
+            //then the unit is not owned by this buffer anymore
+            this->boundUnits &= ~((uint64_t)1 << unit);
+            continue;
+        }
+        //bind the new data
+        this->instance->bindBufferRange(GL_UNIFORM_BUFFER, unit, this->ubo, this->sliceOffset, this->sliceSize);
+    }
+}
+
+bool OGL_UniformBuffer::enableStreaming(size_t capacity, uint8_t frames)
+{
+    //bind the correct instance
+    correctInstanceBinding()
+    //without immutable storage, the buffer can't be persistently mapped
+    if (!this->instance->supportsBufferStorage()) {return false;}
+    //clamp the amount of frames
+    if (frames < 2) {frames = 2;}
+    if (frames > OGL_UNIFORM_BUFFER_MAX_FRAMES) {frames = OGL_UNIFORM_BUFFER_MAX_FRAMES;}
+    //store the amount of frames
+    this->frameCount = frames;
+    //the buffer is now streamed
+    this->streaming = true;
+    //create the ring, big enough for the current data
+    this->createRing((capacity > this->data.size()) ? capacity : this->data.size());
+    //write the current data to the ring
+    if (!this->data.empty()) {this->upload();}
+    //the buffer is streamed now
+    return true;
+}
+
+void OGL_UniformBuffer::releaseCPUData()
+{
+    //the ring of the streaming mode is written from the CPU data
+    if (this->streaming) {std::__throw_runtime_error("A streaming uniform buffer needs its CPU data");}
+    //upload the changes
+    this->upload();
+    //free the data
+    this->data.clear();
+    this->data.shrink_to_fit();
+    //the buffer is now only on the GPU
+    this->gpuOnly = true;
+}
+
+void OGL_UniformBuffer::uploadGPUOnly(const void* data, size_t size)
+{
+    //correct the instance
+    correctInstanceBinding()
+    //the ring of the streaming mode is written from the CPU data
+    if (this->streaming) {std::__throw_runtime_error("A streaming uniform buffer needs its CPU data");}
+    //create the buffer if it dose not exist
+    if (this->ubo == 0) {this->ubo = this->instance->createBuffer();}
+    //free the data on the CPU
+    this->data.clear();
+    this->data.shrink_to_fit();
+    this->dirty.clear();
+    //count the upload
+    this->usage.recordUpload(this->instance->getFrame());
     //upload the data
-    glBufferData(GL_UNIFORM_BUFFER, this->data.size(), this->data.data(), GL_DYNAMIC_READ);
-    //unbind the buffer
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    this->gpuSize = size;
+    this->instance->bufferData(GL_UNIFORM_BUFFER, this->ubo, size, data, this->usage.getUsage());
+    this->usage.recordReallocation();
+    //the buffer is now only on the GPU
+    this->gpuOnly = true;
 }
 
 void OGL_UniformBuffer::bind(uint8_t unit)
@@ -70,16 +224,131 @@ void OGL_UniformBuffer::bind(uint8_t unit)
     correctInstanceBinding()
     //check if the buffer exists
     checkExistance(this->ubo, "Can't bind an unitalised buffer")
-    //simply bind the buffer
-    glBindBufferBase(GL_UNIFORM_BUFFER, unit, this->ubo);
+    //remember the unit, so it follows the current region in streaming mode
+    if (unit < 64) {this->boundUnits |= ((uint64_t)1 << unit);}
+    //check if the buffer is not streamed
+    if (!this->streaming)
+    {
+        //simply bind the buffer
+        this->instance->bindBufferBase(GL_UNIFORM_BUFFER, unit, this->ubo);
+        return;
+    }
+    //bind the data of the last upload
+    this->instance->bindBufferRange(GL_UNIFORM_BUFFER, unit, this->ubo, this->sliceOffset, this->sliceSize);
+}
+
+void OGL_UniformBuffer::bindRange(uint8_t unit, GLintptr offset, GLsizeiptr size)
+{
+    //bind the correct instance
+    correctInstanceBinding()
+    //check if the buffer exists
+    checkExistance(this->ubo, "Can't bind an unitalised buffer")
+    //in streaming mode, the offset is in the data of the last upload
+    if (this->streaming) {offset += this->sliceOffset;}
+    //bind the range
+    this->instance->bindBufferRange(GL_UNIFORM_BUFFER, unit, this->ubo, offset, size);
 }
 
 void OGL_UniformBuffer::unbind()
 {   
     //bind the correct instance
     correctInstanceBinding()
+    //the units should not follow the current region anymore
+    this->boundUnits = 0;
     //unbind all buffers
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    this->instance->bindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void OGL_UniformBuffer::createRing(size_t capacity)
+{
+    //release the old ring
+    this->releaseRing();
+    //check if a buffer exists
+    if (this->ubo != 0)
+    {
+        //only keep the units the old buffer is still bound to
+        for (uint8_t unit = 0; unit < 64; ++unit)
+        {
+            //drop the unit if an other buffer was bound to it
+            if (this->instance->getBoundBufferBase(GL_UNIFORM_BUFFER, unit) != this->ubo) {this->boundUnits &= ~((uint64_t)1 << unit);}
+        }
+        //immutable storage can't be re-allocated, so a new buffer is created. Draws of this frame may still read from the old one, so it is kept until the GPU is done with it
+        this->instance->forgetBuffer(this->ubo);
+        this->retireRing();
+    }
+    //create the new buffer
+    this->ubo = this->instance->createBuffer();
+    //get the alignment for the regions
+    size_t align = (size_t)this->instance->getUniformBufferOffsetAlignment();
+    //round the size of a region up to the alignment, a region is never empty
+    this->frameSize = ((capacity + align - 1) / align) * align;
+    if (this->frameSize == 0) {this->frameSize = align;}
+    //store the flags for the persistent mapping
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    //allocate the storage for all regions
+    this->instance->bufferStorage(GL_UNIFORM_BUFFER, this->ubo, this->frameSize*this->frameCount, 0, flags);
+    //map the whole buffer once
+    this->mapped = (uint8_t*)this->instance->mapBufferRange(GL_UNIFORM_BUFFER, this->ubo, 0, this->frameSize*this->frameCount, flags);
+    //check if the mapping worked
+    if (!this->mapped) {std::__throw_runtime_error("Failed to map the storage of a streaming uniform buffer");}
+    //start at the first region, it is still empty
+    this->currentFrame = 0;
+    this->regionUsed = 0;
+    this->sliceOffset = 0;
+    this->sliceSize = this->frameSize;
+    //bind the new buffer to all units the old one was bound to
+    for (uint8_t unit = 0; unit < 64; ++unit)
+    {
+        //check if the unit is owned by this buffer
+        if (this->boundUnits & ((uint64_t)1 << unit)) {this->instance->bindBufferRange(GL_UNIFORM_BUFFER, unit, this->ubo, this->sliceOffset, this->sliceSize);}
+    }
+}
+
+void OGL_UniformBuffer::releaseRing()
+{
+    //delete all fences
+    for (uint8_t i = 0; i < OGL_UNIFORM_BUFFER_MAX_FRAMES; ++i)
+    {
+        //check if the fence exists
+        if (this->fences[i]) {glDeleteSync(this->fences[i]); this->fences[i] = 0;}
+    }
+    //unmap the buffer if it is mapped
+    if (this->mapped) {this->instance->unmapBuffer(GL_UNIFORM_BUFFER, this->ubo);}
+    //the memory is not valid anymore
+    this->mapped = 0;
+}
+
+void OGL_UniformBuffer::retireRing()
+{
+    //a ring that was retired before must be deleted first. This only waits if the ring grows again before the GPU finished the frame of the last growth
+    this->freeRetiredRing(true);
+    //the GPU is done with the old ring when all commands issued until now are done
+    this->retiredFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    //keep the old ring
+    this->retiredUbo = this->ubo;
+    this->ubo = 0;
+}
+
+void OGL_UniformBuffer::freeRetiredRing(bool wait)
+{
+    //check if a ring was retired
+    if (!this->retiredUbo) {return;}
+    //check if the GPU may still read from the old ring
+    if (this->retiredFence)
+    {
+        //check if the GPU is allready done without waiting
+        GLenum result = glClientWaitSync(this->retiredFence, 0, 0);
+        //if the ring is still in use, keep it until the next check
+        if (result == GL_TIMEOUT_EXPIRED && !wait) {return;}
+        //else, wait for the GPU
+        while (result == GL_TIMEOUT_EXPIRED) {result = glClientWaitSync(this->retiredFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);}
+        //the fence is not needed anymore
+        glDeleteSync(this->retiredFence);
+        this->retiredFence = 0;
+    }
+    //delete the old ring
+    glDeleteBuffers(1, &this->retiredUbo);
+    this->retiredUbo = 0;
 }
 
 void OGL_UniformBuffer::onDestroy()
@@ -89,6 +358,11 @@ void OGL_UniformBuffer::onDestroy()
     {
         //bind the correct instance
         correctInstanceBinding()
+        //release the ring of the streaming mode and the ring it grew out of
+        this->releaseRing();
+        this->freeRetiredRing(true);
+        //remove the buffer from the state cache
+        this->instance->forgetBuffer(this->ubo);
         //delete the object
         glDeleteBuffers(1, &this->ubo);
     }
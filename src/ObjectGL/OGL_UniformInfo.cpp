@@ -0,0 +1,228 @@
+/**
+ * @file OGL_UniformInfo.cpp
+ * @author DM8AT
+ * @brief implement the upload of uniform values to shader programs
+ * @version 0.1
+ * @date 2024-09-14
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+void OGL_UniformInfo::upload(GLuint program, bool useDSA)
+{
+    //check if the upload function was selected from the type
+    if (this->uploader)
+    {
+        //all elements must fit into the storage of the info, else the upload would read past it
+        if ((size_t)this->count * this->components * this->columns * 4 > sizeof(this->data))
+        {
+            std::__throw_runtime_error(("The uniform " + this->name + " is bigger than 64 bytes, wich is the maximum size of a uniform. Use a uniform buffer or a shader storage buffer for it").c_str());
+        }
+        //upload the value, arrays are uploaded with a single call
+        (*this->uploader)(program, this->location, this->count, this->data, useDSA);
+        return;
+    }
+    //switch over the type
+    switch (this->type)
+    {
+    case OGL_TYPE_FLOAT:
+        //set the float
+        if (useDSA) {glProgramUniform1fv(program, this->location, 1, (float*)((void*)this->data));}
+        else {glUniform1fv(this->location, 1, (float*)((void*)this->data));}
+        break;
+    
+    case OGL_TYPE_INT:
+        //set the int
+        if (useDSA) {glProgramUniform1iv(program, this->location, 1, (int*)((void*)this->data));}
+        else {glUniform1iv(this->location, 1, (int*)((void*)this->data));}
+        break;
+
+    case OGL_TYPE_UINT:
+        //set the unsigned int
+        if (useDSA) {glProgramUniform1uiv(program, this->location, 1, (unsigned int*)((void*)this->data));}
+        else {glUniform1uiv(this->location, 1, (unsigned int*)((void*)this->data));}
+        break;
+
+    default:
+        //throw an error
+        std::__throw_runtime_error("The requested type is not a valid type for an uniform");
+        break;
+    }
+}
+
+bool OGL_UniformInfo::uploadIfChanged(GLuint program, bool useDSA)
+{
+    //if the value was not touched since the last upload, nothing needs to be done
+    if (!this->dirty) {return false;}
+    //the value will be in sync after this function
+    this->dirty = false;
+    //check if the program allready has the value
+    if (this->gpuProgram == program && this->gpuLocation == this->location && memcmp(this->gpuData, this->data, sizeof(this->data)) == 0) {return false;}
+    //upload the value
+    this->upload(program, useDSA);
+    //remember what the program has on the GPU
+    memcpy(this->gpuData, this->data, sizeof(this->data));
+    this->gpuProgram = program;
+    this->gpuLocation = this->location;
+    //return that the value was uploaded
+    return true;
+}
+
+/**
+ * @brief set the layout of a uniform info from an OpenGL type
+ * 
+ * @param info the uniform info to set the layout for
+ * @param type the OpenGL type of the uniform, like GL_FLOAT_VEC3
+ * @return true : the type is supported | 
+ * @return false : the type is not supported, the info was not changed
+ */
+static bool setTypeFromGL(OGL_UniformInfo& info, GLenum type)
+{
+    //switch over all supported types
+    switch (type)
+    {
+    case GL_FLOAT:              info.setType<float>(); return true;
+    case GL_FLOAT_VEC2:         info.setType<OGL_Vec2>(); return true;
+    case GL_FLOAT_VEC3:         info.setType<OGL_Vec3>(); return true;
+    case GL_FLOAT_VEC4:         info.setType<OGL_Vec4>(); return true;
+    case GL_INT:
+    case GL_BOOL:               info.setType<int32_t>(); return true;
+    case GL_INT_VEC2:
+    case GL_BOOL_VEC2:          info.setType<OGL_IVec2>(); return true;
+    case GL_INT_VEC3:
+    case GL_BOOL_VEC3:          info.setType<OGL_IVec3>(); return true;
+    case GL_INT_VEC4:
+    case GL_BOOL_VEC4:          info.setType<OGL_IVec4>(); return true;
+    case GL_UNSIGNED_INT:       info.setType<uint32_t>(); return true;
+    case GL_UNSIGNED_INT_VEC2:  info.setType<OGL_UVec2>(); return true;
+    case GL_UNSIGNED_INT_VEC3:  info.setType<OGL_UVec3>(); return true;
+    case GL_UNSIGNED_INT_VEC4:  info.setType<OGL_UVec4>(); return true;
+    case GL_FLOAT_MAT2:         info.setType<OGL_Mat2>(); return true;
+    case GL_FLOAT_MAT3:         info.setType<OGL_Mat3>(); return true;
+    case GL_FLOAT_MAT4:         info.setType<OGL_Mat4>(); return true;
+    
+    default:
+        break;
+    }
+    //samplers and images are set with the index of a unit, so they are integers
+    GLint isOpaque = 0;
+    switch (type)
+    {
+    case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_1D_ARRAY: case GL_SAMPLER_2D_ARRAY:
+    case GL_SAMPLER_1D_ARRAY_SHADOW: case GL_SAMPLER_2D_ARRAY_SHADOW: case GL_SAMPLER_2D_MULTISAMPLE: case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+    case GL_SAMPLER_CUBE_SHADOW: case GL_SAMPLER_CUBE_MAP_ARRAY: case GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW: case GL_SAMPLER_BUFFER: case GL_SAMPLER_2D_RECT:
+    case GL_INT_SAMPLER_2D: case GL_INT_SAMPLER_3D: case GL_INT_SAMPLER_CUBE: case GL_INT_SAMPLER_2D_ARRAY: case GL_INT_SAMPLER_2D_MULTISAMPLE:
+    case GL_UNSIGNED_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_3D: case GL_UNSIGNED_INT_SAMPLER_CUBE: case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY: case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+    case GL_IMAGE_2D: case GL_IMAGE_3D: case GL_IMAGE_CUBE: case GL_IMAGE_2D_ARRAY: case GL_IMAGE_BUFFER:
+    case GL_INT_IMAGE_2D: case GL_INT_IMAGE_3D: case GL_INT_IMAGE_2D_ARRAY:
+    case GL_UNSIGNED_INT_IMAGE_2D: case GL_UNSIGNED_INT_IMAGE_3D: case GL_UNSIGNED_INT_IMAGE_2D_ARRAY:
+        isOpaque = 1;
+        break;
+
+    default:
+        break;
+    }
+    //if the type is not opaque, it is not supported
+    if (!isOpaque) {return false;}
+    //store the unit index as an integer
+    info.setType<int32_t>();
+    return true;
+}
+
+/**
+ * @brief add a reflected uniform to a list of uniforms
+ * 
+ * @param uniforms the list to add the uniform to
+ * @param name the name of the uniform as reported by OpenGL
+ * @param type the OpenGL type of the uniform
+ * @param arraySize the amount of elements of the uniform
+ * @param location the location of the uniform
+ */
+static void addReflectedUniform(std::vector<OGL_UniformInfo>& uniforms, std::string name, GLenum type, GLint arraySize, GLint location)
+{
+    //uniforms without a location can't be set
+    if (location < 0) {return;}
+    //store the new uniform
+    OGL_UniformInfo info;
+    //set the layout, skip unsupported types
+    if (!setTypeFromGL(info, type)) {return;}
+    //arrays are reported as name[0], store them with the plain name
+    if (name.size() > 3 && name.compare(name.size()-3, 3, "[0]") == 0) {name.resize(name.size()-3);}
+    //store the name
+    info.name = name;
+    //store the location
+    info.location = location;
+    //store the amount of elements. Arrays bigger than the storage of the info are kept with they're real size, so setting them throws instead of cutting them off
+    info.count = (arraySize > 0) ? arraySize : 1;
+    //the program has no value set by the library, so nothing needs to be uploaded until the value is changed
+    info.dirty = false;
+    //add the uniform
+    uniforms.push_back(info);
+}
+
+std::vector<OGL_UniformInfo> oglReflectUniforms(GLuint program)
+{
+    //store the uniforms
+    std::vector<OGL_UniformInfo> uniforms;
+    //check if the program interface query is supported
+    if (GLEW_VERSION_4_3 || GLEW_ARB_program_interface_query)
+    {
+        //get the amount of active uniforms
+        GLint count = 0;
+        glGetProgramInterfaceiv(program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+        //get the length of the longest name
+        GLint maxNameLength = 0;
+        glGetProgramInterfaceiv(program, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+        //store the name buffer
+        std::string name(maxNameLength, '\0');
+        //store the properties to read
+        const GLenum props[4] = {GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX};
+        //loop over all uniforms
+        for (GLint i = 0; i < count; ++i)
+        {
+            //read the properties
+            GLint values[4] = {};
+            glGetProgramResourceiv(program, GL_UNIFORM, i, 4, props, 4, 0, values);
+            //skip uniforms inside of blocks, they are set with uniform buffers
+            if (values[3] != -1) {continue;}
+            //read the name
+            GLsizei length = 0;
+            glGetProgramResourceName(program, GL_UNIFORM, i, maxNameLength, &length, &name[0]);
+            //add the uniform
+            addReflectedUniform(uniforms, name.substr(0, length), values[0], values[1], values[2]);
+        }
+        //return the uniforms
+        return uniforms;
+    }
+
+    //else, use the old query
+    GLint count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    //get the length of the longest name
+    GLint maxNameLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    //store the name buffer
+    std::string name(maxNameLength, '\0');
+    //loop over all uniforms
+    for (GLint i = 0; i < count; ++i)
+    {
+        //read the uniform
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, maxNameLength, &length, &size, &type, &name[0]);
+        //store the name
+        std::string uName = name.substr(0, length);
+        //add the uniform, block members have no location and are skipped
+        addReflectedUniform(uniforms, uName, type, size, glGetUniformLocation(program, uName.c_str()));
+    }
+    //return the uniforms
+    return uniforms;
+}
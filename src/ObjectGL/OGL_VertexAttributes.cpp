@@ -48,10 +48,8 @@ void OGL_VertexAttributes::update()
     //bind the correct instance
     correctInstanceBinding()
 
-    //store if a VBO is bound
-    GLint VBO = 0;
     //get the bound VBO
-    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &VBO);
+    GLuint VBO = this->instance->getBoundBuffer(GL_ARRAY_BUFFER);
     //if no VBO is bound, throw an error
     if (VBO == 0)
     {
@@ -60,7 +58,7 @@ void OGL_VertexAttributes::update()
         return;
     }
     //bind the own VAO
-    glBindVertexArray(this->vao);
+    this->instance->bindVertexArray(this->vao);
 
     //store the offset
     size_t offset = 0;
@@ -118,11 +116,24 @@ OGL_VertexAttribute& OGL_VertexAttributes::operator[](size_t idx)
 
 void OGL_VertexAttributes::bind()
 {
+    //bind the correct instance
+    correctInstanceBinding()
     //bind the own vao
-    glBindVertexArray(this->vao);
+    this->instance->bindVertexArray(this->vao);
 }
 
 void OGL_VertexAttributes::onDestroy()
 {
-
+    //check if the VAO exists
+    if (this->vao != 0)
+    {
+        //bind the correct instance
+        correctInstanceBinding()
+        //remove the VAO from the state cache
+        this->instance->forgetVertexArray(this->vao);
+        //delete the VAO
+        glDeleteVertexArrays(1, &this->vao);
+        //set the VAO to 0
+        this->vao = 0;
+    }
 }
\ No newline at end of file
@@ -171,4 +171,8 @@ void OGL_Window::flip()
 {
     //flip the window
     SDL_GL_SwapWindow(this->window);
+    //the frame is finished
+    this->instance->nextFrame();
+    //finish pending work like background texture loads
+    this->instance->updatePending();
 }
\ No newline at end of file
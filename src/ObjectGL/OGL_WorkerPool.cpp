@@ -0,0 +1,73 @@
+/**
+ * @file OGL_WorkerPool.cpp
+ * @author DM8AT
+ * @brief implement a pool of background threads
+ * @version 0.1
+ * @date 2024-08-16
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+
+//ask for access to the background library
+#define OGL_KEEP_BG_ACCESS
+//include the main header
+#include "ObjectGL.hpp"
+
+OGL_WorkerPool::OGL_WorkerPool(uint32_t threads)
+{
+    //start all threads
+    for (uint32_t i = 0; i < threads; ++i) {this->threads.push_back(std::thread(&OGL_WorkerPool::work, this));}
+}
+
+OGL_WorkerPool::~OGL_WorkerPool()
+{
+    //tell the workers to stop
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    //wake up all workers
+    this->signal.notify_all();
+    //wait for all workers, they finish the queue first
+    for (std::thread& thread : this->threads) {thread.join();}
+}
+
+void OGL_WorkerPool::push(void (*func)(void* data, size_t index), void* data, size_t index)
+{
+    //without threads, run the task instantly
+    if (this->threads.empty())
+    {
+        (*func)(data, index);
+        return;
+    }
+    //add the task to the queue
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->tasks.push_back(OGL_WorkerTask{func, data, index});
+    }
+    //wake up a worker
+    this->signal.notify_one();
+}
+
+void OGL_WorkerPool::work()
+{
+    //run until the pool stops
+    while (true)
+    {
+        //store the next task
+        OGL_WorkerTask task;
+        {
+            //wait until a task is queued or the pool stops
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->signal.wait(lock, [this]() {return this->stop || !this->tasks.empty();});
+            //stop if the queue is empty, this only happens if the pool stops
+            if (this->tasks.empty()) {return;}
+            //take the oldest task
+            task = this->tasks.front();
+            this->tasks.pop_front();
+        }
+        //run the task
+        (*task.func)(task.data, task.index);
+    }
+}
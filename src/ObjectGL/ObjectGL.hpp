@@ -17,6 +17,13 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <array>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 //include SDL2
 #include <SDL2/SDL.h>
@@ -48,6 +55,63 @@ extern std::vector<OGL_Instance*> oglAllInstances;
 
 #endif
 
+/**
+ * @brief a binding value in the state cache that is not known and must always be re-issued
+ */
+#define OGL_STATE_UNKNOWN ((GLuint)-1)
+/**
+ * @brief the amount of generic buffer targets tracked by the state cache
+ */
+#define OGL_STATE_BUFFER_TARGET_COUNT 12
+/**
+ * @brief the amount of texture targets per texture unit tracked by the state cache
+ */
+#define OGL_STATE_TEXTURE_TARGET_COUNT 7
+/**
+ * @brief the maximum amount of frames a streaming uniform buffer can be ahead of the GPU
+ */
+#define OGL_UNIFORM_BUFFER_MAX_FRAMES 4
+/**
+ * @brief the default amount of bytes between two modified ranges of a buffer at wich they are merged into one upload
+ */
+#define OGL_DIRTY_RANGE_MERGE_DISTANCE 256
+/**
+ * @brief the maximum amount of modified ranges a buffer tracks before the whole modified area is uploaded as one range
+ */
+#define OGL_DIRTY_RANGE_MAX_COUNT 32
+/**
+ * @brief the default amount of frames over wich the adaptive usage policy of a buffer counts the uploads
+ */
+#define OGL_BUFFER_USAGE_WINDOW 60
+/**
+ * @brief the minimum amount of uploads per frame for the adaptive usage policy to select stream storage
+ */
+#define OGL_BUFFER_USAGE_STREAM_RATE 0.75f
+/**
+ * @brief the minimum amount of uploads per frame for the adaptive usage policy to select dynamic storage
+ */
+#define OGL_BUFFER_USAGE_DYNAMIC_RATE 0.05f
+/**
+ * @brief an internal format for textures that says that the format should be selected by the format policy of the instance
+ */
+#define OGL_TEXTURE_FORMAT_AUTO ((GLenum)0)
+/**
+ * @brief a mip level count for textures that says that the storage should hold a full mip chain down to 1x1
+ */
+#define OGL_TEXTURE_MIPS_FULL ((uint32_t)0)
+/**
+ * @brief the default directory textures that are block compressed on the CPU are cached in
+ */
+#define OGL_TEXTURE_CACHE_DIR ".oglcache"
+/**
+ * @brief the amount of pixels the sizes of pooled render targets are rounded up to, so small size changes don't need new storage
+ */
+#define OGL_RENDER_TARGET_GRANULARITY 128
+/**
+ * @brief the default amount of frames an unused pooled render target is kept before it is deleted
+ */
+#define OGL_RENDER_TARGET_LIFETIME 8
+
 /**
  * @brief handle all event inputs and pass them to they're correct locations
  */
@@ -59,6 +123,14 @@ class OGL_Instance;
 class OGL_Window;
 //say that a base class will exist
 class OGL_BindableBase;
+//say that a worker pool will exist
+class OGL_WorkerPool;
+//say that compressed images will exist
+class OGL_CompressedImage;
+//say that samplers will exist
+class OGL_Sampler;
+//say that frame graphs will exist
+class OGL_FrameGraph;
 
 /**
  * @brief get the currently active instance
@@ -132,7 +204,51 @@ enum OGL_TextureType {
     /**
      * @brief a cubemap texture
      */
-    OGL_TEXTURE_CUBEMAP
+    OGL_TEXTURE_CUBEMAP,
+    /**
+     * @brief a 2D texture that stores multiple samples per pixel. It has no mip levels and can only be read with texelFetch
+     */
+    OGL_TEXTURE_2D_MULTISAMPLE
+};
+
+/**
+ * @brief specify the block compression the CPU compressor encodes images to
+ */
+enum OGL_BlockFormat {
+    /**
+     * @brief BC1 (DXT1), 8 bytes per 4x4 block, no alpha
+     */
+    OGL_BLOCK_FORMAT_BC1,
+    /**
+     * @brief BC3 (DXT5), 16 bytes per 4x4 block with interpolated alpha
+     */
+    OGL_BLOCK_FORMAT_BC3,
+    /**
+     * @brief BC7, 16 bytes per 4x4 block with high quality color and alpha. Only mode 6 is encoded
+     */
+    OGL_BLOCK_FORMAT_BC7
+};
+
+/**
+ * @brief specify where the data of a texture came from, so it can be loaded again after it was evicted
+ */
+enum OGL_TextureSourceType {
+    /**
+     * @brief the data can't be loaded again, like user data and render targets. The texture is never evicted
+     */
+    OGL_TEXTURE_SOURCE_NONE,
+    /**
+     * @brief the data was loaded from image files
+     */
+    OGL_TEXTURE_SOURCE_IMAGE,
+    /**
+     * @brief the data was loaded from a pre-compressed KTX, KTX2 or DDS file
+     */
+    OGL_TEXTURE_SOURCE_COMPRESSED,
+    /**
+     * @brief the data was loaded from image files and compressed on the CPU. The disk cache makes loading it again cheap
+     */
+    OGL_TEXTURE_SOURCE_COMPRESS
 };
 
 /**
@@ -158,1559 +274,6643 @@ enum OGL_FramebufferAttachmentType {
 };
 
 /**
- * @brief store an OpenGL instance and handle its creation and destruction
+ * @brief specify what happens with the content of an attachment when a render pass begins
  */
-class OGL_Instance
-{
-public:
+enum OGL_LoadOp {
     /**
-     * @brief Construct a new ogl instance
-     * 
-     * @param version the version of OpenGL to use as a float
-     * @param profile the type of profile to use
+     * @brief keep the content the attachment has
      */
-    OGL_Instance(float version = 4.5, OGL_ProfileType profile = OGL_PROFILE_COMPATIBLE);
-
+    OGL_LOAD_OP_LOAD,
     /**
-     * @brief Destroy the ogl instance
+     * @brief clear the attachment to the clear value of the render pass
      */
-    ~OGL_Instance();
-
-//check if behind-the-scenes access is enabled
-#ifdef OGL_KEEP_BG_ACCESS
-
+    OGL_LOAD_OP_CLEAR,
     /**
-     * @brief register a window to the instance. this function is called in the window's constructor
-     * @warning this function is only usable behind the scenes
-     * 
-     * @param window a raw pointer to the window
+     * @brief the old content is not needed, so it is invalidated. The attachment has undefined content until it is written
      */
-    void registerWindow(OGL_Window* window);
+    OGL_LOAD_OP_DONT_CARE
+};
 
+/**
+ * @brief specify what happens with the content of an attachment when a render pass ends
+ */
+enum OGL_StoreOp {
     /**
-     * @brief remove a window from the instance. this function is called in the window's destructor, which is automaticaly called when an instance with bound windows is destroyed
-     * @warning this function is only usable behind the scens
-     * 
-     * @param window a raw pointer to the window
+     * @brief keep the rendered content, so it can be read later
      */
-    void removeWindow(OGL_Window* window);
-
+    OGL_STORE_OP_STORE,
     /**
-     * @brief remove a bindable from the instance. this function is called in the bindable's destructor, which is automaticaly called when an instance with bound windows is destroyed
-     * @warning this function is only usable behind the scens
-     * 
-     * @param bindable a raw pointer to the bindable
+     * @brief the content is not needed anymore, so it is invalidated. The driver may skip writing it to memory
      */
-    void registerBindable(OGL_BindableBase* bindable);
+    OGL_STORE_OP_DISCARD
+};
 
+/**
+ * @brief a vector of 2 floats, used for uniforms
+ */
+struct OGL_Vec2
+{
     /**
-     * @brief register a bindable to the instance. this function is called in the bindable's constructor
-     * @warning this function is only usable behind the scenes
-     * 
-     * @param bindable a raw pointer to the bindable
+     * @brief the x component
      */
-    void removeBindable(OGL_BindableBase* bindable);
-
+    float x = 0;
     /**
-     * @brief Get the OpenGL context of this context, or 0 if none exists
-     * 
-     * @return SDL_GLContext the OpenGL context
+     * @brief the y component
      */
-    inline SDL_GLContext getContext() {return this->context;}
+    float y = 0;
+};
 
+/**
+ * @brief a vector of 3 floats, used for uniforms
+ */
+struct OGL_Vec3
+{
     /**
-     * @brief handle an SDL event and pass it to the correct internal window
-     * 
-     * @param event the event to handle
-     * 
-     * @return true : the event was for a window registed to this instance
-     * @return false : the event was for another instance
+     * @brief the x component
      */
-    bool handleEvent(SDL_Event event);
-
-#endif
-
+    float x = 0;
     /**
-     * @brief make this the current instance
-     * @warning this won't bind the OpenGL-Context or any window, it will just set the internal current index to this
+     * @brief the y component
      */
-    void makeCurrent();
-
+    float y = 0;
     /**
-     * @brief check if this is the current instance
-     * 
-     * @return true : this is the current instance
-     * @return false : this is not the current instance
+     * @brief the z component
      */
-    bool isCurrent();
+    float z = 0;
+};
 
+/**
+ * @brief a vector of 4 floats, used for uniforms
+ */
+struct OGL_Vec4
+{
     /**
-     * @brief set the mode of VSync
-     * 
-     * @param useVSync say if VSync should be used
+     * @brief the x component
      */
-    void setVSync(bool useVSync);
-
+    float x = 0;
     /**
-     * @brief get if vsync is used
-     * 
-     * @return true : vsync is enabled | 
-     * @return false : vsync is disabled
+     * @brief the y component
      */
-    inline bool usingVSync() {return this->vsync;}
-
-private:
+    float y = 0;
     /**
-     * @brief store a vector of pointers to the windows
+     * @brief the z component
      */
-    std::vector<OGL_Window*> windows = {};
+    float z = 0;
     /**
-     * @brief store a vector of pointers to the bindables
+     * @brief the w component
      */
-    std::vector<OGL_BindableBase*> bindables = {};
+    float w = 0;
+};
+
+/**
+ * @brief a vector of 2 signed integers, used for uniforms
+ */
+struct OGL_IVec2
+{
     /**
-     * @brief store the OpenGL instance
+     * @brief the x component
      */
-    SDL_GLContext context = 0;
+    int32_t x = 0;
     /**
-     * @brief store if VSync is enabled
+     * @brief the y component
      */
-    bool vsync = false;
+    int32_t y = 0;
 };
 
 /**
- * @brief a base class which is used to handle the binding of the OpenGL classes to the instance. The binding is done automaticaly behind the scenes, as well as the removal. This is to ensure that all objects belong to the context and can't be used any more after the context is destroyed, to insure memory safty. 
+ * @brief a vector of 3 signed integers, used for uniforms
  */
-class OGL_BindableBase
+struct OGL_IVec3
 {
-public:
     /**
-     * @brief Constructor for a bindalbe base. This registers the object to the instance, if no instance exists it will throw a runtime error
+     * @brief the x component
      */
-    OGL_BindableBase(); 
-
+    int32_t x = 0;
     /**
-     * @brief Destructor for a bindable base. This will remove the object from the window. 
-     * 
+     * @brief the y component
      */
-    virtual ~OGL_BindableBase();
+    int32_t y = 0;
+    /**
+     * @brief the z component
+     */
+    int32_t z = 0;
+};
 
-protected:
+/**
+ * @brief a vector of 4 signed integers, used for uniforms
+ */
+struct OGL_IVec4
+{
     /**
-     * @brief this function should be used as the destructor of the child class to ensure memory safty and correct object destruction
+     * @brief the x component
      */
-    virtual void onDestroy() {};
+    int32_t x = 0;
     /**
-     * @brief store the instance the object is bound to
+     * @brief the y component
      */
-    OGL_Instance* instance = 0;
+    int32_t y = 0;
+    /**
+     * @brief the z component
+     */
+    int32_t z = 0;
+    /**
+     * @brief the w component
+     */
+    int32_t w = 0;
 };
 
 /**
- * @brief store a window which can render with OpenGL. The window dose not contain the context
+ * @brief a vector of 2 unsigned integers, used for uniforms
  */
-class OGL_Window
+struct OGL_UVec2
 {
-public:
     /**
-     * @brief Construct a new ogl window
+     * @brief the x component
      */
-    OGL_Window() = default;
-
+    uint32_t x = 0;
     /**
-     * @brief Construct a new ogl window
-     * 
-     * @param name the name of the window
-     * @param width the width of the winow in pixels, default is 1000
-     * @param height the height of the window in pixels, default is 1000
-     * @param x the x position of the window relative to the top left corner in pixels, default is 0
-     * @param y the y position of the window relative to the top left corner in pixels, default is 0
+     * @brief the y component
      */
-    OGL_Window(const char* name, uint32_t width = 1000, uint32_t height = 1000, uint32_t x = 0, uint32_t y = 0);
+    uint32_t y = 0;
+};
 
+/**
+ * @brief a vector of 3 unsigned integers, used for uniforms
+ */
+struct OGL_UVec3
+{
     /**
-     * @brief Destroy the ogl window
+     * @brief the x component
      */
-    ~OGL_Window();
-
+    uint32_t x = 0;
     /**
-     * @brief make this window with it's registerd instance the current window
+     * @brief the y component
      */
-    void makeCurrent();
-
-//check if behind-the-scenes access is enabled
-#ifdef OGL_KEEP_BG_ACCESS
-
+    uint32_t y = 0;
     /**
-     * @brief Get the SDL_Window pointer from the window
-     * 
-     * @return SDL_Window* a pointer to the SDL window
+     * @brief the z component
      */
-    inline SDL_Window* getWindow() {return this->window;}
+    uint32_t z = 0;
+};
 
+/**
+ * @brief a vector of 4 unsigned integers, used for uniforms
+ */
+struct OGL_UVec4
+{
     /**
-     * @brief handle an SDL event
-     * 
-     * @param event the event to handle
-     * 
-     * @return true : the event was for this window
-     * @return false : the event was for another window
+     * @brief the x component
      */
-    bool handleEvent(SDL_Event event);
-
-#endif
-
+    uint32_t x = 0;
     /**
-     * @brief get if the window should close
-     * 
-     * @return true : the window should close | 
-     * @return false : the window can stay open
+     * @brief the y component
      */
-    inline bool isClosingRequested() {return this->shouldClose;}
-
+    uint32_t y = 0;
     /**
-     * @brief Set the Clear Color for the window
-     * 
-     * @param r the red component of the clear color. Like OpenGL in range from 0.f to 1.f
-     * @param g the green component of the clear color. Like OpenGL in range from 0.f to 1.f
-     * @param b the blue component of the clear color. Like OpenGL in range from 0.f to 1.f
-     * @param a the alpha component of the clear color. Like OpenGL in range from 0.f to 1.f
+     * @brief the z component
      */
-    void setClearColor(float r, float g, float b, float a);
-
+    uint32_t z = 0;
     /**
-     * @brief Get the red component of the clear color
-     * 
-     * @return float the red component of the clear color
+     * @brief the w component
      */
-    inline float getClearR() {return this->clearR;}
+    uint32_t w = 0;
+};
 
+/**
+ * @brief a 2x2 matrix of floats, used for uniforms. The first index selects the column
+ */
+struct OGL_Mat2
+{
     /**
-     * @brief Get the green component of the clear color
-     * 
-     * @return float the green component of the clear color
+     * @brief the elements of the matrix
      */
-    inline float getClearG() {return this->clearG;}
+    float m[2][2] = {};
+};
 
+/**
+ * @brief a 3x3 matrix of floats, used for uniforms. The first index selects the column
+ */
+struct OGL_Mat3
+{
     /**
-     * @brief Get the blue component of the clear color
-     * 
-     * @return float the blue component of the clear color
+     * @brief the elements of the matrix
      */
-    inline float getClearB() {return this->clearB;}
+    float m[3][3] = {};
+};
+
+/**
+ * @brief a 4x4 matrix of floats, used for uniforms. The first index selects the column
+ */
+struct OGL_Mat4
+{
+    /**
+     * @brief the elements of the matrix
+     */
+    float m[4][4] = {};
+};
+
+/**
+ * @brief a typed handle to a uniform of a shader. It only stores the index of the uniform, so using it never touches the name of the uniform
+ * 
+ * @tparam T the type of the value of the uniform
+ */
+template<typename T> struct OGL_Uniform
+{
+    /**
+     * @brief store the index of the uniform in the shader, or -1 if the handle is invalid
+     */
+    size_t index = (size_t)-1;
+};
+
+/**
+ * @brief store a task that is run by a worker pool
+ */
+struct OGL_WorkerTask
+{
+    /**
+     * @brief store the function to run
+     */
+    void (*func)(void* data, size_t index) = 0;
+    /**
+     * @brief store some abituary data that is passed to the function
+     */
+    void* data = 0;
+    /**
+     * @brief store an index that is passed to the function, so one data object can be split into multiple tasks
+     */
+    size_t index = 0;
+};
+
+/**
+ * @brief store what is bound to a single indexed buffer binding point
+ */
+struct OGL_IndexedBufferBinding
+{
+    /**
+     * @brief store the bound buffer
+     */
+    GLuint buffer = 0;
+    /**
+     * @brief store the offset into the buffer in bytes
+     */
+    GLintptr offset = 0;
+    /**
+     * @brief store the size of the bound range in bytes, or -1 if the whole buffer is bound
+     */
+    GLsizeiptr size = -1;
+};
+
+/**
+ * @brief store a range of bytes of a buffer that was modified on the CPU
+ */
+struct OGL_DirtyRange
+{
+    /**
+     * @brief store the first modified byte
+     */
+    size_t begin = 0;
+    /**
+     * @brief store the byte after the last modified byte
+     */
+    size_t end = 0;
+};
+
+/**
+ * @brief store the rules an instance uses to select the internal format of textures that are created with OGL_TEXTURE_FORMAT_AUTO
+ */
+struct OGL_TextureFormatPolicy
+{
+    /**
+     * @brief say if 8-Bit color images use sRGB formats (GL_SRGB8 and GL_SRGB8_ALPHA8)
+     */
+    bool srgb = false;
+    /**
+     * @brief say if gray images use one channel (GL_R8) or two channels with alpha (GL_RG8). They are swizzled so they are still read as gray
+     */
+    bool reduceChannels = true;
+    /**
+     * @brief say if color render targets use 16-Bit floats instead of 8-Bit values
+     */
+    bool hdrTargets = true;
+    /**
+     * @brief say if color render targets without alpha use GL_R11F_G11F_B10F instead of GL_RGB16F
+     */
+    bool packedHDR = true;
+};
+
+/**
+ * @brief store how a texture is sampled. Samplers with the same description share one OpenGL sampler object
+ */
+struct OGL_SamplerDesc
+{
+    /**
+     * @brief store the filter for minification, like GL_LINEAR_MIPMAP_LINEAR
+     */
+    GLenum minFilter = GL_NEAREST_MIPMAP_LINEAR;
+    /**
+     * @brief store the filter for magnification, GL_NEAREST or GL_LINEAR
+     */
+    GLenum magFilter = GL_LINEAR;
+    /**
+     * @brief store the wrap mode for the s coordinate
+     */
+    GLenum wrapS = GL_REPEAT;
+    /**
+     * @brief store the wrap mode for the t coordinate
+     */
+    GLenum wrapT = GL_REPEAT;
+    /**
+     * @brief store the wrap mode for the r coordinate
+     */
+    GLenum wrapR = GL_REPEAT;
+    /**
+     * @brief store the compare mode for depth textures, GL_NONE or GL_COMPARE_REF_TO_TEXTURE
+     */
+    GLenum compareMode = GL_NONE;
+    /**
+     * @brief store the compare function for depth textures if the compare mode is GL_COMPARE_REF_TO_TEXTURE
+     */
+    GLenum compareFunc = GL_LEQUAL;
+    /**
+     * @brief store the maximum anisotropy, 1 disables anisotropic filtering
+     */
+    float maxAnisotropy = 1.f;
+    /**
+     * @brief store the smallest level of detail that is used
+     */
+    float minLod = -1000.f;
+    /**
+     * @brief store the biggest level of detail that is used
+     */
+    float maxLod = 1000.f;
+    /**
+     * @brief store the bias added to the level of detail
+     */
+    float lodBias = 0.f;
+    /**
+     * @brief store the color read outside of the texture if a wrap mode is GL_CLAMP_TO_BORDER
+     */
+    float borderColor[4] = {0.f, 0.f, 0.f, 0.f};
+};
+
+/**
+ * @brief store an OpenGL sampler object of the sampler cache of an instance
+ */
+struct OGL_CachedSampler
+{
+    /**
+     * @brief store the description the sampler was created from
+     */
+    OGL_SamplerDesc desc;
+    /**
+     * @brief store the OpenGL sampler object
+     */
+    GLuint sampler = 0;
+    /**
+     * @brief store the amount of samplers using the object
+     */
+    uint32_t references = 0;
+};
+
+/**
+ * @brief store how much video memory a texture of an instance uses and when it was used last
+ */
+struct OGL_TextureResidency
+{
+    /**
+     * @brief store the size of the storage of the texture in bytes
+     */
+    size_t size = 0;
+    /**
+     * @brief store the index of the frame the texture was bound in last
+     */
+    uint64_t lastUse = 0;
+};
+
+/**
+ * @brief store the statistics of the texture memory budget of an instance
+ */
+struct OGL_TextureBudgetStats
+{
+    /**
+     * @brief store the amount of binds of textures that where in video memory
+     */
+    uint64_t hits = 0;
+    /**
+     * @brief store the amount of binds of textures that had to be loaded again because they where evicted
+     */
+    uint64_t misses = 0;
+    /**
+     * @brief store the amount of textures that where evicted completely
+     */
+    uint64_t evictions = 0;
+    /**
+     * @brief store the amount of top mip levels that where dropped from textures
+     */
+    uint64_t droppedMips = 0;
+    /**
+     * @brief store the amount of video memory that was freed by evictions in bytes
+     */
+    uint64_t evictedBytes = 0;
+};
+
+/**
+ * @brief store a shadow copy of the bindings of an OpenGL context. It is used to skip binds that would not change anything
+ */
+struct OGL_StateCache
+{
+    /**
+     * @brief store the buffers bound to the generic buffer targets (except for the element array buffer)
+     */
+    GLuint buffers[OGL_STATE_BUFFER_TARGET_COUNT] = {};
+    /**
+     * @brief store the element array buffer for each vertex array, because the element array binding is part of the vertex array state
+     */
+    std::unordered_map<GLuint, GLuint> elementBuffers;
+    /**
+     * @brief store the buffers bound to the indexed uniform buffer binding points
+     */
+    std::vector<OGL_IndexedBufferBinding> uniformBuffers;
+    /**
+     * @brief store the buffers bound to the indexed shader storage buffer binding points
+     */
+    std::vector<OGL_IndexedBufferBinding> storageBuffers;
+    /**
+     * @brief store the textures bound to all texture units. The entry for a unit and target is at unit * OGL_STATE_TEXTURE_TARGET_COUNT + target
+     */
+    std::vector<GLuint> textures;
+    /**
+     * @brief store the samplers bound to all texture units
+     */
+    std::vector<GLuint> samplers;
+    /**
+     * @brief store the value new entries are initalised with if the vectors grow. This is 0 for a new context and unknown after an invalidation
+     */
+    GLuint growValue = 0;
+    /**
+     * @brief store the bound program
+     */
+    GLuint program = 0;
+    /**
+     * @brief store the bound vertex array
+     */
+    GLuint vertexArray = 0;
+    /**
+     * @brief store the active texture unit
+     */
+    GLuint activeUnit = 0;
+    /**
+     * @brief store the framebuffer bound for reading
+     */
+    GLuint readFramebuffer = 0;
+    /**
+     * @brief store the framebuffer bound for drawing
+     */
+    GLuint drawFramebuffer = 0;
+    /**
+     * @brief store the value of GL_UNPACK_ALIGNMENT
+     */
+    GLint unpackAlignment = 4;
+    /**
+     * @brief store the value of GL_UNPACK_ROW_LENGTH
+     */
+    GLint unpackRowLength = 0;
+    /**
+     * @brief store the amount of OpenGL binding calls that where issued
+     */
+    uint64_t issuedCalls = 0;
+    /**
+     * @brief store the amount of OpenGL binding calls that where skipped because they would not change anything
+     */
+    uint64_t elidedCalls = 0;
+};
+
+/**
+ * @brief store an OpenGL instance and handle its creation and destruction
+ */
+class OGL_Instance
+{
+public:
+    /**
+     * @brief Construct a new ogl instance
+     * 
+     * @param version the version of OpenGL to use as a float
+     * @param profile the type of profile to use
+     * @param allowDSA say if direct state access should be used if the context supports it (OpenGL 4.5 or newer)
+     */
+    OGL_Instance(float version = 4.5, OGL_ProfileType profile = OGL_PROFILE_COMPATIBLE, bool allowDSA = true);
+
+    /**
+     * @brief Destroy the ogl instance
+     */
+    ~OGL_Instance();
+
+//check if behind-the-scenes access is enabled
+#ifdef OGL_KEEP_BG_ACCESS
+
+    /**
+     * @brief register a window to the instance. this function is called in the window's constructor
+     * @warning this function is only usable behind the scenes
+     * 
+     * @param window a raw pointer to the window
+     */
+    void registerWindow(OGL_Window* window);
+
+    /**
+     * @brief remove a window from the instance. this function is called in the window's destructor, which is automaticaly called when an instance with bound windows is destroyed
+     * @warning this function is only usable behind the scens
+     * 
+     * @param window a raw pointer to the window
+     */
+    void removeWindow(OGL_Window* window);
+
+    /**
+     * @brief remove a bindable from the instance. this function is called in the bindable's destructor, which is automaticaly called when an instance with bound windows is destroyed
+     * @warning this function is only usable behind the scens
+     * 
+     * @param bindable a raw pointer to the bindable
+     */
+    void registerBindable(OGL_BindableBase* bindable);
+
+    /**
+     * @brief register a bindable to the instance. this function is called in the bindable's constructor
+     * @warning this function is only usable behind the scenes
+     * 
+     * @param bindable a raw pointer to the bindable
+     */
+    void removeBindable(OGL_BindableBase* bindable);
+
+    /**
+     * @brief replace a registered bindable with an other one. This function is called when a bindable is moved
+     * @warning this function is only usable behind the scenes
+     * 
+     * @param bindable a raw pointer to the registered bindable
+     * @param replacement a raw pointer to the bindable that takes it's place
+     */
+    void replaceBindable(OGL_BindableBase* bindable, OGL_BindableBase* replacement);
+
+    /**
+     * @brief register a bindable that has pending work, like a texture that is loaded in the background. It is updated every frame until the work is done
+     * @warning this function is only usable behind the scenes
+     * 
+     * @param bindable a raw pointer to the bindable
+     */
+    void addPending(OGL_BindableBase* bindable);
+
+    /**
+     * @brief update all bindables with pending work. This is called when a window is flipped
+     */
+    void updatePending();
+
+    /**
+     * @brief set the size of the storage of a texture for the texture memory budget. If the budget is exceeded, the least recently used textures are evicted
+     * @warning this function is only usable behind the scenes
+     * 
+     * @param texture a raw pointer to the texture
+     * @param size the size of the storage in bytes, 0 if the texture has no storage
+     */
+    void trackTexture(OGL_BindableBase* texture, size_t size);
+
+    /**
+     * @brief say that a texture is bound in this frame. This is called when a texture is bound
+     * @warning this function is only usable behind the scenes
+     * 
+     * @param texture a raw pointer to the texture
+     * @param reloaded say if the texture had to be loaded again because it was evicted
+     */
+    void useTexture(OGL_BindableBase* texture, bool reloaded);
+
+    /**
+     * @brief Get the worker pool of the instance. It is created on the first call with one thread less than the CPU has cores
+     * 
+     * @return OGL_WorkerPool* a pointer to the worker pool
+     */
+    OGL_WorkerPool* getWorkerPool();
+
+    /**
+     * @brief Get the OpenGL context of this context, or 0 if none exists
+     * 
+     * @return SDL_GLContext the OpenGL context
+     */
+    inline SDL_GLContext getContext() {return this->context;}
+
+    /**
+     * @brief handle an SDL event and pass it to the correct internal window
+     * 
+     * @param event the event to handle
+     * 
+     * @return true : the event was for a window registed to this instance
+     * @return false : the event was for another instance
+     */
+    bool handleEvent(SDL_Event event);
+
+#endif
+
+    /**
+     * @brief make this the current instance
+     * @warning this won't bind the OpenGL-Context or any window, it will just set the internal current index to this
+     */
+    void makeCurrent();
+
+    /**
+     * @brief check if this is the current instance
+     * 
+     * @return true : this is the current instance
+     * @return false : this is not the current instance
+     */
+    bool isCurrent();
+
+    /**
+     * @brief set the mode of VSync
+     * 
+     * @param useVSync say if VSync should be used
+     */
+    void setVSync(bool useVSync);
+
+    /**
+     * @brief get if vsync is used
+     * 
+     * @return true : vsync is enabled | 
+     * @return false : vsync is disabled
+     */
+    inline bool usingVSync() {return this->vsync;}
+
+    /**
+     * @brief get if direct state access is used to edit OpenGL objects. It is selected when the context is created
+     * 
+     * @return true : objects are edited with direct state access and editing never changes bindings | 
+     * @return false : objects are bound to edit them
+     */
+    inline bool usingDSA() {return this->dsa;}
+
+    /**
+     * @brief get the index of the current frame. It is increased every time a window of the instance is flipped
+     * 
+     * @return uint64_t the index of the current frame
+     */
+    inline uint64_t getFrame() {return this->frame;}
+
+    /**
+     * @brief say that a frame was finished. This is called when a window is flipped
+     */
+    inline void nextFrame() {++this->frame;}
+
+    /**
+     * @brief get if buffers with immutable storage can be created (OpenGL 4.4 or newer). It is selected when the context is created
+     * 
+     * @return true : buffers can be persistently mapped | 
+     * @return false : only mutable buffer storage is available
+     */
+    inline bool supportsBufferStorage() {return this->bufferStorageSupport;}
+
+    /**
+     * @brief get the alignment the offset of a uniform buffer range must have
+     * 
+     * @return GLint the alignment in bytes
+     */
+    inline GLint getUniformBufferOffsetAlignment() {return this->uniformBufferAlignment;}
+
+    /**
+     * @brief get the alignment the offset of a shader storage buffer range must have
+     * 
+     * @return GLint the alignment in bytes
+     */
+    inline GLint getStorageBufferOffsetAlignment() {return this->storageBufferAlignment;}
+
+    /**
+     * @brief get if many indirect draws can be issued with a single call (OpenGL 4.3 or newer). It is selected when the context is created
+     * 
+     * @return true : glMultiDrawElementsIndirect can be used | 
+     * @return false : indirect draws are issued one by one
+     */
+    inline bool supportsMultiDrawIndirect() {return this->multiDrawIndirectSupport;}
+
+    /**
+     * @brief get if the amount of indirect draws can be read from a buffer (OpenGL 4.6 or newer). It is selected when the context is created
+     * 
+     * @return true : glMultiDrawElementsIndirectCount can be used | 
+     * @return false : the amount of draws must be known on the CPU
+     */
+    inline bool supportsDrawCount() {return this->drawCountSupport;}
+
+    /**
+     * @brief set the rules to select the internal format of textures that are created with OGL_TEXTURE_FORMAT_AUTO
+     * 
+     * @param policy the new rules
+     */
+    inline void setTextureFormatPolicy(const OGL_TextureFormatPolicy& policy) {this->textureFormatPolicy = policy;}
+
+    /**
+     * @brief get the rules to select the internal format of textures that are created with OGL_TEXTURE_FORMAT_AUTO
+     * 
+     * @return const OGL_TextureFormatPolicy& the rules
+     */
+    inline const OGL_TextureFormatPolicy& getTextureFormatPolicy() {return this->textureFormatPolicy;}
+
+    /**
+     * @brief create a new OpenGL buffer. With direct state access the buffer object is created instantly, else only the name is reserved
+     * 
+     * @return GLuint the new buffer
+     */
+    GLuint createBuffer();
+
+    /**
+     * @brief (re-)allocate the storage of a buffer and fill it with data
+     * 
+     * @param target the target the buffer is bound to if no direct state access is used
+     * @param buffer the buffer to fill
+     * @param size the size of the new storage in bytes
+     * @param data the data to fill the buffer with or 0 to leave it uninitalised
+     * @param usage the usage hint for the storage
+     */
+    void bufferData(GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLenum usage);
+
+    /**
+     * @brief update a part of the storage of a buffer
+     * 
+     * @param target the target the buffer is bound to if no direct state access is used
+     * @param buffer the buffer to update
+     * @param offset the offset of the update in bytes
+     * @param size the size of the update in bytes
+     * @param data the new data
+     */
+    void bufferSubData(GLenum target, GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data);
+
+    /**
+     * @brief read a part of the storage of a buffer back to the CPU
+     * 
+     * @param target the target the buffer is bound to if no direct state access is used
+     * @param buffer the buffer to read from
+     * @param offset the offset of the data in bytes
+     * @param size the size of the data in bytes
+     * @param data the memory to write the data to
+     */
+    void getBufferSubData(GLenum target, GLuint buffer, GLintptr offset, GLsizeiptr size, void* data);
+
+    /**
+     * @brief copy a range of a buffer to an other buffer on the GPU
+     * 
+     * @param readBuffer the buffer to copy from
+     * @param writeBuffer the buffer to copy to
+     * @param readOffset the offset of the range in the read buffer in bytes
+     * @param writeOffset the offset of the range in the write buffer in bytes
+     * @param size the size of the range in bytes
+     */
+    void copyBufferSubData(GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
+
+    /**
+     * @brief allocate immutable storage for a buffer. The size of the buffer can't change afterwards
+     * 
+     * @param target the target the buffer is bound to if no direct state access is used
+     * @param buffer the buffer to allocate the storage for
+     * @param size the size of the storage in bytes
+     * @param data the data to fill the buffer with or 0 to leave it uninitalised
+     * @param flags the flags for the storage, like GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT
+     */
+    void bufferStorage(GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags);
+
+    /**
+     * @brief map a range of a buffer into the memory of the CPU
+     * 
+     * @param target the target the buffer is bound to if no direct state access is used
+     * @param buffer the buffer to map
+     * @param offset the offset of the range in bytes
+     * @param size the size of the range in bytes
+     * @param access the access flags for the mapping
+     * @return void* a pointer to the mapped memory or 0 if the mapping failed
+     */
+    void* mapBufferRange(GLenum target, GLuint buffer, GLintptr offset, GLsizeiptr size, GLbitfield access);
+
+    /**
+     * @brief unmap a mapped buffer
+     * 
+     * @param target the target the buffer is bound to if no direct state access is used
+     * @param buffer the buffer to unmap
+     */
+    void unmapBuffer(GLenum target, GLuint buffer);
+
+    /**
+     * @brief create a new OpenGL texture for a specific target
+     * 
+     * @param target the target of the texture, like GL_TEXTURE_2D
+     * @return GLuint the new texture
+     */
+    GLuint createTexture(GLenum target);
+
+    /**
+     * @brief create a new OpenGL framebuffer
+     * 
+     * @return GLuint the new framebuffer
+     */
+    GLuint createFramebuffer();
+
+    /**
+     * @brief create a new OpenGL renderbuffer
+     * 
+     * @return GLuint the new renderbuffer
+     */
+    GLuint createRenderbuffer();
+
+    /**
+     * @brief bind a buffer to a generic buffer target. The call is skipped if the buffer is allready bound
+     * 
+     * @param target the buffer target to bind to
+     * @param buffer the buffer to bind or 0 to unbind the target
+     */
+    void bindBuffer(GLenum target, GLuint buffer);
+
+    /**
+     * @brief bind a whole buffer to an indexed binding point. The call is skipped if the buffer is allready bound to that point
+     * 
+     * @param target the indexed buffer target, like GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+     * @param index the index of the binding point
+     * @param buffer the buffer to bind or 0 to unbind the point
+     */
+    void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+    /**
+     * @brief bind a range of a buffer to an indexed binding point. The call is skipped if the same range is allready bound to that point
+     * 
+     * @param target the indexed buffer target, like GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+     * @param index the index of the binding point
+     * @param buffer the buffer to bind
+     * @param offset the offset of the range in bytes
+     * @param size the size of the range in bytes
+     */
+    void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+    /**
+     * @brief use a shader program. The call is skipped if the program is allready in use
+     * 
+     * @param program the program to use or 0 to use none
+     */
+    void useProgram(GLuint program);
+
+    /**
+     * @brief bind a vertex array. The call is skipped if the vertex array is allready bound
+     * 
+     * @param vao the vertex array to bind or 0 to bind none
+     */
+    void bindVertexArray(GLuint vao);
+
+    /**
+     * @brief select the active texture unit. The call is skipped if the unit is allready active
+     * 
+     * @param unit the texture unit to activate
+     */
+    void activeTexture(uint8_t unit);
+
+    /**
+     * @brief bind a texture to a texture unit and activate the unit. The binding is skipped if the texture is allready bound to the unit, the unit is always active afterwards
+     * 
+     * @param unit the texture unit to bind to
+     * @param target the texture target, like GL_TEXTURE_2D
+     * @param texture the texture to bind or 0 to unbind the target of the unit
+     */
+    void bindTexture(uint8_t unit, GLenum target, GLuint texture);
+
+    /**
+     * @brief bind a sampler to a texture unit. The call is skipped if the sampler is allready bound to the unit
+     * 
+     * @param unit the texture unit to bind to
+     * @param sampler the sampler to bind or 0 to use the parameters of the texture
+     */
+    void bindSampler(uint8_t unit, GLuint sampler);
+
+    /**
+     * @brief bind samplers to consecutive texture units. Units that allready have their sampler are skipped, the rest is bound with a single call if the context supports it
+     * 
+     * @param first the first texture unit to bind to
+     * @param count the amount of samplers
+     * @param samplers the samplers to bind, 0 to use the parameters of the texture
+     */
+    void bindSamplers(uint8_t first, GLsizei count, const GLuint* samplers);
+
+    /**
+     * @brief get an OpenGL sampler object for a description from the sampler cache. If no sampler with the same description exists, it is created
+     * 
+     * @param desc the description of the sampler
+     * @return GLuint the shared sampler object. It must be given back with releaseSampler
+     */
+    GLuint acquireSampler(const OGL_SamplerDesc& desc);
+
+    /**
+     * @brief give back a sampler object from the sampler cache. The object is deleted when it is not used anymore
+     * 
+     * @param sampler the sampler object to give back
+     */
+    void releaseSampler(GLuint sampler);
+
+    /**
+     * @brief set the amount of video memory all textures of the instance may use. If it is exceeded, the least recently used textures that where loaded from files 
+     * lose their top mip levels or are evicted completely. They are loaded again when they are bound the next time. Parameters set with setTexParameter are set again on the reloaded textures
+     * 
+     * @param budget the budget in bytes, 0 for no limit
+     */
+    void setTextureBudget(size_t budget);
+
+    /**
+     * @brief get the amount of video memory all textures of the instance may use
+     * 
+     * @return size_t the budget in bytes, 0 for no limit
+     */
+    inline size_t getTextureBudget() {return this->textureBudget;}
+
+    /**
+     * @brief get the amount of video memory all textures of the instance use now
+     * 
+     * @return size_t the used memory in bytes
+     */
+    inline size_t getTextureMemory() {return this->textureMemory;}
+
+    /**
+     * @brief get the statistics of the texture memory budget
+     * 
+     * @return const OGL_TextureBudgetStats& the hits, misses and evictions
+     */
+    inline const OGL_TextureBudgetStats& getTextureBudgetStats() {return this->textureBudgetStats;}
+
+    /**
+     * @brief reset the statistics of the texture memory budget to 0
+     */
+    inline void resetTextureBudgetStats() {this->textureBudgetStats = OGL_TextureBudgetStats();}
+
+    /**
+     * @brief get the amount of different sampler objects in the sampler cache
+     * 
+     * @return size_t the amount of sampler objects
+     */
+    inline size_t getSamplerCount() {return this->samplers.size();}
+
+    /**
+     * @brief bind a framebuffer. The call is skipped if the framebuffer is allready bound to the target
+     * 
+     * @param target the framebuffer target, can be GL_FRAMEBUFFER, GL_READ_FRAMEBUFFER or GL_DRAW_FRAMEBUFFER
+     * @param framebuffer the framebuffer to bind or 0 to bind the default framebuffer
+     */
+    void bindFramebuffer(GLenum target, GLuint framebuffer);
+
+    /**
+     * @brief set how pixels are read from the CPU. The call is skipped if the value is allready set
+     * 
+     * @param alignment the value for GL_UNPACK_ALIGNMENT, 1, 2, 4 or 8
+     * @param rowLength the value for GL_UNPACK_ROW_LENGTH, 0 if the rows are only padded to the alignment
+     */
+    void setPixelUnpack(GLint alignment, GLint rowLength);
+
+    /**
+     * @brief Get the buffer bound to a generic buffer target. Cached targets and the element array buffer of the bound vertex array are answered from the state cache, 
+     * if the binding is not known or the target is not cached, OpenGL is queried
+     * 
+     * @param target the buffer target to get the binding from, any target that can be passed to bindBuffer
+     * @return GLuint the bound buffer
+     */
+    GLuint getBoundBuffer(GLenum target);
+
+    /**
+     * @brief Get the buffer bound to an indexed binding point
+     * 
+     * @param target the indexed buffer target, like GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+     * @param index the index of the binding point
+     * @return GLuint the bound buffer or OGL_STATE_UNKNOWN if the binding is not known
+     */
+    GLuint getBoundBufferBase(GLenum target, GLuint index);
+
+    /**
+     * @brief remove a buffer from the state cache. This must be called if the buffer is deleted
+     * 
+     * @param buffer the buffer that is deleted
+     */
+    void forgetBuffer(GLuint buffer);
+
+    /**
+     * @brief remove a texture from the state cache. This must be called if the texture is deleted
+     * 
+     * @param texture the texture that is deleted
+     */
+    void forgetTexture(GLuint texture);
+
+    /**
+     * @brief remove a program from the state cache. This must be called if the program is deleted
+     * 
+     * @param program the program that is deleted
+     */
+    void forgetProgram(GLuint program);
+
+    /**
+     * @brief remove a vertex array from the state cache. This must be called if the vertex array is deleted
+     * 
+     * @param vao the vertex array that is deleted
+     */
+    void forgetVertexArray(GLuint vao);
+
+    /**
+     * @brief remove a framebuffer from the state cache. This must be called if the framebuffer is deleted
+     * 
+     * @param framebuffer the framebuffer that is deleted
+     */
+    void forgetFramebuffer(GLuint framebuffer);
+
+    /**
+     * @brief mark the whole state cache as unknown. Call this after binding objects with raw OpenGL calls
+     */
+    void invalidateStateCache();
+
+    /**
+     * @brief Get the amount of binding calls that where skipped by the state cache
+     * 
+     * @return uint64_t the amount of skipped OpenGL calls
+     */
+    inline uint64_t getElidedCallCount() {return this->state.elidedCalls;}
+
+    /**
+     * @brief Get the amount of binding calls that where send to OpenGL
+     * 
+     * @return uint64_t the amount of issued OpenGL calls
+     */
+    inline uint64_t getIssuedCallCount() {return this->state.issuedCalls;}
+
+    /**
+     * @brief reset the counters for issued and skipped binding calls to 0
+     */
+    inline void resetCallCounters() {this->state.issuedCalls = 0; this->state.elidedCalls = 0;}
+
+private:
+    /**
+     * @brief store a vector of pointers to the windows
+     */
+    std::vector<OGL_Window*> windows = {};
+    /**
+     * @brief store a vector of pointers to the bindables
+     */
+    std::vector<OGL_BindableBase*> bindables = {};
+    /**
+     * @brief store a vector of pointers to the bindables with pending work
+     */
+    std::vector<OGL_BindableBase*> pending = {};
+    /**
+     * @brief store the worker pool, or 0 if it was not used yet
+     */
+    OGL_WorkerPool* workerPool = 0;
+    /**
+     * @brief store the OpenGL instance
+     */
+    SDL_GLContext context = 0;
+    /**
+     * @brief store if VSync is enabled
+     */
+    bool vsync = false;
+    /**
+     * @brief store if direct state access may be used
+     */
+    bool allowDSA = true;
+    /**
+     * @brief store if direct state access is used
+     */
+    bool dsa = false;
+    /**
+     * @brief store if immutable buffer storage is supported
+     */
+    bool bufferStorageSupport = false;
+    /**
+     * @brief store if multiple objects can be bound with a single call (OpenGL 4.4 or newer)
+     */
+    bool multiBindSupport = false;
+    /**
+     * @brief store the alignment for offsets of uniform buffer ranges
+     */
+    GLint uniformBufferAlignment = 256;
+    /**
+     * @brief store the alignment for offsets of shader storage buffer ranges
+     */
+    GLint storageBufferAlignment = 256;
+    /**
+     * @brief store if many indirect draws can be issued with a single call (OpenGL 4.3 or newer)
+     */
+    bool multiDrawIndirectSupport = false;
+    /**
+     * @brief store if the amount of indirect draws can be read from a buffer (OpenGL 4.6 or newer)
+     */
+    bool drawCountSupport = false;
+    /**
+     * @brief store the index of the current frame
+     */
+    uint64_t frame = 0;
+    /**
+     * @brief store the rules to select the internal format of textures
+     */
+    OGL_TextureFormatPolicy textureFormatPolicy;
+    /**
+     * @brief store the sampler objects shared by all samplers of the instance
+     */
+    std::vector<OGL_CachedSampler> samplers;
+    /**
+     * @brief store the memory use and last use of all textures with storage
+     */
+    std::unordered_map<OGL_BindableBase*, OGL_TextureResidency> textureResidency;
+    /**
+     * @brief store the amount of video memory all textures may use, 0 for no limit
+     */
+    size_t textureBudget = 0;
+    /**
+     * @brief store the amount of video memory all textures use
+     */
+    size_t textureMemory = 0;
+    /**
+     * @brief store the statistics of the texture memory budget
+     */
+    OGL_TextureBudgetStats textureBudgetStats;
+    /**
+     * @brief store if textures are evicted right now, so evictions don't start a new eviction
+     */
+    bool evictingTextures = false;
+
+    /**
+     * @brief evict the least recently used textures until the texture memory fits into the budget. Textures used in the current frame are kept
+     * 
+     * @param keep a texture that is never evicted, like the one that just got its storage
+     */
+    void enforceTextureBudget(OGL_BindableBase* keep);
+    /**
+     * @brief store the shadow copy of the bindings of the context
+     */
+    OGL_StateCache state;
+};
+
+/**
+ * @brief a base class which is used to handle the binding of the OpenGL classes to the instance. The binding is done automaticaly behind the scenes, as well as the removal. This is to ensure that all objects belong to the context and can't be used any more after the context is destroyed, to insure memory safty. 
+ */
+class OGL_BindableBase
+{
+public:
+    /**
+     * @brief Constructor for a bindalbe base. This registers the object to the instance, if no instance exists it will throw a runtime error
+     */
+    OGL_BindableBase(); 
+
+    /**
+     * @brief bindables own an OpenGL object, so they can't be copied
+     */
+    OGL_BindableBase(const OGL_BindableBase&) = delete;
+
+    /**
+     * @brief bindables own an OpenGL object, so they can't be copied
+     */
+    OGL_BindableBase& operator=(const OGL_BindableBase&) = delete;
+
+    /**
+     * @brief Move a bindable. The new object takes the place of the old one in the instance, the old one is not bound to an instance anymore
+     * 
+     * @param other the bindable to move from
+     */
+    OGL_BindableBase(OGL_BindableBase&& other);
+
+    /**
+     * @brief Move a bindable into an existing one. The OpenGL object of this bindable is destroyed first
+     * 
+     * @param other the bindable to move from
+     * @return OGL_BindableBase& a reference to this bindable
+     */
+    OGL_BindableBase& operator=(OGL_BindableBase&& other);
+
+    /**
+     * @brief Destructor for a bindable base. This will remove the object from the window. 
+     * 
+     */
+    virtual ~OGL_BindableBase();
+
+    /**
+     * @brief destroy the OpenGL object and remove the bindable from the instance. This is called by the destructor of every child class and when the instance is destroyed. 
+     * Calling it more than once dose nothing
+     */
+    void release();
+
+    /**
+     * @brief finish pending work of the bindable if it can be done without waiting
+     * 
+     * @return true : nothing is pending anymore | 
+     * @return false : work is still pending
+     */
+    inline bool update() {return this->onUpdate();}
+
+    /**
+     * @brief free video memory of the bindable to fit into a memory budget. The data is loaded again when the bindable is used
+     * 
+     * @param mipsOnly true to only drop the biggest mip level, false to free everything
+     * @return size_t the amount of freed memory in bytes, 0 if nothing could be freed
+     */
+    inline size_t evict(bool mipsOnly) {return this->onEvict(mipsOnly);}
+
+protected:
+    /**
+     * @brief this function should be used as the destructor of the child class to ensure memory safty and correct object destruction. It is called through release, 
+     * so every child class must call release in it's own destructor
+     */
+    virtual void onDestroy() {};
+    /**
+     * @brief this function is called every frame after the bindable was registered as pending to the instance
+     * 
+     * @return true : nothing is pending anymore and the bindable is removed from the pending list | 
+     * @return false : work is still pending
+     */
+    virtual bool onUpdate() {return true;}
+    /**
+     * @brief this function is called when the instance needs to free video memory
+     * 
+     * @param mipsOnly true to only drop the biggest mip level, false to free everything
+     * @return size_t the amount of freed memory in bytes, 0 if nothing could be freed
+     */
+    virtual size_t onEvict(bool) {return 0;}
+    /**
+     * @brief store the instance the object is bound to
+     */
+    OGL_Instance* instance = 0;
+};
+
+/**
+ * @brief store a window which can render with OpenGL. The window dose not contain the context
+ */
+class OGL_Window
+{
+public:
+    /**
+     * @brief Construct a new ogl window
+     */
+    OGL_Window() = default;
+
+    /**
+     * @brief Construct a new ogl window
+     * 
+     * @param name the name of the window
+     * @param width the width of the winow in pixels, default is 1000
+     * @param height the height of the window in pixels, default is 1000
+     * @param x the x position of the window relative to the top left corner in pixels, default is 0
+     * @param y the y position of the window relative to the top left corner in pixels, default is 0
+     */
+    OGL_Window(const char* name, uint32_t width = 1000, uint32_t height = 1000, uint32_t x = 0, uint32_t y = 0);
+
+    /**
+     * @brief Destroy the ogl window
+     */
+    ~OGL_Window();
+
+    /**
+     * @brief make this window with it's registerd instance the current window
+     */
+    void makeCurrent();
+
+//check if behind-the-scenes access is enabled
+#ifdef OGL_KEEP_BG_ACCESS
+
+    /**
+     * @brief Get the SDL_Window pointer from the window
+     * 
+     * @return SDL_Window* a pointer to the SDL window
+     */
+    inline SDL_Window* getWindow() {return this->window;}
+
+    /**
+     * @brief handle an SDL event
+     * 
+     * @param event the event to handle
+     * 
+     * @return true : the event was for this window
+     * @return false : the event was for another window
+     */
+    bool handleEvent(SDL_Event event);
+
+#endif
+
+    /**
+     * @brief get if the window should close
+     * 
+     * @return true : the window should close | 
+     * @return false : the window can stay open
+     */
+    inline bool isClosingRequested() {return this->shouldClose;}
+
+    /**
+     * @brief Set the Clear Color for the window
+     * 
+     * @param r the red component of the clear color. Like OpenGL in range from 0.f to 1.f
+     * @param g the green component of the clear color. Like OpenGL in range from 0.f to 1.f
+     * @param b the blue component of the clear color. Like OpenGL in range from 0.f to 1.f
+     * @param a the alpha component of the clear color. Like OpenGL in range from 0.f to 1.f
+     */
+    void setClearColor(float r, float g, float b, float a);
+
+    /**
+     * @brief Get the red component of the clear color
+     * 
+     * @return float the red component of the clear color
+     */
+    inline float getClearR() {return this->clearR;}
+
+    /**
+     * @brief Get the green component of the clear color
+     * 
+     * @return float the green component of the clear color
+     */
+    inline float getClearG() {return this->clearG;}
+
+    /**
+     * @brief Get the blue component of the clear color
+     * 
+     * @return float the blue component of the clear color
+     */
+    inline float getClearB() {return this->clearB;}
+
+    /**
+     * @brief Get the alpha component of the clear color
+     * 
+     * @return float the alpha component of the clear color
+     */
+    inline float getClearA() {return this->clearA;}
+
+    /**
+     * @brief Set the size of the window
+     * 
+     * @param width the width of the window in pixels
+     * @param height the height of the window in pixels
+     */
+    void setSize(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Get the width of the window in pixels
+     * 
+     * @return uint32_t the window of the window in pixels
+     */
+    inline uint32_t getWidth() {return this->width;}
+
+    /**
+     * @brief Get the height of the window in pixels
+     * 
+     * @return uint32_t the height of the window in pixels
+     */
+    inline uint32_t getHeight() {return this->height;}
+
+    /**
+     * @brief clear the window. By default, all masks are set. 
+     * 
+     * @param clearColor if this is true, the color buffer of the window will be cleared with the clear color. 
+     * @param clearDepth if this is true, the depth buffer will be cleard. 
+     * @param clearStencil if this is true, the stencil buffer of the window will be cleard.
+     */
+    void clear(bool clearColor = true, bool clearDepth = true, bool clearStencil = true);
+
+    /**
+     * @brief update the window
+     */
+    void flip();
+
+    /**
+     * @brief Set a function to call if the window is resized
+     * 
+     * @param func the function to call
+     * @param userData some abituary data that can be passed into the function
+     */
+    void setOnResizeHook(void (*func)(uint32_t, uint32_t, void*), void* userData = 0);
+
+    /**
+     * @brief Get the function the window calls if the window is resized
+     */
+    inline void (*getOnResizeHook())(uint32_t,uint32_t, void*) {return this->resizeFunc;}
+
+private:
+    /**
+     * @brief store a pointer to the instance
+     */
+    OGL_Instance* instance = 0;
+    /**
+     * @brief store the window pointer
+     */
+    SDL_Window* window = 0;
+    /**
+     * @brief store if the window should close
+     */
+    bool shouldClose = false;
+    /**
+     * @brief store the clear color's r component
+     */
+    float clearR = 0.f;
+    /**
+     * @brief store the clear color's g component
+     */
+    float clearG = 0.f;
+    /**
+     * @brief store the clear color's b component
+     */
+    float clearB = 0.f;
+    /**
+     * @brief store the clear color's a component
+     */
+    float clearA = 0.f;
+
+    /**
+     * @brief store the x-position of the window in pixels relative to the top left corner of the screen
+     */
+    uint32_t posX = 0;
+    /**
+     * @brief store the y-position of the window in pixels relative to the top left corner of the screen
+     */
+    uint32_t posY = 0;
+
+    /**
+     * @brief store the widht of the window in pixels
+     */
+    uint32_t width = 0;
+    /**
+     * @brief store the height of the window in pixels
+     */
+    uint32_t height = 0;
+    /**
+     * @brief store the name of the window
+     */
+    const char* name;
+    /**
+     * @brief store a function that should be called if the window is resized
+     */
+    void (*resizeFunc)(uint32_t, uint32_t, void*) = 0;
+    /**
+     * @brief store some abituary data for the user that can be passed into the resize function
+     */
+    void* resizeFuncUserData = 0;
+};
+
+/**
+ * @brief track the ranges of a CPU copy of a buffer that where modified since the last upload, so only those ranges need to be send to the GPU
+ */
+class OGL_DirtyRanges
+{
+public:
+    /**
+     * @brief Construct new dirty ranges
+     */
+    OGL_DirtyRanges() = default;
+
+    /**
+     * @brief Destroy the dirty ranges
+     */
+    ~OGL_DirtyRanges() = default;
+
+    /**
+     * @brief mark a range of bytes as modified. Ranges that overlap or are closer than the merge distance are merged
+     * 
+     * @param offset the offset of the first modified byte
+     * @param size the amount of modified bytes
+     */
+    void mark(size_t offset, size_t size);
+
+    /**
+     * @brief mark all bytes as modified, like when a pointer to the whole data was given out
+     */
+    inline void markAll() {this->ranges.clear(); this->ranges.push_back(OGL_DirtyRange{0, (size_t)-1});}
+
+    /**
+     * @brief mark all bytes starting at an offset as modified, like when elements are removed and the data behind them moves
+     * 
+     * @param offset the offset of the first modified byte
+     */
+    inline void markFrom(size_t offset) {this->mark(offset, (size_t)-1 - offset);}
+
+    /**
+     * @brief say that the GPU has the same data as the CPU
+     */
+    inline void clear() {this->ranges.clear();}
+
+    /**
+     * @brief get if any byte was modified
+     * 
+     * @return true : no byte was modified | 
+     * @return false : at least one byte was modified
+     */
+    inline bool empty() {return this->ranges.empty();}
+
+    /**
+     * @brief Get the modified ranges, sorted by they're offset
+     * 
+     * @return const std::vector<OGL_DirtyRange>& a reference to the ranges
+     */
+    inline const std::vector<OGL_DirtyRange>& getRanges() {return this->ranges;}
+
+    /**
+     * @brief Set the amount of bytes between two ranges at wich they are merged into one
+     * 
+     * @param distance the merge distance in bytes
+     */
+    inline void setMergeDistance(size_t distance) {this->mergeDistance = distance;}
+
+    /**
+     * @brief upload all modified ranges with glBufferSubData and clear them. Ranges are clipped to the size of the data
+     * 
+     * @param instance the instance to upload with
+     * @param target the target the buffer is bound to if no direct state access is used
+     * @param buffer the buffer to upload to
+     * @param data the CPU copy of the buffer
+     * @param size the size of the CPU copy in bytes
+     * @return size_t the amount of uploaded bytes
+     */
+    size_t flush(OGL_Instance* instance, GLenum target, GLuint buffer, const void* data, size_t size);
+
+private:
+    /**
+     * @brief store the modified ranges, sorted by they're offset and never overlapping
+     */
+    std::vector<OGL_DirtyRange> ranges;
+    /**
+     * @brief store the amount of bytes between two ranges at wich they are merged
+     */
+    size_t mergeDistance = OGL_DIRTY_RANGE_MERGE_DISTANCE;
+};
+
+/**
+ * @brief store the usage hint of a buffer and count how often it is uploaded. If the adaptive policy is enabled, the hint is moved between 
+ * static, dynamic and stream storage depending on how many uploads happend per frame during the last window of frames. The access part 
+ * of the hint (draw, read or copy) is never changed
+ */
+class OGL_BufferUsageTracker
+{
+public:
+    /**
+     * @brief Construct a new buffer usage tracker
+     */
+    OGL_BufferUsageTracker() = default;
+
+    /**
+     * @brief Destroy the buffer usage tracker
+     */
+    ~OGL_BufferUsageTracker() = default;
+
+    /**
+     * @brief Construct a new buffer usage tracker
+     * 
+     * @param usage the usage hint to start with, like GL_STATIC_DRAW
+     */
+    OGL_BufferUsageTracker(GLenum usage) : usage(usage) {}
+
+    /**
+     * @brief count an upload of the buffer and let the adaptive policy decide the usage hint
+     * 
+     * @param frame the index of the current frame
+     * @return true : the usage hint changed and the storage should be re-allocated with it | 
+     * @return false : the usage hint stays the same
+     */
+    bool recordUpload(uint64_t frame);
+
+    /**
+     * @brief count a re-allocation of the storage of the buffer
+     */
+    inline void recordReallocation() {++this->reallocations;}
+
+    /**
+     * @brief Set the usage hint. It is used the next time the storage is allocated
+     * 
+     * @param usage the new usage hint, like GL_STATIC_DRAW
+     */
+    inline void setUsage(GLenum usage) {this->usage = usage;}
+
+    /**
+     * @brief Get the usage hint
+     * 
+     * @return GLenum the current usage hint
+     */
+    inline GLenum getUsage() {return this->usage;}
+
+    /**
+     * @brief enable or disable the adaptive usage policy
+     * 
+     * @param adaptive true to let the policy select the usage hint, false to keep the hint set by the user
+     * @param window the amount of frames the uploads are counted over before the hint is decided
+     */
+    inline void setAdaptive(bool adaptive, uint32_t window = OGL_BUFFER_USAGE_WINDOW) {this->adaptive = adaptive; this->window = (window == 0) ? 1 : window; this->windowUploads = 0; this->windowStarted = false;}
+
+    /**
+     * @brief get if the adaptive usage policy is enabled
+     * 
+     * @return true : the policy selects the usage hint | 
+     * @return false : the usage hint is set by the user
+     */
+    inline bool isAdaptive() {return this->adaptive;}
+
+    /**
+     * @brief Get the amount of uploads of the buffer
+     * 
+     * @return uint64_t the amount of uploads
+     */
+    inline uint64_t getUploadCount() {return this->uploads;}
+
+    /**
+     * @brief Get the amount of times the storage of the buffer was re-allocated
+     * 
+     * @return uint64_t the amount of re-allocations
+     */
+    inline uint64_t getReallocationCount() {return this->reallocations;}
+
+    /**
+     * @brief Get the amount of times the adaptive policy changed the usage hint
+     * 
+     * @return uint64_t the amount of changes of the usage hint
+     */
+    inline uint64_t getUsageChangeCount() {return this->usageChanges;}
+
+    /**
+     * @brief Get the amount of uploads per frame the adaptive policy measured in the last finished window
+     * 
+     * @return float the amount of uploads per frame
+     */
+    inline float getUploadRate() {return this->uploadRate;}
+
+private:
+    /**
+     * @brief store the usage hint
+     */
+    GLenum usage = GL_STATIC_DRAW;
+    /**
+     * @brief store if the adaptive policy is enabled
+     */
+    bool adaptive = false;
+    /**
+     * @brief store the amount of frames in a window
+     */
+    uint32_t window = OGL_BUFFER_USAGE_WINDOW;
+    /**
+     * @brief store if the current window has started
+     */
+    bool windowStarted = false;
+    /**
+     * @brief store the frame the current window started at
+     */
+    uint64_t windowStart = 0;
+    /**
+     * @brief store the amount of uploads in the current window
+     */
+    uint32_t windowUploads = 0;
+    /**
+     * @brief store the amount of uploads
+     */
+    uint64_t uploads = 0;
+    /**
+     * @brief store the amount of re-allocations
+     */
+    uint64_t reallocations = 0;
+    /**
+     * @brief store the amount of changes of the usage hint
+     */
+    uint64_t usageChanges = 0;
+    /**
+     * @brief store the uploads per frame of the last finished window
+     */
+    float uploadRate = 0.f;
+};
+
+//a macro to ensure that the correct window is bound
+#define correctInstanceBinding() if (oglGetCurrentInstance() != this->instance) {this->instance->makeCurrent();}
+
+/**
+ * @brief handle vertex buffers in a class-wraped fassion
+ * 
+ * @tparam T the type of a vertex, can be anything. 
+ */
+template<typename T> class OGL_VertexBuffer : OGL_BindableBase
+{
+public:
+    /**
+     * @brief Construct a new ogl vertex buffer
+     */
+    OGL_VertexBuffer() = default;
+
+    /**
+     * @brief Move a vertex buffer. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the vertex buffer to move from
+     */
+    OGL_VertexBuffer(OGL_VertexBuffer&& other) = default;
+
+    /**
+     * @brief Move a vertex buffer into an existing one. The OpenGL object of this vertex buffer is destroyed first
+     * 
+     * @param other the vertex buffer to move from
+     * @return OGL_VertexBuffer& a reference to this vertex buffer
+     */
+    OGL_VertexBuffer& operator=(OGL_VertexBuffer&& other) = default;
+
+    /**
+     * @brief Destroy the vertex buffer
+     */
+    ~OGL_VertexBuffer() {this->release();}
+
+    /**
+     * @brief Construct a new ogl vertex buffer
+     * 
+     * @param vertices the vertices. Pass a temporary or use std::move to store them without copying
+     * @param usage the usage hint for the storage of the buffer
+     */
+    OGL_VertexBuffer(std::vector<T> vertices, GLenum usage = GL_STATIC_DRAW)
+    {
+        //store the usage hint
+        this->usage.setUsage(usage);
+        //store the vertices
+        this->vertices = std::move(vertices);
+        //create the VB
+        this->buffer = this->instance->createBuffer();
+        //upload to the GPU
+        this->uploadToGPU();
+    }
+
+    /**
+     * @brief Construct a new ogl vertex buffer from a range of memory
+     * 
+     * @param vertices a pointer to the first vertex
+     * @param count the amount of vertices
+     * @param usage the usage hint for the storage of the buffer
+     */
+    OGL_VertexBuffer(const T* vertices, size_t count, GLenum usage = GL_STATIC_DRAW)
+    {
+        //store the usage hint
+        this->usage.setUsage(usage);
+        //store the vertices
+        this->vertices.assign(vertices, vertices + count);
+        //create the VB
+        this->buffer = this->instance->createBuffer();
+        //upload to the GPU
+        this->uploadToGPU();
+    }
+
+    /**
+     * @brief add a vertex ad the end of the vertices
+     * 
+     * @param vertex the vertex to add
+     */
+    void addVertex(T vertex)
+    {
+        //the vertices are only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the vertex buffer was released");}
+        //the new vertex must be uploaded
+        this->dirty.mark(sizeof(T) * this->vertices.size(), sizeof(T));
+        //add a vertex
+        this->vertices.push_back(vertex);
+    }
+
+    /**
+     * @brief Set the Vertex at the specified position
+     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * 
+     * @param index the index to set the vertex to
+     * @param vertex the vertex to set
+     */
+    void setVertex(size_t index, T vertex)
+    {
+        //the vertices are only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the vertex buffer was released");}
+        //update the vertex
+        this->vertices[index] = vertex;
+        //only the changed vertex must be uploaded
+        this->dirty.mark(sizeof(T) * index, sizeof(T));
+    }
+
+    /**
+     * @brief Get the vertex at the specified index
+     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * 
+     * @param index the index to get the vertex from
+     * @return T the vertex at the specified index
+     */
+    T getVertex(size_t index)
+    {
+        //the vertices are only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the vertex buffer was released");}
+        //return the vertex at the specified location
+        return this->vertices[index];
+    }
+
+    /**
+     * @brief remove the vertex at the specified position
+     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * 
+     * @param index the index to delete the vertex from
+     */
+    void deleteVertex(size_t index)
+    {
+        //the vertices are only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the vertex buffer was released");}
+        //remove the index at the specified position
+        this->vertices.erase(this->vertices.begin() + index);
+        //all vertices behind the removed one moved
+        this->dirty.markFrom(sizeof(T) * index);
+    }
+
+    /**
+     * @brief access the element at the specified index
+     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * 
+     * @param index the index to access the element at
+     * @return T& a reference to the element
+     */
+    T& operator[](size_t index)
+    {
+        //the vertices are only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the vertex buffer was released");}
+        //the element may be changed through the reference
+        this->dirty.mark(sizeof(T) * index, sizeof(T));
+        //return a reference to the element
+        return this->vertices[index];
+    }
+
+    /**
+     * @brief Get a pointer to all the vertices
+     * 
+     * @return std::vector<T>* a pointer to the vertices
+     */
+    std::vector<T>* getVertices()
+    {
+        //the vertices are only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the vertex buffer was released");}
+        //all vertices may be changed through the pointer
+        this->dirty.markAll();
+        //return a pointer to the vertices
+        return &this->vertices;
+    }
+
+    /**
+     * @brief Set the usage hint for the storage of the buffer. It is used the next time the storage is allocated
+     * 
+     * @param usage the usage hint, like GL_STATIC_DRAW or GL_STREAM_DRAW
+     */
+    inline void setUsage(GLenum usage) {this->usage.setUsage(usage);}
+
+    /**
+     * @brief Get the usage tracker of the buffer to read the upload counters or enable the adaptive usage policy
+     * 
+     * @return OGL_BufferUsageTracker* a pointer to the usage tracker
+     */
+    inline OGL_BufferUsageTracker* getUsageTracker() {return &this->usage;}
+
+    /**
+     * @brief upload all changes and free the vertices on the CPU. Afterwards the buffer is only on the GPU and the vertices can't be accessed anymore
+     */
+    void releaseCPUData()
+    {
+        //upload the changes
+        this->uploadToGPU();
+        //free the vertices
+        this->vertices.clear();
+        this->vertices.shrink_to_fit();
+        //the buffer is now only on the GPU
+        this->gpuOnly = true;
+    }
+
+    /**
+     * @brief upload vertices directly from memory of the caller without storing them on the CPU. Afterwards the buffer is only on the GPU
+     * 
+     * @param vertices a pointer to the vertices
+     * @param count the amount of vertices
+     */
+    void uploadGPUOnly(const T* vertices, size_t count)
+    {
+        //bind the correct window / instance
+        correctInstanceBinding()
+        //create the buffer if it dose not exist
+        if (this->buffer == 0) {this->buffer = this->instance->createBuffer();}
+        //free the vertices on the CPU
+        this->vertices.clear();
+        this->vertices.shrink_to_fit();
+        this->dirty.clear();
+        //count the upload
+        this->usage.recordUpload(this->instance->getFrame());
+        //upload the vertices
+        this->gpuSize = sizeof(T) * count;
+        this->instance->bufferData(GL_ARRAY_BUFFER, this->buffer, this->gpuSize, vertices, this->usage.getUsage());
+        this->usage.recordReallocation();
+        //the buffer is now only on the GPU
+        this->gpuOnly = true;
+    }
+
+    /**
+     * @brief get if the vertices where released on the CPU
+     * 
+     * @return true : the buffer is only on the GPU | 
+     * @return false : the buffer has a copy of the vertices on the CPU
+     */
+    inline bool isGPUOnly() {return this->gpuOnly;}
+
+    /**
+     * @brief Get the amount of vertices, this also works if the buffer is only on the GPU
+     * 
+     * @return size_t the amount of vertices
+     */
+    inline size_t getVertexCount() {return this->gpuOnly ? (this->gpuSize / sizeof(T)) : this->vertices.size();}
+
+    /**
+     * @brief bind the vertex buffer object
+     */
+    void bind()
+    {
+        //bind the correct window / instance
+        correctInstanceBinding()
+
+        //bind the vertex buffer
+        this->instance->bindBuffer(GL_ARRAY_BUFFER, this->buffer);
+    }
+
+    /**
+     * @brief unbind any vertex buffer
+     */
+    void bindNone()
+    {
+        //bind the correct window / instance
+        correctInstanceBinding()
+        //bind buffer 0, which means none
+        this->instance->bindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    /**
+     * @brief upload the data of the element to the GPU. Only modified vertices are uploaded, the storage is only re-allocated if the vertices don't fit into it
+     */
+    void uploadToGPU()
+    {
+        //bind the correct window / instance
+        correctInstanceBinding()
+        //the vertices are only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the vertex buffer was released");}
+        //store the size of the vertices in bytes
+        size_t size = sizeof(T) * this->vertices.size();
+        //count the upload, if the usage hint changed the storage is re-allocated with the new hint
+        if (this->usage.recordUpload(this->instance->getFrame())) {this->gpuSize = 0;}
+        //check if the vertices fit into the storage on the GPU
+        if (size <= this->gpuSize && this->gpuSize != 0)
+        {
+            //only upload the modified vertices
+            this->dirty.flush(this->instance, GL_ARRAY_BUFFER, this->buffer, this->vertices.data(), size);
+            return;
+        }
+        //buffer the whole vertices
+        this->instance->bufferData(GL_ARRAY_BUFFER, this->buffer, size, this->vertices.data(), this->usage.getUsage());
+        this->usage.recordReallocation();
+        //store the new size of the storage
+        this->gpuSize = size;
+        //the GPU has all vertices now
+        this->dirty.clear();
+    }
+
+private:
+    /**
+     * @brief this function is responsible for deleting the object
+     */
+    virtual void onDestroy() override
+    {
+        //remove the buffer from the state cache
+        this->instance->forgetBuffer(this->buffer);
+        //delete the vertex buffer
+        glDeleteBuffers(1, &this->buffer);
+        //set the buffer to 0
+        this->buffer = 0;
+        //free the vertices
+        this->vertices.clear();
+    }
+
+    /**
+     * @brief store the vertices
+     */
+    std::vector<T> vertices;
+    /**
+     * @brief store the OpenGL buffer
+     */
+    GLuint buffer = 0;
+    /**
+     * @brief store the size of the storage on the GPU in bytes
+     */
+    size_t gpuSize = 0;
+    /**
+     * @brief store the ranges that where modified since the last upload
+     */
+    OGL_DirtyRanges dirty;
+    /**
+     * @brief store the usage hint and the upload counters
+     */
+    OGL_BufferUsageTracker usage;
+    /**
+     * @brief store if the CPU data was released and the buffer is only on the GPU
+     */
+    bool gpuOnly = false;
+};
+
+/**
+ * @brief store the information about a part of an vertex
+ */
+struct OGL_VertexAttribute
+{
+    //store the vertex size
+    uint8_t size = 4;
+    //store the type of the data
+    OGL_Type type = OGL_TYPE_FLOAT;
+    //store if the data should be normalized
+    bool normalize = false;
+};
+
+/**
+ * @brief handle the definition of how a vertex looks
+ */
+class OGL_VertexAttributes : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new structure to describe the structure of the vertices
+     */
+    OGL_VertexAttributes() = default;
+
+    /**
+     * @brief Move a vertex attribute object. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the vertex attribute object to move from
+     */
+    OGL_VertexAttributes(OGL_VertexAttributes&& other) = default;
+
+    /**
+     * @brief Move a vertex attribute object into an existing one. The OpenGL object of this vertex attribute object is destroyed first
+     * 
+     * @param other the vertex attribute object to move from
+     * @return OGL_VertexAttributes& a reference to this vertex attribute object
+     */
+    OGL_VertexAttributes& operator=(OGL_VertexAttributes&& other) = default;
+
+    /**
+     * @brief Destroy the vertex attribute object
+     */
+    ~OGL_VertexAttributes() {this->release();}
+
+    /**
+     * @brief Construct a new structure to describe the structure of the vertices
+     * 
+     * @param attributes the attributes of the vertices
+     * @param vertexSize the size of a single vertex
+     */
+    OGL_VertexAttributes(std::vector<OGL_VertexAttribute> attributes, size_t vertexSize);
+
+    /**
+     * @brief change the structure of the vertices
+     * 
+     * @param attributes the new attributes for the structure of the vertices
+     * @param vertexSize the size of a single vertex
+     */
+    void updateStructure(std::vector<OGL_VertexAttribute> attributes, size_t vertexSize);
+
+    /**
+     * @brief only re-upload the structure of the VAO, don't set a new structure
+     */
+    void update();
+
+    /**
+     * @brief change and upload the structure of a single attribute of the vertex
+     * 
+     * @param idx the index to change the data at. If the index is out of range, it will be put to the end of the list
+     * @return OGL_VertexAttribute& a reference to the requested attribute. If it changes, the data will be re-uploaded. 
+     */
+    OGL_VertexAttribute& operator[](size_t idx);
+
+    /**
+     * @brief bind this as the structure for the current vertices
+     */
+    void bind();
+
+private:
+    /**
+     * @brief clean up the object
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief store the attributes for the vertices
+     */
+    std::vector<OGL_VertexAttribute> attributes;
+    /**
+     * @brief store the size of a vertex
+     */
+    size_t vertSize = 0;
+    /**
+     * @brief store the VAO
+     */
+    GLuint vao = 0;
+};
+
+/**
+ * @brief handle an element array buffer, also called index buffer, for OpenGL
+ */
+class OGL_IndexBuffer : OGL_BindableBase
+{
+public:
+    /**
+     * @brief Construct a new index buffer
+     */
+    OGL_IndexBuffer() = default;
+
+    /**
+     * @brief Move a index buffer. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the index buffer to move from
+     */
+    OGL_IndexBuffer(OGL_IndexBuffer&& other) = default;
+
+    /**
+     * @brief Move a index buffer into an existing one. The OpenGL object of this index buffer is destroyed first
+     * 
+     * @param other the index buffer to move from
+     * @return OGL_IndexBuffer& a reference to this index buffer
+     */
+    OGL_IndexBuffer& operator=(OGL_IndexBuffer&& other) = default;
+
+    /**
+     * @brief Destroy the index buffer
+     */
+    ~OGL_IndexBuffer() {this->release();}
+
+    /**
+     * @brief Construct a new index buffer
+     * 
+     * @param indices the indices for the buffer. Pass a temporary or use std::move to store them without copying
+     * @param usage the usage hint for the storage of the buffer
+     */
+    OGL_IndexBuffer(std::vector<uint32_t> indices, GLenum usage = GL_STATIC_DRAW);
+
+    /**
+     * @brief Construct a new index buffer from a range of memory
+     * 
+     * @param indices a pointer to the first index
+     * @param count the amount of indices
+     * @param usage the usage hint for the storage of the buffer
+     */
+    OGL_IndexBuffer(const uint32_t* indices, size_t count, GLenum usage = GL_STATIC_DRAW);
+
+    /**
+     * @brief change the data stored in the buffer
+     * 
+     * @param indices the new indices for the buffer. Pass a temporary or use std::move to store them without copying
+     */
+    inline void updateData(std::vector<uint32_t> indices) {this->indices = std::move(indices); this->dirty.markAll(); this->gpuOnly = false;}
+
+    /**
+     * @brief upload the buffer to the index buffer on the GPU. Only modified indices are uploaded, the storage is only re-allocated if the indices don't fit into it
+     */
+    void upload();
+
+    /**
+     * @brief add an element to the buffer
+     * 
+     * @param index the index to add
+     */
+    inline void addElement(uint32_t index) {this->checkCPUData(); this->dirty.mark(this->indices.size()*sizeof(uint32_t), sizeof(uint32_t)); this->indices.push_back(index);}
+
+    /**
+     * @brief Set an element in the buffer to a new value
+     * 
+     * @param index the new value
+     * @param idx the index to change
+     */
+    void setElement(uint32_t index, size_t idx);
+
+    /**
+     * @brief Get a specific element from the buffer
+     * 
+     * @param idx the index to access
+     * @return uint32_t the value of the element in the buffer
+     */
+    uint32_t getElement(size_t idx);
+
+    /**
+     * @brief Get a pointer to an specific element from the buffer
+     * 
+     * @param idx the index to access
+     * @return uint32_t* a pointer to the element
+     */
+    uint32_t* getElementPtr(size_t idx);
+
+    /**
+     * @brief access a reference of a specific element with the index operator
+     * 
+     * @param idx the index to access
+     * @return uint32_t& a reference to the element (a REFERENCE, not a POINTER)
+     */
+    uint32_t& operator[](size_t idx);
+
+    /**
+     * @brief Get the values of all indices
+     * 
+     * @return const std::vector<uint32_t>& a reference to a vector of all values
+     */
+    inline const std::vector<uint32_t>& getIndices() {this->checkCPUData(); return this->indices;}
+
+    /**
+     * @brief Get a pointer to all the indices
+     * 
+     * @return std::vector<uint32_t>* a pointer to the vector containing the indices
+     */
+    inline std::vector<uint32_t>* getIndicesPtr() {this->checkCPUData(); this->dirty.markAll(); return &this->indices;}
+
+    /**
+     * @brief Set the usage hint for the storage of the buffer. It is used the next time the storage is allocated
+     * 
+     * @param usage the usage hint, like GL_STATIC_DRAW or GL_STREAM_DRAW
+     */
+    inline void setUsage(GLenum usage) {this->usage.setUsage(usage);}
+
+    /**
+     * @brief Get the usage tracker of the buffer to read the upload counters or enable the adaptive usage policy
+     * 
+     * @return OGL_BufferUsageTracker* a pointer to the usage tracker
+     */
+    inline OGL_BufferUsageTracker* getUsageTracker() {return &this->usage;}
+
+    /**
+     * @brief bind this as the current element array buffer
+     */
+    void bind();
+
+    /**
+     * @brief bind this as the current element array buffer
+     */
+    void unbind();
+
+    /**
+     * @brief Get the amount of stored indices
+     * 
+     * @return size_t the amount of indices
+     */
+    inline size_t getIndexCount() {return this->gpuOnly ? (this->gpuSize / sizeof(uint32_t)) : this->indices.size();}
+
+    /**
+     * @brief upload all changes and free the indices on the CPU. Afterwards the buffer is only on the GPU and the indices can't be accessed anymore
+     */
+    void releaseCPUData();
+
+    /**
+     * @brief upload indices directly from memory of the caller without storing them on the CPU. Afterwards the buffer is only on the GPU
+     * 
+     * @param indices a pointer to the indices
+     * @param count the amount of indices
+     */
+    void uploadGPUOnly(const uint32_t* indices, size_t count);
+
+    /**
+     * @brief get if the indices where released on the CPU
+     * 
+     * @return true : the buffer is only on the GPU | 
+     * @return false : the buffer has a copy of the indices on the CPU
+     */
+    inline bool isGPUOnly() {return this->gpuOnly;}
+
+private:
+    /**
+     * @brief handle the destruction of the buffer
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief throw an error if the indices where released on the CPU
+     */
+    inline void checkCPUData() {if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the index buffer was released");}}
+
+    /**
+     * @brief store the index data for the buffer
+     */
+    std::vector<uint32_t> indices;
+    /**
+     * @brief store the index buffer
+     */
+    GLuint ibo = 0;
+    /**
+     * @brief store the size of the storage on the GPU in bytes
+     */
+    size_t gpuSize = 0;
+    /**
+     * @brief store the ranges that where modified since the last upload
+     */
+    OGL_DirtyRanges dirty;
+    /**
+     * @brief store the usage hint and the upload counters
+     */
+    OGL_BufferUsageTracker usage;
+    /**
+     * @brief store if the CPU data was released and the buffer is only on the GPU
+     */
+    bool gpuOnly = false;
+};
+
+/**
+ * @brief describe how a C++ type is uploaded as a uniform. Types without a specialisation can't be used as uniforms. The upload function takes the total amount of scalar, vector or matrix elements to upload
+ * 
+ * @tparam T the type of the uniform value
+ */
+template<typename T> struct OGL_UniformTraits;
+
+/**
+ * @brief define the uniform traits for a scalar or vector type
+ * 
+ * @param T the C++ type
+ * @param BASE the base type of the components
+ * @param COMPONENTS the amount of components
+ * @param ELEM the C++ type of a single component
+ * @param SUFFIX the suffix of the OpenGL uniform function
+ */
+#define OGL_UNIFORM_VECTOR_TRAITS(T, BASE, COMPONENTS, ELEM, SUFFIX) \
+template<> struct OGL_UniformTraits<T> \
+{ \
+    static constexpr OGL_Type type = BASE; \
+    static constexpr uint8_t components = COMPONENTS; \
+    static constexpr uint8_t columns = 1; \
+    static constexpr GLsizei count = 1; \
+    static void upload(GLuint program, GLint location, GLsizei count, const void* data, bool useDSA) \
+    { \
+        if (useDSA) {glProgramUniform##SUFFIX(program, location, count, (const ELEM*)data);} \
+        else {glUniform##SUFFIX(location, count, (const ELEM*)data);} \
+    } \
+};
+
+/**
+ * @brief define the uniform traits for a square float matrix
+ * 
+ * @param T the C++ type
+ * @param SIZE the amount of rows and columns
+ * @param SUFFIX the suffix of the OpenGL uniform function
+ */
+#define OGL_UNIFORM_MATRIX_TRAITS(T, SIZE, SUFFIX) \
+template<> struct OGL_UniformTraits<T> \
+{ \
+    static constexpr OGL_Type type = OGL_TYPE_FLOAT; \
+    static constexpr uint8_t components = SIZE; \
+    static constexpr uint8_t columns = SIZE; \
+    static constexpr GLsizei count = 1; \
+    static void upload(GLuint program, GLint location, GLsizei count, const void* data, bool useDSA) \
+    { \
+        if (useDSA) {glProgramUniform##SUFFIX(program, location, count, GL_FALSE, (const float*)data);} \
+        else {glUniform##SUFFIX(location, count, GL_FALSE, (const float*)data);} \
+    } \
+};
+
+OGL_UNIFORM_VECTOR_TRAITS(float, OGL_TYPE_FLOAT, 1, float, 1fv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_Vec2, OGL_TYPE_FLOAT, 2, float, 2fv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_Vec3, OGL_TYPE_FLOAT, 3, float, 3fv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_Vec4, OGL_TYPE_FLOAT, 4, float, 4fv)
+OGL_UNIFORM_VECTOR_TRAITS(int32_t, OGL_TYPE_INT, 1, GLint, 1iv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_IVec2, OGL_TYPE_INT, 2, GLint, 2iv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_IVec3, OGL_TYPE_INT, 3, GLint, 3iv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_IVec4, OGL_TYPE_INT, 4, GLint, 4iv)
+OGL_UNIFORM_VECTOR_TRAITS(uint32_t, OGL_TYPE_UINT, 1, GLuint, 1uiv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_UVec2, OGL_TYPE_UINT, 2, GLuint, 2uiv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_UVec3, OGL_TYPE_UINT, 3, GLuint, 3uiv)
+OGL_UNIFORM_VECTOR_TRAITS(OGL_UVec4, OGL_TYPE_UINT, 4, GLuint, 4uiv)
+OGL_UNIFORM_MATRIX_TRAITS(OGL_Mat2, 2, Matrix2fv)
+OGL_UNIFORM_MATRIX_TRAITS(OGL_Mat3, 3, Matrix3fv)
+OGL_UNIFORM_MATRIX_TRAITS(OGL_Mat4, 4, Matrix4fv)
+
+#undef OGL_UNIFORM_VECTOR_TRAITS
+#undef OGL_UNIFORM_MATRIX_TRAITS
+
+/**
+ * @brief the uniform traits for arrays. The whole array is uploaded with a single call
+ * 
+ * @tparam T the type of an element
+ * @tparam N the amount of elements
+ */
+template<typename T, size_t N> struct OGL_UniformTraits<T[N]>
+{
+    static constexpr OGL_Type type = OGL_UniformTraits<T>::type;
+    static constexpr uint8_t components = OGL_UniformTraits<T>::components;
+    static constexpr uint8_t columns = OGL_UniformTraits<T>::columns;
+    static constexpr GLsizei count = OGL_UniformTraits<T>::count * N;
+    static void upload(GLuint program, GLint location, GLsizei count, const void* data, bool useDSA)
+    {
+        //the count allready contains all elements of the array, so upload them all at once
+        OGL_UniformTraits<T>::upload(program, location, count, data, useDSA);
+    }
+};
+
+/**
+ * @brief the uniform traits for std::arrays. The whole array is uploaded with a single call
+ * 
+ * @tparam T the type of an element
+ * @tparam N the amount of elements
+ */
+template<typename T, size_t N> struct OGL_UniformTraits<std::array<T, N>> : OGL_UniformTraits<T[N]> {};
+
+/**
+ * @brief store the information about a single uniform
+ */
+class OGL_UniformInfo
+{
+public:
+
+    /**
+     * @brief Construct a new uniform information structure
+     */
+    OGL_UniformInfo() = default;
+
+    /**
+     * @brief set the data contained in the info to a specific value
+     * 
+     * @tparam T the type of the data
+     * @param value the value to set to
+     */
+    template<typename T> void set(const T& value)
+    {
+        //check if the type fits
+        static_assert(sizeof(T) <= sizeof(float)*16, "The type of the value tried to set as uniform is bigger as 64, wich is the maximum size of a uniform");
+        //copy the data
+        memcpy(data, &value, sizeof(T));
+        //the value may differ from the one on the GPU now
+        this->dirty = true;
+    }
+
+    /**
+     * @brief set the layout of the uniform from a C++ type. The OpenGL function to upload the uniform is selected at compile time
+     * 
+     * @tparam T the type of the uniform, must have a specialisation of OGL_UniformTraits
+     */
+    template<typename T> void setType()
+    {
+        //check if the type fits
+        static_assert(sizeof(T) <= sizeof(float)*16, "The type of the uniform is bigger as 64, wich is the maximum size of a uniform");
+        //store the layout
+        this->type = OGL_UniformTraits<T>::type;
+        this->components = OGL_UniformTraits<T>::components;
+        this->columns = OGL_UniformTraits<T>::columns;
+        this->count = OGL_UniformTraits<T>::count;
+        //store the upload function
+        this->uploader = &OGL_UniformTraits<T>::upload;
+        //the value must be uploaded with the new layout
+        this->invalidate();
+    }
+
+    /**
+     * @brief get the data stored in the uniform info
+     * 
+     * @tparam T the type of the data
+     * @return T the stored data
+     */
+    template<typename T> inline T get()
+    {
+        //return the re-interpreted data
+        return *((T*)((void*)data));
+    }
+
+    /**
+     * @brief upload the stored value to the uniform of a program
+     * 
+     * @param program the program the uniform belongs to
+     * @param useDSA true to upload with glProgramUniform without the program being bound, false to upload to the program in use
+     */
+    void upload(GLuint program, bool useDSA);
+
+    /**
+     * @brief upload the stored value only if it was changed since the last upload to the program
+     * 
+     * @param program the program the uniform belongs to
+     * @param useDSA true to upload with glProgramUniform without the program being bound, false to upload to the program in use
+     * @return true : the value was uploaded | 
+     * @return false : the program allready has the value, nothing was uploaded
+     */
+    bool uploadIfChanged(GLuint program, bool useDSA);
+
+    /**
+     * @brief forget the value the program has on the GPU, so the next upload is never skipped
+     */
+    inline void invalidate() {this->dirty = true; this->gpuProgram = 0;}
+
+    /**
+     * @brief get a reference to the data stored in the uniform info. This marks the uniform as changed, because the reference may be written to
+     * 
+     * @tparam T the type of the data
+     * @return T& a reference to the stored data
+     */
+    template<typename T> inline T& getRef()
+    {
+        //the reference may be used to change the value
+        this->dirty = true;
+        //retuern a reference to the re-interpreted data
+        return (*((T*)((void*)data)));
+    }
+
+    /**
+     * @brief store the name of the uniform
+     */
+    std::string name;
+    /**
+     * @brief store the type
+     */
+    OGL_Type type;
+    /**
+     * @brief store the amount of components of a single element (rows for matrices)
+     */
+    uint8_t components = 1;
+    /**
+     * @brief store the amount of columns of a single element, 1 for scalars and vectors
+     */
+    uint8_t columns = 1;
+    /**
+     * @brief store the amount of elements for arrays. All elements are uploaded with a single call
+     */
+    GLsizei count = 1;
+    /**
+     * @brief store the function to upload the elements of the value, selected from the type. If it is 0, the value is uploaded as a single scalar of the base type
+     */
+    void (*uploader)(GLuint program, GLint location, GLsizei count, const void* data, bool useDSA) = 0;
+    /**
+     * @brief store the raw data of the contained value
+     */
+    uint8_t data[sizeof(float)*16] = {};
+    /**
+     * @brief store the location of the uniform
+     */
+    GLint location = -1;
+    /**
+     * @brief store if the value may have changed since the last upload
+     */
+    bool dirty = true;
+    /**
+     * @brief store the value that was last uploaded to the program
+     */
+    uint8_t gpuData[sizeof(float)*16] = {};
+    /**
+     * @brief store the program the last uploaded value belongs to, or 0 if the value on the GPU is not known
+     */
+    GLuint gpuProgram = 0;
+    /**
+     * @brief store the location the last value was uploaded to
+     */
+    GLint gpuLocation = -1;
+};
+
+/**
+ * @brief utility function to create an uniform info and initalise it
+ * 
+ * @tparam T the type for the value
+ * @param name the name of the uniform
+ * @param value the value of the uniform
+ * @param type the base type for OpenGL
+ * @return OGL_UniformInfo the finished uniform information
+ */
+template<typename T> OGL_UniformInfo oglCreateUniformInfo(std::string name, T value, OGL_Type type)
+{
+    //crate a new info
+    OGL_UniformInfo info;
+    //store the name
+    info.name = name;
+    //store the type identifyer
+    info.type = type;
+    //set the data
+    info.set<T>(value);
+    //return the info
+    return info;
+}
+
+/**
+ * @brief read all active uniforms that are not part of a uniform block from a linked program. The uniforms get the type, array size and location from the program, but no value
+ * 
+ * @param program the linked program to read the uniforms from
+ * @return std::vector<OGL_UniformInfo> the active uniforms of the program
+ */
+std::vector<OGL_UniformInfo> oglReflectUniforms(GLuint program);
+
+/**
+ * @brief handle all functions neceserry for shaders
+ */
+class OGL_Shader : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new shader
+     */
+    OGL_Shader() = default;
+
+    /**
+     * @brief Move a shader. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the shader to move from
+     */
+    OGL_Shader(OGL_Shader&& other) = default;
+
+    /**
+     * @brief Move a shader into an existing one. The OpenGL object of this shader is destroyed first
+     * 
+     * @param other the shader to move from
+     * @return OGL_Shader& a reference to this shader
+     */
+    OGL_Shader& operator=(OGL_Shader&& other) = default;
+
+    /**
+     * @brief Destroy the shader
+     */
+    ~OGL_Shader() {this->release();}
+
+    /**
+     * @brief Construct a new shader
+     * 
+     * @param vs the vertex shader information, in the format specified by type
+     * @param fs the fragment shader information, in the format specified by type
+     * @param type the type the data is given in, can be inputed as file, source or binary
+     */
+    OGL_Shader(std::string vs, std::string fs, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
+
+    /**
+     * @brief change this shader to a new shader
+     * 
+     * @param vs the vertex shader information, in the format specified by type
+     * @param fs the fragment shader information, in the format specified by type
+     * @param type the type the data is given in, can be inputed as file, source or binary
+     */
+    void recompileShader(std::string vs, std::string fs, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
+
+    /**
+     * @brief Get the Compiled Shader on the GPU
+     * 
+     * @return uint32_t the compiled OpenGL shader on the GPU
+     */
+    inline uint32_t getCompiledShader() {return this->shader;}
+
+    /**
+     * @brief bind the shader
+     */
+    void bind();
+
+    /**
+     * @brief unbind the shader
+     */
+    void unbind();
+
+    /**
+     * @brief upload the values of all uniforms to the shader. With direct state access this dose not bind the shader
+     */
+    void uploadUniforms();
+
+    /**
+     * @brief Set the values of uniforms by name. Uniforms that are allready known, like the reflected ones, keep they're index, location and layout and only take the value. 
+     * Unknown uniforms are added at the end, so use getUniformIndex to find the index of a uniform
+     * 
+     * @param uniforms the uniforms for the shader
+     */
+    void setUniforms(std::vector<OGL_UniformInfo> uniforms);
+
+    /**
+     * @brief Get a pointer to all stored uniforms
+     * 
+     * @return std::vector<OGL_UniformInfo>* a pointer to the internal vector of uniforms
+     */
+    inline std::vector<OGL_UniformInfo>* getUniformPtr() {return &this->uniforms;}
+
+    /**
+     * @brief Get the amount of stored uniforms
+     * 
+     * @return size_t the amount of uniforms
+     */
+    inline size_t getUniformCount() {return this->uniforms.size();}
+
+    /**
+     * @brief get a specific uniform from the shader. If it dosn't exist, create it
+     * 
+     * @param name the name of the uniform
+     * @return OGL_UniformInfo& a reference to the uniform
+     */
+    OGL_UniformInfo& operator[](const std::string& name);
+
+    /**
+     * @brief get the index of a uniform. All active uniforms of the program are known after compilation and the index stays the same, even if the shader is re-compiled
+     * 
+     * @param name the name of the uniform
+     * @return size_t the index of the uniform or -1 if it dosn't exist
+     */
+    size_t getUniformIndex(const std::string& name);
+
+    /**
+     * @brief get the index of a uniform and add it if it dosn't exist. Uniforms that where not reflected ask OpenGL for they're location, 
+     * like elements of arrays that are requested as name[1]
+     * 
+     * @param name the name of the uniform
+     * @return size_t the index of the uniform
+     */
+    size_t addUniform(const std::string& name);
+
+    /**
+     * @brief get a specific uniform from the shader. If it dosn't exist, throw an error
+     * 
+     * @param index the index of the 
+     * @return OGL_UniformInfo& 
+     */
+    OGL_UniformInfo& operator[](size_t index);
+
+    /**
+     * @brief update the positions of all uniforms
+     */
+    void recalculateUniforms();
+
+    /**
+     * @brief get a typed handle to a uniform. If the uniform dosn't exist, it is created. The handle stays valid for the lifetime of the shader
+     * 
+     * @tparam T the type of the uniform, like OGL_Mat4, OGL_Vec3 or float[4]
+     * @param name the name of the uniform in the shader
+     * @return OGL_Uniform<T> the handle to the uniform
+     */
+    template<typename T> OGL_Uniform<T> getUniform(std::string name)
+    {
+        //make sure the correct instance is bound
+        correctInstanceBinding()
+        //get the uniform, it is created if it dosn't exist
+        OGL_UniformInfo& ui = (*this)[name];
+        //store the layout of the type
+        ui.setType<T>();
+        //return the handle
+        return OGL_Uniform<T>{(size_t)(&ui - this->uniforms.data())};
+    }
+
+    /**
+     * @brief set the value of a uniform. It is uploaded the next time the shader is bound or the uniforms are uploaded
+     * 
+     * @tparam T the type of the uniform
+     * @param uniform the handle to the uniform
+     * @param value the new value
+     */
+    template<typename T> void setUniform(OGL_Uniform<T> uniform, const T& value)
+    {
+        //store the value
+        this->uniforms[uniform.index].template set<T>(value);
+    }
+
+    /**
+     * @brief get a reference to the value of a uniform. This marks the uniform as changed
+     * 
+     * @tparam T the type of the uniform
+     * @param uniform the handle to the uniform
+     * @return T& a reference to the value
+     */
+    template<typename T> T& getUniformRef(OGL_Uniform<T> uniform)
+    {
+        //return the reference
+        return this->uniforms[uniform.index].template getRef<T>();
+    }
+
+private:
+    /**
+     * @brief clean up the object after destruction
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief store the OpenGL shader
+     */
+    GLuint shader = 0;
+    /**
+     * @brief read the active uniforms from the program. Known uniforms keep they're index, new ones are added at the end
+     */
+    void reflectUniforms();
+
+    /**
+     * @brief store information about all the uniforms
+     */
+    std::vector<OGL_UniformInfo> uniforms;
+    /**
+     * @brief map the names of the uniforms to they're index
+     */
+    std::unordered_map<std::string, size_t> uniformLookup;
+};
+
+/**
+ * @brief handle uniform buffers to transfear read-only data to a shader
+ */
+class OGL_UniformBuffer : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new uniform buffer
+     */
+    OGL_UniformBuffer() = default;
+
+    /**
+     * @brief Move a uniform buffer. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the uniform buffer to move from
+     */
+    OGL_UniformBuffer(OGL_UniformBuffer&& other) = default;
+
+    /**
+     * @brief Move a uniform buffer into an existing one. The OpenGL object of this uniform buffer is destroyed first
+     * 
+     * @param other the uniform buffer to move from
+     * @return OGL_UniformBuffer& a reference to this uniform buffer
+     */
+    OGL_UniformBuffer& operator=(OGL_UniformBuffer&& other) = default;
+
+    /**
+     * @brief Destroy the uniform buffer
+     */
+    ~OGL_UniformBuffer() {this->release();}
+
+    /**
+     * @brief Construct a new uniform buffer
+     * 
+     * @param data the data for the buffer, or 0 to clear the data
+     * @param size the size of the data in bytes, or 0 to clear the data
+     * @param usage the usage hint for the storage of the buffer
+     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault
+     */
+    OGL_UniformBuffer(void* data, size_t size, GLenum usage = GL_DYNAMIC_DRAW);
+
+    /**
+     * @brief change the data that is stored in the buffer
+     * 
+     * @param data the data for the buffer, or 0 to clear the data
+     * @param size the size of the data in bytes, or 0 to clear the data
+     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault 
+     */
+    void updateData(void* data, size_t size);
+
+    /**
+     * @brief change the data that is stored in the buffer without copying it
+     * 
+     * @param data the new data for the buffer, it is moved into the buffer
+     */
+    void updateData(std::vector<uint8_t>&& data);
+
+    /**
+     * @brief add an element to the buffer
+     * 
+     * @tparam T the type of the new element
+     * @param element the element to add
+     */
+    template<typename T> void addElement(T element)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //store the element index of the data
+        size_t i = this->data.size();
+        //add the size of T elements
+        for (size_t i = 0; i < sizeof(T); ++i) {this->data.push_back(0);}
+        //copy the data
+        memcpy(this->data.data() + i, &element, sizeof(T));
+        //the new element must be uploaded
+        this->dirty.mark(i, sizeof(T));
+    }
+
+    /**
+     * @brief set an element in the element data
+     * 
+     * @tparam T the type of the element
+     * @param element the element to store
+     * @param index the index of the element in bytes
+     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     */
+    template<typename T> void setElement(T element, size_t index)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //check if the elment is in bounds
+        if ((index + sizeof(T)) > this->data.size())
+        {
+            //if not, throw an error
+            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
+            return;
+        }
+        //modify the element at the requested index
+        memcpy(this->data.data() + index, &element, sizeof(T));
+        //only the changed element must be uploaded
+        this->dirty.mark(index, sizeof(T));
+    }
+
+    /**
+     * @brief Get the Element at an specific index
+     * 
+     * @tparam T the type of the elment
+     * @param index the index to get the element from the data in bytes
+     * @return T the requested element
+     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     */
+    template<typename T> T getElement(size_t index)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //check if the elment is in bounds
+        if ((index + sizeof(T)) > this->data.size())
+        {
+            //if not, throw an error
+            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
+            return 0;
+        }
+        //return the requested data
+        return *((T*)((void*)this->data.data()));
+    }
+
+    /**
+     * @brief Get a pointer to an specific element
+     * 
+     * @tparam T the type of the object to get
+     * @param idx the index of the requested element in bytes
+     * @return T* a pointer to the requested element or NULL if the elment is out of bounds
+     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     */
+    template<typename T> T* getRefElement(size_t idx)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //check if the elment is in bounds
+        if ((idx+sizeof(T)) > this->data.size())
+        {
+            //if not, throw an error
+            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
+            return 0;
+        }
+
+        //the element may be changed through the pointer
+        this->dirty.mark(idx, sizeof(T));
+        //return the requested data
+        return ((T*)(this->data.data() + idx));
+    }
+
+    /**
+     * @brief upload the stored data to the GPU. Only modified bytes are uploaded, the storage is only re-allocated if the data dosn't fit into it. 
+     * In streaming mode the data is written behind the previous upload in the region of the current frame, the ring moves to the next region once per frame
+     */
+    void upload();
+
+    /**
+     * @brief switch the buffer to streaming mode. The buffer becomes a persistently mapped ring of immutable storage with one region per frame, 
+     * so uploading every frame never re-allocates the storage and only waits if the GPU is more than the amount of frames behind. 
+     * If immutable buffer storage is not supported, the buffer stays in the normal mode
+     * 
+     * @param capacity the maximum size of all uploads of a single frame in bytes. If they get bigger, the ring is re-allocated with the double size. 
+     * The old ring is kept until the GPU finished the draws that read from it
+     * @param frames the amount of frames in the ring, between 2 and OGL_UNIFORM_BUFFER_MAX_FRAMES
+     * @return true : the buffer is streamed now | 
+     * @return false : immutable buffer storage is not supported, the buffer stays in the normal mode
+     */
+    bool enableStreaming(size_t capacity, uint8_t frames = 3);
+
+    /**
+     * @brief get if the buffer is in streaming mode
+     * 
+     * @return true : the buffer is a persistently mapped ring | 
+     * @return false : the buffer re-uploads the data on every upload
+     */
+    inline bool isStreaming() {return this->streaming;}
+
+    /**
+     * @brief Set the usage hint for the storage of the buffer. It is used the next time the storage is allocated
+     * 
+     * @param usage the usage hint, like GL_STATIC_DRAW or GL_STREAM_DRAW
+     */
+    inline void setUsage(GLenum usage) {this->usage.setUsage(usage);}
+
+    /**
+     * @brief Get the usage tracker of the buffer to read the upload counters or enable the adaptive usage policy
+     * 
+     * @return OGL_BufferUsageTracker* a pointer to the usage tracker
+     */
+    inline OGL_BufferUsageTracker* getUsageTracker() {return &this->usage;}
+
+    /**
+     * @brief upload all changes and free the data on the CPU. Afterwards the buffer is only on the GPU and the data can't be accessed anymore until new data is set
+     */
+    void releaseCPUData();
+
+    /**
+     * @brief upload data directly from memory of the caller without storing it on the CPU. Afterwards the buffer is only on the GPU
+     * 
+     * @param data a pointer to the data
+     * @param size the size of the data in bytes
+     */
+    void uploadGPUOnly(const void* data, size_t size);
+
+    /**
+     * @brief get if the data was released on the CPU
+     * 
+     * @return true : the buffer is only on the GPU | 
+     * @return false : the buffer has a copy of the data on the CPU
+     */
+    inline bool isGPUOnly() {return this->gpuOnly;}
+
+    /**
+     * @brief bind this buffer for use in a shader. In streaming mode the data of the last upload is bound
+     * 
+     * @param unit the unit to bind to
+     */
+    void bind(uint8_t unit);
+
+    /**
+     * @brief bind a part of this buffer for use in a shader, like the data of a single object. In streaming mode the offset is in the data of the last upload
+     * 
+     * @param unit the unit to bind to
+     * @param offset the offset of the part in bytes, a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+     * @param size the size of the part in bytes
+     */
+    void bindRange(uint8_t unit, GLintptr offset, GLsizeiptr size);
+
+    /**
+     * @brief unbind all buffers
+     */
+    void unbind();
+
+    /**
+     * @brief clear all data stored in the buffer
+     */
+    inline void clear() {this->data.clear(); this->gpuOnly = false;}
+
+    /**
+     * @brief Get a reference to the own data
+     * 
+     * @return std::vector<uint8_t>* a pointer to the stored data
+     */
+    inline std::vector<uint8_t>* getDataRef() {if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");} this->dirty.markAll(); return &this->data;}
+
+    /**
+     * @brief Get the data stored in the buffer
+     * 
+     * @return const std::vector<uint8_t>& a reference to a vector of the data, structured in bytes
+     */
+    inline const std::vector<uint8_t>& getData() {if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");} return this->data;}
+
+private:
+    /**
+     * @brief handle the destruction of the object
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief create the ring of immutable storage for the streaming mode
+     * 
+     * @param capacity the minimum size of a single frame region in bytes
+     */
+    void createRing(size_t capacity);
+
+    /**
+     * @brief unmap the ring and delete the fences of the streaming mode
+     */
+    void releaseRing();
+
+    /**
+     * @brief keep the current ring until the GPU is done with it and place a fence after the commands that may read from it. The ring must be unmapped before
+     */
+    void retireRing();
+
+    /**
+     * @brief delete the retired ring if the GPU is done with it
+     * 
+     * @param wait true to wait for the GPU if it still reads from the retired ring, false to keep it until the next check
+     */
+    void freeRetiredRing(bool wait);
+
+    /**
+     * @brief store the data of the buffer
+     */
+    std::vector<uint8_t> data;
+    /**
+     * @brief store the buffer
+     */
+    GLuint ubo = 0;
+    /**
+     * @brief store the size of the storage on the GPU in bytes
+     */
+    size_t gpuSize = 0;
+    /**
+     * @brief store the ranges that where modified since the last upload
+     */
+    OGL_DirtyRanges dirty;
+    /**
+     * @brief store the usage hint and the upload counters
+     */
+    OGL_BufferUsageTracker usage = OGL_BufferUsageTracker(GL_DYNAMIC_DRAW);
+    /**
+     * @brief store if the CPU data was released and the buffer is only on the GPU
+     */
+    bool gpuOnly = false;
+    /**
+     * @brief store if the buffer is in streaming mode
+     */
+    bool streaming = false;
+    /**
+     * @brief store the mapped memory of the ring
+     */
+    uint8_t* mapped = 0;
+    /**
+     * @brief store the size of a single frame region of the ring in bytes
+     */
+    size_t frameSize = 0;
+    /**
+     * @brief store the amount of frame regions in the ring
+     */
+    uint8_t frameCount = 0;
+    /**
+     * @brief store the index of the frame region that is currently written and bound
+     */
+    uint8_t currentFrame = 0;
+    /**
+     * @brief store the frame of the instance the current region was first written in
+     */
+    uint64_t ringFrame = 0;
+    /**
+     * @brief store how many bytes of the current region are used by the uploads of this frame
+     */
+    size_t regionUsed = 0;
+    /**
+     * @brief store the offset of the data of the last upload in the buffer
+     */
+    size_t sliceOffset = 0;
+    /**
+     * @brief store the size of the data of the last upload, rounded up to the alignment
+     */
+    size_t sliceSize = 0;
+    /**
+     * @brief store the fences that say when the GPU finished reading a frame region
+     */
+    GLsync fences[OGL_UNIFORM_BUFFER_MAX_FRAMES] = {};
+    /**
+     * @brief store the ring the buffer grew out of until the GPU is done with it, or 0 if there is none
+     */
+    GLuint retiredUbo = 0;
+    /**
+     * @brief store the fence that says when the GPU finished reading the retired ring
+     */
+    GLsync retiredFence = 0;
+    /**
+     * @brief store a bit for each unit below 64 this buffer was bound to, so the units can follow the current frame region
+     */
+    uint64_t boundUnits = 0;
+
+};
+
+//say that a shader storage buffer will exist
+class OGL_ShaderStorageBuffer;
+
+/**
+ * @brief store a download of a shader storage buffer that waits for the GPU
+ */
+struct OGL_PendingDownload
+{
+    /**
+     * @brief store the staging buffer the data is copied to
+     */
+    GLuint staging = 0;
+    /**
+     * @brief store the size of the staging buffer in bytes
+     */
+    size_t stagingSize = 0;
+    /**
+     * @brief store the fence that is signaled when the copy is done
+     */
+    GLsync fence = 0;
+    /**
+     * @brief store the offset of the downloaded range in bytes
+     */
+    size_t offset = 0;
+    /**
+     * @brief store the size of the downloaded range in bytes
+     */
+    size_t size = 0;
+    /**
+     * @brief store the function to call when the data arrived, or 0 to call none
+     */
+    void (*callback)(OGL_ShaderStorageBuffer* buffer, size_t offset, size_t size, void* userData) = 0;
+    /**
+     * @brief store some abituary data for the user that is passed to the callback
+     */
+    void* userData = 0;
+};
+
+/**
+ * @brief handle shader storage buffers to transfear read / write data to the GPU and read it back
+ */
+class OGL_ShaderStorageBuffer : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new shader storage buffer
+     * 
+     */
+    OGL_ShaderStorageBuffer() = default;
+
+    /**
+     * @brief Move a shader storage buffer. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the shader storage buffer to move from
+     */
+    OGL_ShaderStorageBuffer(OGL_ShaderStorageBuffer&& other) = default;
+
+    /**
+     * @brief Move a shader storage buffer into an existing one. The OpenGL object of this shader storage buffer is destroyed first
+     * 
+     * @param other the shader storage buffer to move from
+     * @return OGL_ShaderStorageBuffer& a reference to this shader storage buffer
+     */
+    OGL_ShaderStorageBuffer& operator=(OGL_ShaderStorageBuffer&& other) = default;
+
+    /**
+     * @brief Destroy the shader storage buffer
+     */
+    ~OGL_ShaderStorageBuffer() {this->release();}
+
+    /**
+     * @brief Construct a new shader storage buffer
+     * 
+     * @param data the data for the buffer, or 0 to clear the data
+     * @param size the size of the data in bytes, or 0 to clear the data
+     * @param usage the usage hint for the storage of the buffer
+     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault 
+     */
+    OGL_ShaderStorageBuffer(void* data, size_t size, GLenum usage = GL_DYNAMIC_COPY);
+
+    /**
+     * @brief change the data that is stored in the buffer
+     * 
+     * @param data the data for the buffer, or 0 to clear the data
+     * @param size the size of the data in bytes, or 0 to clear the data
+     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault 
+     */
+    void updateData(void* data, size_t size);
+
+    /**
+     * @brief change the data that is stored in the buffer without copying it
+     * 
+     * @param data the new data for the buffer, it is moved into the buffer
+     */
+    void updateData(std::vector<uint8_t>&& data);
+
+    /**
+     * @brief clear all data stored in the buffer
+     */
+    inline void clear() {this->data.clear(); this->gpuOnly = false;}
+
+    /**
+     * @brief add an element to the buffer
+     * 
+     * @tparam T the type of the new element
+     * @param element the element to add
+     */
+    template<typename T> void addElement(T element)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //store the element index of the data
+        size_t i = this->data.size();
+        //add the size of T elements
+        for (size_t i = 0; i < sizeof(T); ++i) {this->data.push_back(0);}
+        //copy the data
+        memcpy(this->data.data() + i, &element, sizeof(T));
+        //the new element must be uploaded
+        this->dirty.mark(i, sizeof(T));
+    }
+
+    /**
+     * @brief set an element in the element data
+     * 
+     * @tparam T the type of the element
+     * @param element the element to store
+     * @param index the index of the element in bytes
+     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     */
+    template<typename T> void setElement(T element, size_t index)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //check if the elment is in bounds
+        if ((index + sizeof(T)) > this->data.size())
+        {
+            //if not, throw an error
+            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
+            return;
+        }
+        //modify the element at the requested index
+        memcpy(this->data.data() + index, &element, sizeof(T));
+        //only the changed element must be uploaded
+        this->dirty.mark(index, sizeof(T));
+    }
+
+    /**
+     * @brief Get the Element at an specific index
+     * 
+     * @tparam T the type of the elment
+     * @param index the index to get the element from the data in bytes
+     * @return T the requested element
+     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     */
+    template<typename T> T getElement(size_t index)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //check if the elment is in bounds
+        if ((index + sizeof(T)) > this->data.size())
+        {
+            //if not, throw an error
+            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
+            return 0;
+        }
+        //return the requested data
+        return *((T*)((void*)this->data.data()));
+    }
+
+    /**
+     * @brief Get a pointer to an specific element
+     * 
+     * @tparam T the type of the object to get
+     * @param idx the index of the requested element in bytes
+     * @return T* a pointer to the requested element or NULL if the elment is out of bounds
+     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     */
+    template<typename T> T* getRefElement(size_t idx)
+    {
+        //the data is only on the GPU
+        if (this->gpuOnly) {std::__throw_runtime_error("The CPU data of the buffer was released");}
+        //check if the elment is in bounds
+        if ((idx+sizeof(T)) > this->data.size())
+        {
+            //if not, throw an error
+            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
+            return 0;
+        }
+
+        //the element may be changed through the pointer
+        this->dirty.mark(idx, sizeof(T));
+        //return the requested data
+        return ((T*)(this->data.data() + idx));
+    }
+
+    /**
+     * @brief upload the stored data to the GPU. Only modified bytes are uploaded, the storage is only re-allocated if the data dosn't fit into it
+     */
+    void upload();
+
+    /**
+     * @brief donalod the data from the GPU and store it. If the buffer is only on the GPU, this brings the copy on the CPU back
+     */
+    void download();
+
+    /**
+     * @brief start downloading a range of the data from the GPU without waiting for it. The range is copied to a staging buffer on the GPU 
+     * and fenced, the data is stored and the callback is called by pollDownloads or waitDownloads once the GPU is done
+     * 
+     * @param offset the offset of the range in bytes
+     * @param size the size of the range in bytes
+     * @param callback the function to call when the data arrived, or 0 to call none
+     * @param userData some abituary data that is passed to the callback
+     * @warning if the range is not in bounds of the data, a runtime error is thrown
+     */
+    void downloadAsync(size_t offset, size_t size, void (*callback)(OGL_ShaderStorageBuffer* buffer, size_t offset, size_t size, void* userData) = 0, void* userData = 0);
+
+    /**
+     * @brief start downloading all data from the GPU without waiting for it
+     * 
+     * @param callback the function to call when the data arrived, or 0 to call none
+     * @param userData some abituary data that is passed to the callback
+     */
+    inline void downloadAsync(void (*callback)(OGL_ShaderStorageBuffer* buffer, size_t offset, size_t size, void* userData) = 0, void* userData = 0) 
+    {this->downloadAsync(0, this->data.size(), callback, userData);}
+
+    /**
+     * @brief store the data of all finished downloads and call they're callbacks. This never waits for the GPU
+     * @warning if waiting for the fence of a download fails, the download is removed without calling its callback and a runtime error is thrown
+     * 
+     * @return size_t the amount of downloads that are still pending
+     */
+    size_t pollDownloads();
+
+    /**
+     * @brief wait for all pending downloads, store they're data and call they're callbacks
+     * @warning if waiting for the fence of a download fails, a runtime error is thrown
+     */
+    void waitDownloads();
+
+    /**
+     * @brief get the amount of downloads that wait for the GPU
+     * 
+     * @return size_t the amount of pending downloads
+     */
+    inline size_t getPendingDownloadCount() {return this->downloads.size();}
+
+    /**
+     * @brief upload all changes and free the data on the CPU. Afterwards the buffer is only on the GPU and the data can't be accessed anymore. Call download to get a copy of the data back
+     */
+    void releaseCPUData();
+
+    /**
+     * @brief upload data directly from memory of the caller without storing it on the CPU. Afterwards the buffer is only on the GPU
+     * 
+     * @param data a pointer to the data
+     * @param size the size of the data in bytes
+     */
+    void uploadGPUOnly(const void* data, size_t size);
+
+    /**
+     * @brief get if the data was released on the CPU
+     * 
+     * @return true : the buffer is only on the GPU | 
+     * @return false : the buffer has a copy of the data on the CPU
+     */
+    inline bool isGPUOnly() {return this->gpuOnly;}
+
+    /**
+     * @brief Set the usage hint for the storage of the buffer. It is used the next time the storage is allocated
+     * 
+     * @param usage the usage hint, like GL_STATIC_DRAW or GL_STREAM_DRAW
+     */
+    inline void setUsage(GLenum usage) {this->usage.setUsage(usage);}
+
+    /**
+     * @brief Get the usage tracker of the buffer to read the upload counters or enable the adaptive usage policy
+     * 
+     * @return OGL_BufferUsageTracker* a pointer to the usage tracker
+     */
+    inline OGL_BufferUsageTracker* getUsageTracker() {return &this->usage;}
+
+    /**
+     * @brief bind this buffer for use in a shader
+     * 
+     * @param unit the unit to bind to
+     */
+    void bind(uint8_t unit);
+
+    /**
+     * @brief bind a part of this buffer for use in a shader
+     * 
+     * @param unit the unit to bind to
+     * @param offset the offset of the part in bytes, a multiple of GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+     * @param size the size of the part in bytes
+     */
+    void bindRange(uint8_t unit, GLintptr offset, GLsizeiptr size);
+
+    /**
+     * @brief unbind all buffers
+     */
+    void unbind();
+
+private:
+
+    /**
+     * @brief handle the destruction of the object
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief store the data for the buffer
+     */
+    std::vector<uint8_t> data;
+    /**
+     * @brief store the shader storage buffer object
+     */
+    GLuint ssbo = 0;
+    /**
+     * @brief store the size of the storage on the GPU in bytes
+     */
+    size_t gpuSize = 0;
+    /**
+     * @brief store the ranges that where modified since the last upload
+     */
+    OGL_DirtyRanges dirty;
+    /**
+     * @brief store the usage hint and the upload counters
+     */
+    OGL_BufferUsageTracker usage = OGL_BufferUsageTracker(GL_DYNAMIC_COPY);
+    /**
+     * @brief store if the CPU data was released and the buffer is only on the GPU
+     */
+    bool gpuOnly = false;
+    /**
+     * @brief store the downloads that wait for the GPU, oldest first
+     */
+    std::vector<OGL_PendingDownload> downloads;
+    /**
+     * @brief store staging buffers of finished downloads for re-use
+     */
+    std::vector<OGL_PendingDownload> freeStaging;
+};
+
+/**
+ * @brief turn the vector kernels of the pixel conversions on or off. With them turned off, the scalar kernels are used, like to compare the results
+ * 
+ * @param enabled true to use the best instruction set of the CPU | false to only use the scalar kernels
+ */
+void oglSetPixelSIMD(bool enabled);
+
+/**
+ * @brief get if the vector kernels of the pixel conversions may be used
+ * 
+ * @return true : the best instruction set of the CPU is used | 
+ * @return false : only the scalar kernels are used
+ */
+bool oglIsPixelSIMDEnabled();
+
+/**
+ * @brief expand 8-Bit RGB pixels to RGBA with an opaque alpha channel. Uses AVX2 or SSSE3 if the CPU supports it
+ * 
+ * @param src the RGB pixels
+ * @param dst the memory for the RGBA pixels, it must not overlap with the source
+ * @param count the amount of pixels
+ */
+void oglConvertRGBToRGBA(const uint8_t* src, uint8_t* dst, size_t count);
+
+/**
+ * @brief swap the red and blue channel of 8-Bit pixels with 4 channels, this converts between RGBA and BGRA. Uses AVX2 or SSE2 if the CPU supports it
+ * 
+ * @param src the source pixels
+ * @param dst the memory for the swizzled pixels, it may be the same as the source
+ * @param count the amount of pixels
+ */
+void oglSwizzleRedBlue(const uint8_t* src, uint8_t* dst, size_t count);
+
+/**
+ * @brief multiply the color channels of 8-Bit RGBA or BGRA pixels with their alpha channel. Uses AVX2 or SSE2 if the CPU supports it
+ * 
+ * @param pixels the pixels to premultiply in place
+ * @param count the amount of pixels
+ */
+void oglPremultiplyAlpha(uint8_t* pixels, size_t count);
+
+/**
+ * @brief convert normalized 8-Bit values to half floats between 0 and 1. Uses AVX2 and F16C if the CPU supports it
+ * 
+ * @param src the 8-Bit values
+ * @param dst the memory for the half floats
+ * @param count the amount of values
+ */
+void oglConvertU8ToHalf(const uint8_t* src, uint16_t* dst, size_t count);
+
+/**
+ * @brief get the size of an image in a block compressed format
+ * 
+ * @param internalFormat the compressed internal format, like GL_COMPRESSED_RGBA_BPTC_UNORM
+ * @param width the width of the image in pixels
+ * @param height the height of the image in pixels
+ * @return size_t the size of the image in bytes or 0 if the format is not a known block compressed format
+ */
+size_t oglGetCompressedImageSize(GLenum internalFormat, uint32_t width, uint32_t height);
+
+/**
+ * @brief get the amount of bytes a texel of an uncompressed internal format uses
+ * 
+ * @param internalFormat the internal format
+ * @return size_t the size of a texel in bytes, formats that are not known count as 4 bytes
+ */
+size_t oglGetTexelSize(GLenum internalFormat);
+
+/**
+ * @brief store decoded pixels and how OpenGL must read them. The pixels are owned by an SDL surface or by an own buffer
+ */
+struct OGL_PixelData
+{
+    /**
+     * @brief store the surface the pixels belong to, or 0 if they are stored in the buffer
+     */
+    SDL_Surface* surface = 0;
+    /**
+     * @brief store the own buffer of the pixels, or 0 if they belong to the surface. It is allocated with new[]
+     */
+    uint8_t* buffer = 0;
+    /**
+     * @brief store a pointer to the first pixel
+     */
+    void* pixels = 0;
+    /**
+     * @brief store the width in pixels
+     */
+    uint32_t width = 0;
+    /**
+     * @brief store the height in pixels
+     */
+    uint32_t height = 0;
+    /**
+     * @brief store the OpenGL format of the pixels, like GL_RGBA or GL_BGR
+     */
+    GLenum format = GL_RGBA;
+    /**
+     * @brief store the OpenGL type of the channels, like GL_UNSIGNED_BYTE or GL_HALF_FLOAT
+     */
+    GLenum type = GL_UNSIGNED_BYTE;
+    /**
+     * @brief store the value for GL_UNPACK_ALIGNMENT
+     */
+    GLint alignment = 4;
+    /**
+     * @brief store the value for GL_UNPACK_ROW_LENGTH, 0 if the rows are only padded to the alignment
+     */
+    GLint rowLength = 0;
+    /**
+     * @brief store if all pixels are opaque. Only checked if the internal format is selected automatically
+     */
+    bool opaque = false;
+    /**
+     * @brief store if all pixels are gray. Only checked if the internal format is selected automatically
+     */
+    bool gray = false;
+};
+
+/**
+ * @brief check if a surface can be uploaded without converting it and store how OpenGL must read it
+ * 
+ * @param surf the surface to check
+ * @param image the image to store the format, alignment and row length in
+ * @return true : the pixels can be uploaded in place | 
+ * @return false : the surface must be converted
+ */
+bool oglDescribeSurface(SDL_Surface* surf, OGL_PixelData& image);
+
+/**
+ * @brief store the state of image files that are decoded by a worker pool for a texture. It is freed by the last one using it, the texture or a worker
+ */
+struct OGL_TextureDecodeJob
+{
+    /**
+     * @brief store the paths to the files to decode
+     */
+    std::vector<std::string> files;
+    /**
+     * @brief store the decoded images, the pixels of an image are 0 if the file could not be decoded
+     */
+    std::vector<OGL_PixelData> images;
+    /**
+     * @brief store the amount of users of the job, the unfinished decode tasks and the texture
+     */
+    std::atomic<uint32_t> references{0};
+    /**
+     * @brief store the type of the texture to create
+     */
+    OGL_TextureType type = OGL_TEXTURE_2D;
+    /**
+     * @brief store the internal format of the texture to create
+     */
+    GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO;
+    /**
+     * @brief store if the alpha should be premultiplied while decoding
+     */
+    bool premultiply = false;
+};
+
+/**
+ * @brief store where the data of a texture came from, so it can be loaded again after the texture was evicted
+ */
+struct OGL_TextureSource
+{
+    /**
+     * @brief store the type of the source
+     */
+    OGL_TextureSourceType type = OGL_TEXTURE_SOURCE_NONE;
+    /**
+     * @brief store the paths to the files the data was loaded from
+     */
+    std::vector<std::string> files;
+    /**
+     * @brief store the type of the texture the files where loaded as
+     */
+    OGL_TextureType textureType = OGL_TEXTURE_2D;
+    /**
+     * @brief store the requested internal format, OGL_TEXTURE_FORMAT_AUTO if it was selected automatically
+     */
+    GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO;
+    /**
+     * @brief store the block format the files where compressed to
+     */
+    OGL_BlockFormat blockFormat = OGL_BLOCK_FORMAT_BC7;
+    /**
+     * @brief store the directory of the compression cache, empty if no cache was used
+     */
+    std::string cacheDir;
+};
+
+/**
+ * @brief handle textures for OpenGL
+ */
+class OGL_Texture : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new texture
+     */
+    OGL_Texture() = default;
+
+    /**
+     * @brief Move a texture. The new object takes over the OpenGL object, the name in the old one is set to 0. 
+     * Pointers to the old texture are not updated, framebuffers that still use it throw
+     * 
+     * @param other the texture to move from
+     */
+    OGL_Texture(OGL_Texture&& other);
+
+    /**
+     * @brief Move a texture into an existing one. The OpenGL object of this texture is destroyed first, the name in the old one is set to 0
+     * 
+     * @param other the texture to move from
+     * @return OGL_Texture& a reference to this texture
+     */
+    OGL_Texture& operator=(OGL_Texture&& other);
+
+    /**
+     * @brief Destroy the texture
+     */
+    ~OGL_Texture() {this->release();}
+
+    /**
+     * @brief Construct a new texture
+     * 
+     * @param type the type of the texture
+     * @param width the width of the texture
+     * @param height the height of the texture
+     * @param layers the amount of layers for 3D textures or the amount of samples for multisample textures
+     * @param internalFormat the internal format of the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     * @param format the format of the data that will be rendered or uploaded, used to select the internal format
+     * @param mipLevels the amount of mip levels to allocate, or OGL_TEXTURE_MIPS_FULL for a full mip chain. It is also used for later uploads to the texture
+     */
+    OGL_Texture(OGL_TextureType type, uint32_t width, uint32_t height, uint32_t layers, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO, GLenum format = GL_RGBA, uint32_t mipLevels = 1);
+
+    /**
+     * @brief Construct a new texture
+     * 
+     * @param texFile the path to the texture
+     * @param internalFormat the internal format for the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    OGL_Texture(const char* texFile, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief Construct a new texture
+     * 
+     * @param texFiles the texture files for the textures
+     * @param type the type of the texture
+     * @param internalFormat the internal format for the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    OGL_Texture(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief Construct a new texture
+     * 
+     * @param data the data for the texture
+     * @param width the width of the texture
+     * @param height the height of the texture
+     * @param format the format of the data
+     * @param type the type of the data
+     * @param internalFormat the internal format for the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    OGL_Texture(void* data, uint32_t width, uint32_t height, GLenum format, GLenum type, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief update the texture
+     * 
+     * @param texFile the texture file to read
+     * @param internalFormat the internal format of the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    void setTexture(const char* texFile, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief update the texture
+     * 
+     * @param texFiles the texture files to read from
+     * @param type the type of the texture
+     * @param internalFormat the internal format of the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    void setTexture(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief update the texture
+     * 
+     * @param data the data for the texture. The mip levels are generated from it. If it is 0, the texture gets a single level without data, 
+     * use setStorage for an empty texture with mip levels
+     * @param width the width of the texture
+     * @param height the height of the texture
+     * @param format the format of the data
+     * @param type the type of the data
+     * @param internalFormat the internal format for the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    void setTexture(void* data, uint32_t width, uint32_t height, GLenum format, GLenum type, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief update the texture in the background. The file is decoded on the worker pool of the instance, only the upload happens on this thread. 
+     * Until the texture is ready, the old texture stays in use
+     * 
+     * @param texFile the texture file to read
+     * @param internalFormat the internal format of the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    void setTextureAsync(const char* texFile, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief update the texture in the background. All files are decoded in parallel on the worker pool of the instance, only the upload happens on this thread. 
+     * Until the texture is ready, the old texture stays in use
+     * 
+     * @param texFiles the texture files to read from
+     * @param type the type of the texture
+     * @param internalFormat the internal format of the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     */
+    void setTextureAsync(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO);
+
+    /**
+     * @brief check if a background load finished. If all files are decoded, the data is uploaded. This never waits for the workers and never throws. 
+     * Pending loads are also checked when the texture is bound and when a window is flipped
+     * 
+     * @return true : no load is pending and the texture has it's data | 
+     * @return false : the files are still decoded, or the load failed (see hasLoadFailed)
+     */
+    bool isReady();
+
+    /**
+     * @brief wait until a background load finished and upload the data. If a file could not be decoded, the error is thrown
+     */
+    void waitReady();
+
+    /**
+     * @brief get if the last background load failed. The texture keeps the data it had before the load
+     * 
+     * @return true : a file could not be decoded, the error is stored | 
+     * @return false : the last load worked or is still pending
+     */
+    inline bool hasLoadFailed() {return !this->loadError.empty();}
+
+    /**
+     * @brief get the error of the last background load
+     * 
+     * @return const std::string& the error or an empty string if the load did not fail
+     */
+    inline const std::string& getLoadError() {return this->loadError;}
+
+    /**
+     * @brief say if the color of image files should be multiplied with their alpha while they are decoded. This is used by the next load of a file
+     * 
+     * @param premultiply true to premultiply the alpha, false to keep the colors
+     */
+    inline void setPremultiplyAlpha(bool premultiply) {this->premultiply = premultiply;}
+
+    /**
+     * @brief get if the color of image files is multiplied with their alpha while they are decoded
+     * 
+     * @return true : the alpha is premultiplied | 
+     * @return false : the colors are kept
+     */
+    inline bool getPremultiplyAlpha() {return this->premultiply;}
+
+    /**
+     * @brief allocate new storage for the texture without uploading data. The old storage is deleted
+     * 
+     * @param type the type of the texture
+     * @param width the width of the texture
+     * @param height the height of the texture
+     * @param layers the amount of layers for 3D textures or the amount of samples for multisample textures
+     * @param internalFormat the internal format of the texture, or OGL_TEXTURE_FORMAT_AUTO to select it with the format policy of the instance
+     * @param format the format of the data that will be rendered or uploaded, used to select the internal format
+     * @param mipLevels the amount of mip levels to allocate, or OGL_TEXTURE_MIPS_FULL for a full mip chain. Multisample textures always have a single level
+     */
+    void setStorage(OGL_TextureType type, uint32_t width, uint32_t height, uint32_t layers, GLenum internalFormat = OGL_TEXTURE_FORMAT_AUTO, GLenum format = GL_RGBA, uint32_t mipLevels = 1);
+
+    /**
+     * @brief set the amount of mip levels the storage of the next upload gets. Levels beyond a full mip chain are ignored. 
+     * Images loaded from files and data passed to setTexture get their mip levels filled automatically, setTexture without data always allocates a single level
+     * 
+     * @param mipLevels the amount of mip levels, or OGL_TEXTURE_MIPS_FULL for a full mip chain
+     */
+    inline void setMipLevels(uint32_t mipLevels) {this->mipLevels = mipLevels;}
+
+    /**
+     * @brief get the amount of mip levels the storage of the next upload gets
+     * 
+     * @return uint32_t the amount of mip levels, or OGL_TEXTURE_MIPS_FULL for a full mip chain
+     */
+    inline uint32_t getMipLevels() {return this->mipLevels;}
+
+    /**
+     * @brief get the amount of mip levels the current storage of the texture has
+     * 
+     * @return uint32_t the amount of allocated mip levels or 0 if the texture has no storage
+     */
+    inline uint32_t getLevelCount() {return this->levels;}
+
+    /**
+     * @brief get if the texture was evicted to fit into the texture memory budget of the instance. It is loaded again when it is bound
+     * 
+     * @return true : the texture lost its storage or its top mip levels | 
+     * @return false : the texture has all its data
+     */
+    inline bool isEvicted() {return this->evicted;}
+
+    /**
+     * @brief get where the data of the texture came from
+     * 
+     * @return const OGL_TextureSource& the source of the data, the type is OGL_TEXTURE_SOURCE_NONE if the texture can't be evicted
+     */
+    inline const OGL_TextureSource& getSource() {return this->source;}
+
+    /**
+     * @brief load a pre-compressed texture from a KTX, KTX2 or DDS file including all mip levels. The type is read from the file
+     * 
+     * @param file the path to the file
+     */
+    void setCompressedTexture(const char* file);
+
+    /**
+     * @brief upload a compressed image including all mip levels. Images with 6 faces become cubemaps, images with more than one layer texture arrays
+     * 
+     * @param image the compressed image
+     */
+    void setCompressedTexture(const OGL_CompressedImage& image);
+
+    /**
+     * @brief load an image file, compress it on the CPU with a full mip chain and upload it. The compressed image is cached on disk, so the compression runs only once
+     * 
+     * @param texFile the path to the image file
+     * @param format the block format to compress to. The sRGB variant is used if the format policy of the instance asks for it
+     * @param cacheDir the directory for the cache or 0 to not cache the image
+     */
+    void compressTexture(const char* texFile, OGL_BlockFormat format, const char* cacheDir = OGL_TEXTURE_CACHE_DIR);
+
+    /**
+     * @brief load image files, compress them on the CPU with a full mip chain and upload them. The compressed images are cached on disk, so the compression runs only once
+     * 
+     * @param texFiles the paths to the image files, one for 2D textures, 6 for cubemaps or one per layer for texture arrays
+     * @param type the type of the texture
+     * @param format the block format to compress to. The sRGB variant is used if the format policy of the instance asks for it
+     * @param cacheDir the directory for the cache or 0 to not cache the images
+     */
+    void compressTexture(std::vector<const char*> texFiles, OGL_TextureType type, OGL_BlockFormat format, const char* cacheDir = OGL_TEXTURE_CACHE_DIR);
+
+    /**
+     * @brief bind the texture to a specific unit. A finished background load is uploaded, an evicted texture is loaded again and the texture counts as used in this frame
+     * 
+     * @param unit the unit to bind to
+     */
+    void bind(uint8_t unit);
+
+    /**
+     * @brief get the texture ready for a draw without binding it. A finished background load is uploaded, an evicted texture is loaded again 
+     * and the texture counts as used in this frame for the texture memory budget. Used by bind and oglBindTextures
+     */
+    void prepareBind();
+
+    /**
+     * @brief unbind the texture from a specific unit
+     * 
+     * @param unit the unit to unbind from
+     */
+    void unbind(uint8_t unit);
+
+    /**
+     * @brief Set any OpenGL texture parameter for the texture. If the texture uses a sampler, the sampler overrides the filter and wrap parameters. 
+     * The parameter is stored and set again whenever the texture gets new storage, like after setTexture, setStorage or a reload after an eviction
+     * 
+     * @param parameter the parameter to set
+     * @param value the value for the parameter
+     */
+    void setTexParameter(GLenum parameter, GLenum value);
+
+    /**
+     * @brief set the sampler that is bound together with the texture. The sampler must stay alive while the texture uses it
+     * 
+     * @param sampler the sampler to use, or 0 to use the parameters of the texture
+     */
+    inline void setSampler(OGL_Sampler* sampler) {this->sampler = sampler;}
+
+    /**
+     * @brief get the sampler that is bound together with the texture
+     * 
+     * @return OGL_Sampler* the sampler, or 0 if the parameters of the texture are used
+     */
+    inline OGL_Sampler* getSampler() {return this->sampler;}
+
+    /**
+     * @brief fill all mip levels of the storage from the base level. Textures with a single level are left as they are
+     */
+    void createMipmap();
+
+    /**
+     * @brief Get the type of the texture
+     * 
+     * @return OGL_TextureType the texture type
+     */
+    inline OGL_TextureType getType() {return this->type;}
+
+    /**
+     * @brief Get the OpenGL texture
+     * 
+     * @return GLuint the OpenGL texture
+     */
+    inline GLuint getTexture() {return this->texture;}
+
+    /**
+     * @brief Get the generation of the storage of the texture. It changes every time the texture gets new storage, even if OpenGL re-uses the name of the old texture
+     * 
+     * @return uint64_t the generation of the storage, 0 if the texture never had storage
+     */
+    inline uint64_t getStorageGeneration() {return this->storageGeneration;}
+
+    /**
+     * @brief Get the width of the base level
+     * 
+     * @return uint32_t the width in pixels
+     */
+    inline uint32_t getWidth() {return this->width;}
+
+    /**
+     * @brief Get the height of the base level
+     * 
+     * @return uint32_t the height in pixels
+     */
+    inline uint32_t getHeight() {return this->height;}
+
+    /**
+     * @brief Get the amount of samples per pixel
+     * 
+     * @return uint32_t the amount of samples, 1 for textures that are not multisampled
+     */
+    inline uint32_t getSamples() {return this->samples;}
+
+    /**
+     * @brief Get the OpenGL target of the texture
+     * 
+     * @return GLenum the target, like GL_TEXTURE_2D, or 0 if the texture has no storage
+     */
+    inline GLenum getTarget() {return this->format;}
+
+    /**
+     * @brief Get the internal format the texture was created with. If it was selected automatically, this is the selected format
+     * 
+     * @return GLenum the internal format or 0 if the texture has no storage
+     */
+    inline GLenum getInternalFormat() {return this->internalFormat;}
+
+    /**
+     * @brief Get the amount of video memory the texture uses, including all mip levels
+     * 
+     * @return size_t the size of the storage in bytes
+     */
+    size_t getMemorySize();
+
+    /**
+     * @brief Get the amount of video memory the texture saves compared to storing the same levels as GL_RGBA32F, the old default format
+     * 
+     * @return size_t the saved memory in bytes
+     */
+    size_t getSavedMemory();
+
+private:
+    /**
+     * @brief take the OpenGL object and the state of an other texture and set its name to 0. Used by the move constructor and the move assignment
+     * 
+     * @param other the texture to take the state from
+     */
+    void takeState(OGL_Texture& other);
+
+    /**
+     * @brief bind the texture to unit 0 to change it without direct state access. This is not a use of the texture, so the texture memory budget is not updated
+     */
+    void bindForEdit();
+
+    /**
+     * @brief delete the object
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief upload a pending background load if it is done
+     * 
+     * @return true : no load is pending anymore | 
+     * @return false : the files are still decoded
+     */
+    virtual bool onUpdate() override;
+
+    /**
+     * @brief free video memory to fit into the texture memory budget of the instance. Only textures with a source can be evicted
+     * 
+     * @param mipsOnly true to only drop the biggest mip level, false to free the whole storage
+     * @return size_t the amount of freed memory in bytes, 0 if nothing could be freed
+     */
+    virtual size_t onEvict(bool mipsOnly) override;
+
+    /**
+     * @brief load the data of an evicted texture again from its source. Textures that still have their smaller mip levels stay in use while image files are decoded in the background. 
+     * The new storage gets the parameters set with setTexParameter again
+     */
+    void reload();
+
+    /**
+     * @brief store where the data of the texture came from
+     * 
+     * @param type the type of the source
+     * @param files the paths to the files the data was loaded from
+     * @param textureType the type of the texture the files where loaded as
+     * @param internalFormat the requested internal format
+     * @param blockFormat the block format the files where compressed to
+     * @param cacheDir the directory of the compression cache or 0 if no cache was used
+     */
+    void setSource(OGL_TextureSourceType type, const std::vector<const char*>& files, OGL_TextureType textureType, GLenum internalFormat, OGL_BlockFormat blockFormat = OGL_BLOCK_FORMAT_BC7, const char* cacheDir = 0);
+
+    /**
+     * @brief upload decoded images to the texture
+     * 
+     * @param images the images, one for 2D textures, 6 for cubemaps or one per layer for texture arrays. They are repacked if the selected format needs it
+     * @param type the type of the texture
+     * @param internalFormat the internal format of the texture, or OGL_TEXTURE_FORMAT_AUTO to select it from the images
+     */
+    void uploadImages(std::vector<OGL_PixelData>& images, OGL_TextureType type, GLenum internalFormat);
+
+    /**
+     * @brief set the swizzle of the texture, so one and two channel formats for gray images are still read as gray. The calls are skipped if the swizzle does not change
+     * 
+     * @param gray true to read the red channel as gray and the green channel of two channel formats as alpha, false to read the channels as they are
+     */
+    void applySwizzle(bool gray);
+
+    /**
+     * @brief set a texture parameter on the current OpenGL texture without storing it
+     * 
+     * @param parameter the parameter to set
+     * @param value the value for the parameter
+     */
+    void applyTexParameter(GLenum parameter, GLenum value);
+
+    /**
+     * @brief set all parameters stored by setTexParameter on the current OpenGL texture. Used after new storage was allocated, because a new texture has the default parameters
+     */
+    void replayTexParameters();
+
+    /**
+     * @brief get the amount of texels in all mip levels of the texture, including all faces and layers
+     * 
+     * @return size_t the amount of texels
+     */
+    size_t getTexelCount();
+
+    /**
+     * @brief stop waiting for a pending background load. The decoded data is freed by the workers
+     */
+    void abandonJob();
+
+    /**
+     * @brief create a new OpenGL texture for the target. The old texture is deleted, because immutable storage can't be re-allocated
+     * 
+     * @param target the texture target
+     */
+    void prepareTexture(GLenum target);
+
+    /**
+     * @brief create a new OpenGL texture and allocate immutable storage for it. The size, layers and internal format must be stored before. 
+     * The stored texture parameters are set on the new texture. Without direct state access, the texture stays bound to unit 0
+     * 
+     * @param target the texture target
+     * @param mipLevels the amount of mip levels, or OGL_TEXTURE_MIPS_FULL for a full mip chain. It is clamped to a full mip chain
+     */
+    void allocateStorage(GLenum target, uint32_t mipLevels);
+
+    /**
+     * @brief store the type of the texture
+     */
+    OGL_TextureType type;
+    /**
+     * @brief store the internal format depending on type
+     */
+    GLenum format = 0;
+    /**
+     * @brief store the OpenGL texture
+     */
+    GLuint texture = 0;
+    /**
+     * @brief store the width of the texture in pixels
+     */
+    uint32_t width = 0;
+    /**
+     * @brief store the height of the texture in pixels
+     */
+    uint32_t height = 0;
+    /**
+     * @brief store the amount of layers in the texture
+     */
+    uint32_t layers = 0;
+    /**
+     * @brief store the amount of samples per pixel of multisample textures
+     */
+    uint32_t samples = 1;
+    /**
+     * @brief store the amount of mip levels the storage of the next upload gets
+     */
+    uint32_t mipLevels = OGL_TEXTURE_MIPS_FULL;
+    /**
+     * @brief store the amount of mip levels of the current storage
+     */
+    uint32_t levels = 0;
+    /**
+     * @brief store the generation of the current storage, it is unique across all textures
+     */
+    uint64_t storageGeneration = 0;
+    /**
+     * @brief store the pending background load, or 0 if none is pending
+     */
+    OGL_TextureDecodeJob* job = 0;
+    /**
+     * @brief store if the color of image files is multiplied with their alpha while they are decoded
+     */
+    bool premultiply = false;
+    /**
+     * @brief store the internal format of the storage
+     */
+    GLenum internalFormat = 0;
+    /**
+     * @brief store if the texture is swizzled to read a one or two channel format as gray
+     */
+    bool graySwizzle = false;
+    /**
+     * @brief store the sampler that is bound together with the texture, or 0 to use the parameters of the texture
+     */
+    OGL_Sampler* sampler = 0;
+    /**
+     * @brief store where the data of the texture came from
+     */
+    OGL_TextureSource source;
+    /**
+     * @brief store if the texture was evicted and must be loaded again when it is bound
+     */
+    bool evicted = false;
+    /**
+     * @brief store the error of the last background load, or an empty string if it did not fail
+     */
+    std::string loadError;
+    /**
+     * @brief store the parameters set by setTexParameter with they're values, so they survive new storage
+     */
+    std::vector<std::pair<GLenum, GLenum>> texParameters;
+};
+
+/**
+ * @brief handle storage for framebuffer attachments that is only rendered to and never sampled, like most depth buffers
+ */
+class OGL_Renderbuffer : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new renderbuffer
+     */
+    OGL_Renderbuffer() = default;
+
+    /**
+     * @brief Move a renderbuffer. The new object takes over the OpenGL object, the name in the old one is set to 0. 
+     * Pointers to the old renderbuffer are not updated, framebuffers that still use it throw
+     * 
+     * @param other the renderbuffer to move from
+     */
+    OGL_Renderbuffer(OGL_Renderbuffer&& other);
+
+    /**
+     * @brief Move a renderbuffer into an existing one. The OpenGL object of this renderbuffer is destroyed first, the name in the old one is set to 0
+     * 
+     * @param other the renderbuffer to move from
+     * @return OGL_Renderbuffer& a reference to this renderbuffer
+     */
+    OGL_Renderbuffer& operator=(OGL_Renderbuffer&& other);
+
+    /**
+     * @brief Destroy the renderbuffer
+     */
+    ~OGL_Renderbuffer() {this->release();}
+
+    /**
+     * @brief Construct a new renderbuffer
+     * 
+     * @param width the width of the renderbuffer in pixels
+     * @param height the height of the renderbuffer in pixels
+     * @param internalFormat the internal format, like GL_DEPTH_COMPONENT24 or GL_DEPTH24_STENCIL8
+     * @param samples the amount of samples per pixel, 1 for a renderbuffer that is not multisampled
+     */
+    OGL_Renderbuffer(uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples = 1);
+
+    /**
+     * @brief allocate new storage for the renderbuffer. The OpenGL renderbuffer stays the same, so framebuffers don't need to attach it again
+     * 
+     * @param width the width of the renderbuffer in pixels
+     * @param height the height of the renderbuffer in pixels
+     * @param internalFormat the internal format, like GL_DEPTH_COMPONENT24 or GL_DEPTH24_STENCIL8
+     * @param samples the amount of samples per pixel, 1 for a renderbuffer that is not multisampled
+     */
+    void setStorage(uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples = 1);
+
+    /**
+     * @brief change the size of the renderbuffer and keep the format and the amount of samples
+     * 
+     * @param width the new width in pixels
+     * @param height the new height in pixels
+     */
+    inline void resize(uint32_t width, uint32_t height) {this->setStorage(width, height, this->internalFormat, this->samples);}
+
+    /**
+     * @brief Get the OpenGL renderbuffer
+     * 
+     * @return GLuint the OpenGL renderbuffer
+     */
+    inline GLuint getRenderbuffer() {return this->renderbuffer;}
+
+    /**
+     * @brief Get the width of the renderbuffer
+     * 
+     * @return uint32_t the width in pixels
+     */
+    inline uint32_t getWidth() {return this->width;}
+
+    /**
+     * @brief Get the height of the renderbuffer
+     * 
+     * @return uint32_t the height in pixels
+     */
+    inline uint32_t getHeight() {return this->height;}
+
+    /**
+     * @brief Get the internal format of the renderbuffer
+     * 
+     * @return GLenum the internal format
+     */
+    inline GLenum getInternalFormat() {return this->internalFormat;}
+
+    /**
+     * @brief Get the amount of samples per pixel
+     * 
+     * @return uint32_t the amount of samples, 1 for renderbuffers that are not multisampled
+     */
+    inline uint32_t getSamples() {return this->samples;}
+
+    /**
+     * @brief Get the amount of video memory the renderbuffer uses, including all samples
+     * 
+     * @return size_t the size in bytes
+     */
+    size_t getMemorySize();
+
+private:
+    /**
+     * @brief take the OpenGL object and the state of an other renderbuffer and set its name to 0. Used by the move constructor and the move assignment
+     * 
+     * @param other the renderbuffer to take the state from
+     */
+    void takeState(OGL_Renderbuffer& other);
+
+    virtual void onDestroy() override;
+
+    /**
+     * @brief store the OpenGL renderbuffer
+     */
+    GLuint renderbuffer = 0;
+    /**
+     * @brief store the width in pixels
+     */
+    uint32_t width = 0;
+    /**
+     * @brief store the height in pixels
+     */
+    uint32_t height = 0;
+    /**
+     * @brief store the internal format
+     */
+    GLenum internalFormat = 0;
+    /**
+     * @brief store the amount of samples per pixel
+     */
+    uint32_t samples = 1;
+};
+
+/**
+ * @brief store the information about a single color attachment
+ */
+struct OGL_FramebufferAttachment
+{
+    /**
+     * @brief store a pointer to the texture to use
+     */
+    OGL_Texture* texture = 0;
+    /**
+     * @brief store the id of the attachment unit
+     */
+    uint8_t attachmentID = 0;
+    /**
+     * @brief store the type of attachment
+     */
+    OGL_FramebufferAttachmentType type = OGL_COLOR_ATTACHMENT;
+    /**
+     * @brief for layers and cube maps, selecte the layer to use
+     */
+    uint8_t layerSelect = 0;    /**
+     * @brief store a renderbuffer to use instead of the texture, or 0 to attach the texture
+     */
+    OGL_Renderbuffer* renderbuffer = 0;
+};
+
+/**
+ * @brief handle multiple framebuffers
+ */
+class OGL_Framebuffer : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new framebuffer
+     */
+    OGL_Framebuffer() = default;
+
+    /**
+     * @brief Move a framebuffer. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the framebuffer to move from
+     */
+    OGL_Framebuffer(OGL_Framebuffer&& other) = default;
+
+    /**
+     * @brief Move a framebuffer into an existing one. The OpenGL object of this framebuffer is destroyed first
+     * 
+     * @param other the framebuffer to move from
+     * @return OGL_Framebuffer& a reference to this framebuffer
+     */
+    OGL_Framebuffer& operator=(OGL_Framebuffer&& other) = default;
+
+    /**
+     * @brief Destroy the framebuffer
+     */
+    ~OGL_Framebuffer() {this->release();}
+
+    /**
+     * @brief Construct a new framebuffer
+     * 
+     * @param attachments the attachments for the framebuffer
+     */
+    OGL_Framebuffer(std::vector<OGL_FramebufferAttachment> attachments);
+
+    /**
+     * @brief update all the attachments bound to the framebuffer and draw to all color attachments. This happens automatically when the framebuffer is bound and an attachment changed
+     */
+    void updateAttachmentBindings();
+
+    /**
+     * @brief access a specific framebuffer attachment
+     * @warning this operator dose not check if the element belongs to the framebuffer. If the index is out of range, this may lead to undefined behaviour
+     * 
+     * @param index the index of that attachment
+     * @return OGL_FramebufferAttachment& a reference of the attachment
+     */
+    inline OGL_FramebufferAttachment& operator[](size_t index) {return this->attachments[index];}
+
+    /**
+     * @brief get the amount of attachments of the framebuffer
+     * 
+     * @return size_t the amount of attachments
+     */
+    inline size_t getAttachmentCount() {return this->attachments.size();}
+
+    /**
+     * @brief get the OpenGL attachment point of an attachment, like GL_COLOR_ATTACHMENT1 or GL_DEPTH_ATTACHMENT
+     * 
+     * @param index the index of the attachment
+     * @return GLenum the attachment point
+     */
+    GLenum getAttachmentPoint(size_t index);
+
+    /**
+     * @brief Get the OpenGL framebuffer
+     * 
+     * @return GLuint the OpenGL framebuffer
+     */
+    inline GLuint getFramebuffer() {return this->framebuffer;}
+
+    /**
+     * @brief bind the framebuffer. If an attached texture got new storage or an attachment was replaced, the attachments are updated first
+     * 
+     * @param target the framebuffer type to bind to
+     */
+    void bind(GLenum target = GL_FRAMEBUFFER);
+
+    /**
+     * @brief copy a rectangle of pixels to another framebuffer. Copying from a multisampled framebuffer to a framebuffer that is not multisampled resolves the samples
+     * 
+     * @param target the framebuffer to copy to, or 0 to copy to the default framebuffer
+     * @param srcX the x position of the rectangle to read in pixels
+     * @param srcY the y position of the rectangle to read in pixels
+     * @param srcWidth the width of the rectangle to read in pixels
+     * @param srcHeight the height of the rectangle to read in pixels
+     * @param dstX the x position of the rectangle to write in pixels
+     * @param dstY the y position of the rectangle to write in pixels
+     * @param dstWidth the width of the rectangle to write in pixels
+     * @param dstHeight the height of the rectangle to write in pixels
+     * @param mask the buffers to copy, a combination of GL_COLOR_BUFFER_BIT, GL_DEPTH_BUFFER_BIT and GL_STENCIL_BUFFER_BIT
+     * @param filter the filter used if the rectangles have different sizes, GL_NEAREST or GL_LINEAR. Depth and stencil must use GL_NEAREST
+     */
+    void blit(OGL_Framebuffer* target, GLint srcX, GLint srcY, GLint srcWidth, GLint srcHeight, GLint dstX, GLint dstY, GLint dstWidth, GLint dstHeight, GLbitfield mask = GL_COLOR_BUFFER_BIT, GLenum filter = GL_NEAREST);
+
+    /**
+     * @brief resolve the samples of a multisampled framebuffer into another framebuffer of the same size. The colors are read from the first color attachment and written to all color attachments of the target
+     * 
+     * @param target the framebuffer to resolve into, or 0 to resolve into the default framebuffer
+     * @param width the width of the area to resolve in pixels
+     * @param height the height of the area to resolve in pixels
+     * @param mask the buffers to resolve, a combination of GL_COLOR_BUFFER_BIT, GL_DEPTH_BUFFER_BIT and GL_STENCIL_BUFFER_BIT
+     */
+    inline void resolve(OGL_Framebuffer* target, GLint width, GLint height, GLbitfield mask = GL_COLOR_BUFFER_BIT) {this->blit(target, 0, 0, width, height, 0, 0, width, height, mask, GL_NEAREST);}
+
+    /**
+     * @brief unbind the framebuffer
+     * 
+     * @param target the framebuffer type to unbind from
+     */
+    void unbind(GLenum target = GL_FRAMEBUFFER);
+
+private:
+    virtual void onDestroy() override;
+
+    /**
+     * @brief check if the attachments changed since they where bound to the framebuffer
+     * 
+     * @return true : an attached texture got new storage or an attachment was replaced | 
+     * @return false : the framebuffer is up to date
+     */
+    bool attachmentsChanged();
+
+    GLuint framebuffer;
+
+    std::vector<OGL_FramebufferAttachment> attachments;
+
+    /**
+     * @brief store the OpenGL textures or renderbuffers that are bound to the framebuffer, one for each attachment
+     */
+    std::vector<GLuint> boundTextures;
+
+    /**
+     * @brief store the storage generation of the textures that are bound to the framebuffer, one for each attachment. OpenGL may give new storage the name of the old texture, so the name alone can't tell if the storage changed
+     */
+    std::vector<uint64_t> boundGenerations;
+};
+
+class OGL_ComputeShader : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new compute shader
+     */
+    OGL_ComputeShader() = default;
+
+    /**
+     * @brief Move a compute shader. The new object takes over the OpenGL object, the old one can't be used anymore
+     * 
+     * @param other the compute shader to move from
+     */
+    OGL_ComputeShader(OGL_ComputeShader&& other) = default;
+
+    /**
+     * @brief Move a compute shader into an existing one. The OpenGL object of this compute shader is destroyed first
+     * 
+     * @param other the compute shader to move from
+     * @return OGL_ComputeShader& a reference to this compute shader
+     */
+    OGL_ComputeShader& operator=(OGL_ComputeShader&& other) = default;
+
+    /**
+     * @brief Destroy the compute shader
+     */
+    ~OGL_ComputeShader() {this->release();}
+
+    OGL_ComputeShader(const char* input, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
+
+
+    /**
+     * @brief change this shader to a new shader
+     * 
+     * @param cs the compute shader information, in the format specified by type
+     * @param type the type the data is given in, can be inputed as file, source or binary
+     */
+    void recompileShader(std::string cs, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
+
+    /**
+     * @brief Get the Compiled Shader on the GPU
+     * 
+     * @return uint32_t the compiled OpenGL shader on the GPU
+     */
+    inline uint32_t getCompiledShader() {return this->shader;}
+
+    /**
+     * @brief bind the shader
+     */
+    void bind();
+
+    /**
+     * @brief unbind the shader
+     */
+    void unbind();
+
+    /**
+     * @brief upload the values of all uniforms to the shader. With direct state access this dose not bind the shader
+     */
+    void uploadUniforms();
+
+    /**
+     * @brief Set the values of uniforms by name. Uniforms that are allready known, like the reflected ones, keep they're index, location and layout and only take the value. 
+     * Unknown uniforms are added at the end, so use getUniformIndex to find the index of a uniform
+     * 
+     * @param uniforms the uniforms for the shader
+     */
+    void setUniforms(std::vector<OGL_UniformInfo> uniforms);
+
+    /**
+     * @brief Get a pointer to all stored uniforms
+     * 
+     * @return std::vector<OGL_UniformInfo>* a pointer to the internal vector of uniforms
+     */
+    inline std::vector<OGL_UniformInfo>* getUniformPtr() {return &this->uniforms;}
+
+    /**
+     * @brief Get the amount of stored uniforms
+     * 
+     * @return size_t the amount of uniforms
+     */
+    inline size_t getUniformCount() {return this->uniforms.size();}
+
+    /**
+     * @brief get a specific uniform from the shader. If it dosn't exist, create it
+     * 
+     * @param name the name of the uniform
+     * @return OGL_UniformInfo& a reference to the uniform
+     */
+    OGL_UniformInfo& operator[](const std::string& name);
+
+    /**
+     * @brief get the index of a uniform. All active uniforms of the program are known after compilation and the index stays the same, even if the shader is re-compiled
+     * 
+     * @param name the name of the uniform
+     * @return size_t the index of the uniform or -1 if it dosn't exist
+     */
+    size_t getUniformIndex(const std::string& name);
+
+    /**
+     * @brief get the index of a uniform and add it if it dosn't exist. Uniforms that where not reflected ask OpenGL for they're location, 
+     * like elements of arrays that are requested as name[1]
+     * 
+     * @param name the name of the uniform
+     * @return size_t the index of the uniform
+     */
+    size_t addUniform(const std::string& name);
+
+    /**
+     * @brief get a specific uniform from the shader. If it dosn't exist, throw an error
+     * 
+     * @param index the index of the 
+     * @return OGL_UniformInfo& 
+     */
+    OGL_UniformInfo& operator[](size_t index);
+
+    /**
+     * @brief update the positions of all uniforms
+     */
+    void recalculateUniforms();
 
     /**
-     * @brief Get the alpha component of the clear color
+     * @brief get a typed handle to a uniform. If the uniform dosn't exist, it is created. The handle stays valid for the lifetime of the shader
      * 
-     * @return float the alpha component of the clear color
+     * @tparam T the type of the uniform, like OGL_Mat4, OGL_Vec3 or float[4]
+     * @param name the name of the uniform in the shader
+     * @return OGL_Uniform<T> the handle to the uniform
+     */
+    template<typename T> OGL_Uniform<T> getUniform(std::string name)
+    {
+        //make sure the correct instance is bound
+        correctInstanceBinding()
+        //get the uniform, it is created if it dosn't exist
+        OGL_UniformInfo& ui = (*this)[name];
+        //store the layout of the type
+        ui.setType<T>();
+        //return the handle
+        return OGL_Uniform<T>{(size_t)(&ui - this->uniforms.data())};
+    }
+
+    /**
+     * @brief set the value of a uniform. It is uploaded the next time the shader is bound or the uniforms are uploaded
+     * 
+     * @tparam T the type of the uniform
+     * @param uniform the handle to the uniform
+     * @param value the new value
+     */
+    template<typename T> void setUniform(OGL_Uniform<T> uniform, const T& value)
+    {
+        //store the value
+        this->uniforms[uniform.index].template set<T>(value);
+    }
+
+    /**
+     * @brief get a reference to the value of a uniform. This marks the uniform as changed
+     * 
+     * @tparam T the type of the uniform
+     * @param uniform the handle to the uniform
+     * @return T& a reference to the value
+     */
+    template<typename T> T& getUniformRef(OGL_Uniform<T> uniform)
+    {
+        //return the reference
+        return this->uniforms[uniform.index].template getRef<T>();
+    }
+
+private: 
+    /**
+     * @brief clean up the object after destruction
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief store the OpenGL shader
+     */
+    GLuint shader = 0;
+    /**
+     * @brief read the active uniforms from the program. Known uniforms keep they're index, new ones are added at the end
+     */
+    void reflectUniforms();
+
+    /**
+     * @brief store information about all the uniforms
+     */
+    std::vector<OGL_UniformInfo> uniforms;
+    /**
+     * @brief map the names of the uniforms to they're index
+     */
+    std::unordered_map<std::string, size_t> uniformLookup;
+};
+
+/**
+ * @brief run tasks on a fixed amount of background threads. The tasks are run in the order they where added
+ */
+class OGL_WorkerPool
+{
+public:
+    /**
+     * @brief Construct a new worker pool without threads. Tasks are run instantly on the calling thread
+     */
+    OGL_WorkerPool() = default;
+
+    /**
+     * @brief Construct a new worker pool
+     * 
+     * @param threads the amount of threads to start
+     */
+    OGL_WorkerPool(uint32_t threads);
+
+    /**
+     * @brief Destroy the worker pool. All queued tasks are finished before the threads stop
+     */
+    ~OGL_WorkerPool();
+
+    /**
+     * @brief add a task to the queue
+     * 
+     * @param func the function to run on a worker thread
+     * @param data some abituary data that is passed to the function
+     * @param index an index that is passed to the function
+     */
+    void push(void (*func)(void* data, size_t index), void* data, size_t index = 0);
+
+    /**
+     * @brief Get the amount of threads
+     * 
+     * @return size_t the amount of worker threads
+     */
+    inline size_t getThreadCount() {return this->threads.size();}
+
+private:
+    /**
+     * @brief the loop of a worker thread, it runs tasks until the pool is stopped and the queue is empty
+     */
+    void work();
+
+    /**
+     * @brief store the worker threads
+     */
+    std::vector<std::thread> threads;
+    /**
+     * @brief store the queued tasks
+     */
+    std::deque<OGL_WorkerTask> tasks;
+    /**
+     * @brief store the mutex that protects the queue
+     */
+    std::mutex mutex;
+    /**
+     * @brief store the signal that wakes up the workers
+     */
+    std::condition_variable signal;
+    /**
+     * @brief store if the workers should stop
+     */
+    bool stop = false;
+};
+
+/**
+ * @brief store where a mip level is stored in a compressed image
+ */
+struct OGL_CompressedLevel
+{
+    /**
+     * @brief store the offset of the level in the data in bytes
+     */
+    size_t offset = 0;
+    /**
+     * @brief store the size of the level in bytes, including all layers and faces
+     */
+    size_t size = 0;
+    /**
+     * @brief store the width of the level in pixels
+     */
+    uint32_t width = 0;
+    /**
+     * @brief store the height of the level in pixels
+     */
+    uint32_t height = 0;
+};
+
+/**
+ * @brief store a block compressed image with all of its mip levels, layers and faces. It can be read from and written to KTX files and read from KTX2 and DDS files. The images of a level are stored layer by layer, each with all of its faces
+ */
+class OGL_CompressedImage
+{
+public:
+    /**
+     * @brief Construct a new empty compressed image
+     */
+    OGL_CompressedImage() = default;
+
+    /**
+     * @brief Construct a new compressed image from a file
+     * 
+     * @param file the path to a KTX, KTX2 or DDS file
+     */
+    OGL_CompressedImage(const char* file);
+
+    /**
+     * @brief Destroy the compressed image
+     */
+    ~OGL_CompressedImage() = default;
+
+    /**
+     * @brief load the image from a file. The type of the file is detected from its content
+     * 
+     * @param file the path to a KTX, KTX2 or DDS file
+     */
+    void load(const char* file);
+
+    /**
+     * @brief write the image to a KTX file
+     * 
+     * @param file the path to the file
+     * @return true : the file was written | 
+     * @return false : the file could not be written
+     */
+    bool save(const char* file) const;
+
+    /**
+     * @brief compress 8-Bit RGBA pixels on the CPU. This replaces the content of the image
+     * 
+     * @param pixels the tightly packed RGBA pixels
+     * @param width the width of the image in pixels
+     * @param height the height of the image in pixels
+     * @param format the block format to compress to
+     * @param srgb say if the sRGB variant of the format should be used
+     * @param mipmaps say if a full mip chain should be created and compressed
+     */
+    void compress(const uint8_t* pixels, uint32_t width, uint32_t height, OGL_BlockFormat format, bool srgb = false, bool mipmaps = true);
+
+    /**
+     * @brief add the layers of an other image to the end of this image. Both images need the same format, size and amount of levels and faces
+     * 
+     * @param other the image to add
+     */
+    void addLayers(const OGL_CompressedImage& other);
+
+    /**
+     * @brief turn an image with 6 layers of single faces into a cubemap
+     */
+    void makeCubemap();
+
+    /**
+     * @brief Get the compressed internal format
+     * 
+     * @return GLenum the internal format or 0 if the image is empty
+     */
+    inline GLenum getInternalFormat() const {return this->internalFormat;}
+
+    /**
+     * @brief Get the width of the first level
+     * 
+     * @return uint32_t the width in pixels
+     */
+    inline uint32_t getWidth() const {return this->width;}
+
+    /**
+     * @brief Get the height of the first level
+     * 
+     * @return uint32_t the height in pixels
+     */
+    inline uint32_t getHeight() const {return this->height;}
+
+    /**
+     * @brief Get the amount of layers
+     * 
+     * @return uint32_t the amount of layers, 1 if the image is not an array
+     */
+    inline uint32_t getLayerCount() const {return this->layers;}
+
+    /**
+     * @brief Get the amount of faces
+     * 
+     * @return uint32_t 6 for cubemaps, else 1
+     */
+    inline uint32_t getFaceCount() const {return this->faces;}
+
+    /**
+     * @brief Get the amount of mip levels
+     * 
+     * @return uint32_t the amount of levels
+     */
+    inline uint32_t getLevelCount() const {return this->levels.size();}
+
+    /**
+     * @brief Get where a mip level is stored
+     * @warning the function does not check if the level exists
+     * 
+     * @param level the index of the level
+     * @return const OGL_CompressedLevel& the location and size of the level
+     */
+    inline const OGL_CompressedLevel& getLevel(uint32_t level) const {return this->levels[level];}
+
+    /**
+     * @brief Get the data of a mip level
+     * @warning the function does not check if the level exists
+     * 
+     * @param level the index of the level
+     * @return const uint8_t* a pointer to the first image of the level
+     */
+    inline const uint8_t* getLevelData(uint32_t level) const {return this->data.data() + this->levels[level].offset;}
+
+private:
+    /**
+     * @brief set the format and size of the image and allocate the data for all levels
+     * 
+     * @param internalFormat the compressed internal format
+     * @param width the width of the first level
+     * @param height the height of the first level
+     * @param levelCount the amount of levels
+     * @param layerCount the amount of layers
+     * @param faceCount the amount of faces
+     */
+    void allocate(GLenum internalFormat, uint32_t width, uint32_t height, uint32_t levelCount, uint32_t layerCount, uint32_t faceCount);
+
+    /**
+     * @brief read a DDS file
+     * 
+     * @param file the content of the file
+     * @param size the size of the file in bytes
+     */
+    void loadDDS(const uint8_t* file, size_t size);
+
+    /**
+     * @brief read a KTX file
+     * 
+     * @param file the content of the file
+     * @param size the size of the file in bytes
+     */
+    void loadKTX(const uint8_t* file, size_t size);
+
+    /**
+     * @brief read a KTX2 file
+     * 
+     * @param file the content of the file
+     * @param size the size of the file in bytes
+     */
+    void loadKTX2(const uint8_t* file, size_t size);
+
+    /**
+     * @brief store the data of all levels
+     */
+    std::vector<uint8_t> data;
+    /**
+     * @brief store where the levels are stored in the data
+     */
+    std::vector<OGL_CompressedLevel> levels;
+    /**
+     * @brief store the compressed internal format
+     */
+    GLenum internalFormat = 0;
+    /**
+     * @brief store the width of the first level
+     */
+    uint32_t width = 0;
+    /**
+     * @brief store the height of the first level
+     */
+    uint32_t height = 0;
+    /**
+     * @brief store the amount of layers
+     */
+    uint32_t layers = 1;
+    /**
+     * @brief store the amount of faces
+     */
+    uint32_t faces = 1;
+};
+
+/**
+ * @brief handle how textures are sampled. Samplers with the same description share one OpenGL sampler object of the instance, 
+ * so many textures can use a few samplers instead of setting their own parameters
+ */
+class OGL_Sampler : OGL_BindableBase
+{
+public:
+
+    /**
+     * @brief Construct a new sampler
+     */
+    OGL_Sampler() = default;
+
+    /**
+     * @brief Move a sampler. The new object takes over the OpenGL object, the name in the old one is set to 0. 
+     * Pointers to the old sampler are not updated, textures that still use it throw when they are bound
+     * 
+     * @param other the sampler to move from
+     */
+    OGL_Sampler(OGL_Sampler&& other);
+
+    /**
+     * @brief Move a sampler into an existing one. The OpenGL object of this sampler is given back first, the name in the old one is set to 0
+     * 
+     * @param other the sampler to move from
+     * @return OGL_Sampler& a reference to this sampler
+     */
+    OGL_Sampler& operator=(OGL_Sampler&& other);
+
+    /**
+     * @brief Destroy the sampler
+     */
+    ~OGL_Sampler() {this->release();}
+
+    /**
+     * @brief Construct a new sampler
+     * 
+     * @param desc the description of how textures are sampled
+     */
+    OGL_Sampler(const OGL_SamplerDesc& desc);
+
+    /**
+     * @brief Construct a new sampler with the same filter and wrap mode for all directions
+     * 
+     * @param minFilter the filter for minification, like GL_LINEAR_MIPMAP_LINEAR
+     * @param magFilter the filter for magnification, GL_NEAREST or GL_LINEAR
+     * @param wrap the wrap mode for all coordinates
+     */
+    OGL_Sampler(GLenum minFilter, GLenum magFilter, GLenum wrap = GL_REPEAT);
+
+    /**
+     * @brief change how textures are sampled. The sampler switches to the shared object for the new description
+     * 
+     * @param desc the new description
+     */
+    void setDesc(const OGL_SamplerDesc& desc);
+
+    /**
+     * @brief get how textures are sampled
+     * 
+     * @return const OGL_SamplerDesc& the description of the sampler
+     */
+    inline const OGL_SamplerDesc& getDesc() {return this->desc;}
+
+    /**
+     * @brief bind the sampler to a texture unit
+     * 
+     * @param unit the unit to bind to
+     */
+    void bind(uint8_t unit);
+
+    /**
+     * @brief unbind the sampler from a texture unit, so the parameters of the texture are used again
+     * 
+     * @param unit the unit to unbind from
+     */
+    void unbind(uint8_t unit);
+
+    /**
+     * @brief Get the OpenGL sampler
+     * 
+     * @return GLuint the OpenGL sampler object, shared with all samplers with the same description
+     */
+    inline GLuint getSampler() {return this->sampler;}
+
+private:
+    /**
+     * @brief take the OpenGL object and the state of an other sampler and set its name to 0. Used by the move constructor and the move assignment
+     * 
+     * @param other the sampler to take the state from
+     */
+    void takeState(OGL_Sampler& other);
+
+    /**
+     * @brief give the sampler object back to the instance
+     */
+    virtual void onDestroy() override;
+
+    /**
+     * @brief store the description of the sampler
+     */
+    OGL_SamplerDesc desc;
+    /**
+     * @brief store the shared OpenGL sampler object
      */
-    inline float getClearA() {return this->clearA;}
+    GLuint sampler = 0;
+};
+
+/**
+ * @brief bind textures to consecutive texture units together with their samplers. The samplers of all units are bound with a single call if the context supports it
+ * 
+ * @param first the first texture unit to bind to
+ * @param textures the textures to bind, a null pointer unbinds the sampler of the unit and leaves the texture
+ */
+void oglBindTextures(uint8_t first, const std::vector<OGL_Texture*>& textures);
 
+/**
+ * @brief store what a render pass does with an attachment
+ */
+struct OGL_AttachmentOps
+{
     /**
-     * @brief Set the size of the window
-     * 
-     * @param width the width of the window in pixels
-     * @param height the height of the window in pixels
+     * @brief store what happens with the content when the render pass begins
      */
-    void setSize(uint32_t width, uint32_t height);
+    OGL_LoadOp load = OGL_LOAD_OP_LOAD;
+    /**
+     * @brief store what happens with the content when the render pass ends
+     */
+    OGL_StoreOp store = OGL_STORE_OP_STORE;
+    /**
+     * @brief store the color a color attachment is cleared to
+     */
+    float clearColor[4] = {0.f, 0.f, 0.f, 0.f};
+    /**
+     * @brief store the depth a depth attachment is cleared to
+     */
+    float clearDepth = 1.f;
+    /**
+     * @brief store the value a stencil attachment is cleared to
+     */
+    GLint clearStencil = 0;
+};
+
+/**
+ * @brief handle rendering into a framebuffer with defined load and store operations for every attachment. Clears use glClearBuffer for every attachment 
+ * and content that is not needed is invalidated, so tile based renderers can skip loading and storing it
+ */
+class OGL_RenderPass
+{
+public:
 
     /**
-     * @brief Get the width of the window in pixels
-     * 
-     * @return uint32_t the window of the window in pixels
+     * @brief Construct a new render pass
      */
-    inline uint32_t getWidth() {return this->width;}
+    OGL_RenderPass() = default;
 
     /**
-     * @brief Get the height of the window in pixels
-     * 
-     * @return uint32_t the height of the window in pixels
+     * @brief Destroy the render pass
      */
-    inline uint32_t getHeight() {return this->height;}
+    ~OGL_RenderPass() = default;
 
     /**
-     * @brief clear the window. By default, all masks are set. 
+     * @brief Construct a new render pass
      * 
-     * @param clearColor if this is true, the color buffer of the window will be cleared with the clear color. 
-     * @param clearDepth if this is true, the depth buffer will be cleard. 
-     * @param clearStencil if this is true, the stencil buffer of the window will be cleard.
+     * @param framebuffer the framebuffer to render to, or 0 for the default framebuffer of the current window. The framebuffer must stay alive while the render pass uses it
+     * @param ops the operations for each attachment of the framebuffer. For the default framebuffer, the first entry is used for the color and the second for the depth and stencil buffer. 
+     * Attachments without an entry are loaded and stored
      */
-    void clear(bool clearColor = true, bool clearDepth = true, bool clearStencil = true);
+    OGL_RenderPass(OGL_Framebuffer* framebuffer, std::vector<OGL_AttachmentOps> ops);
 
     /**
-     * @brief update the window
+     * @brief access the operations for an attachment
+     * @warning this operator dose not check if the attachment has operations. If the index is out of range, this may lead to undefined behaviour
+     * 
+     * @param index the index of the attachment
+     * @return OGL_AttachmentOps& a reference to the operations
      */
-    void flip();
+    inline OGL_AttachmentOps& operator[](size_t index) {return this->ops[index];}
 
     /**
-     * @brief Set a function to call if the window is resized
+     * @brief set the area that is rendered to. It is set when the render pass begins
      * 
-     * @param func the function to call
-     * @param userData some abituary data that can be passed into the function
+     * @param x the x position of the area in pixels
+     * @param y the y position of the area in pixels
+     * @param width the width of the area in pixels, 0 to keep the viewport that is set
+     * @param height the height of the area in pixels
      */
-    void setOnResizeHook(void (*func)(uint32_t, uint32_t, void*), void* userData = 0);
+    void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
 
     /**
-     * @brief Get the function the window calls if the window is resized
+     * @brief begin the render pass. The framebuffer is bound for drawing and the attachments are cleared or invalidated. 
+     * Clears are affected by the write masks and the scissor test, like all OpenGL clears
      */
-    inline void (*getOnResizeHook())(uint32_t,uint32_t, void*) {return this->resizeFunc;}
+    void begin();
 
-private:
     /**
-     * @brief store a pointer to the instance
+     * @brief end the render pass. Attachments that are discarded are invalidated, the framebuffer stays bound
      */
-    OGL_Instance* instance = 0;
+    void end();
+
     /**
-     * @brief store the window pointer
+     * @brief get the framebuffer that is rendered to
+     * 
+     * @return OGL_Framebuffer* the framebuffer, or 0 for the default framebuffer
      */
-    SDL_Window* window = 0;
+    inline OGL_Framebuffer* getFramebuffer() {return this->framebuffer;}
+
+private:
     /**
-     * @brief store if the window should close
+     * @brief get the OpenGL attachment point of an attachment for invalidation
+     * 
+     * @param index the index of the attachment
+     * @param points the attachment points are added to this vector. The depth and stencil buffer of the default framebuffer are two points
      */
-    bool shouldClose = false;
+    void getInvalidationPoints(size_t index, std::vector<GLenum>& points);
+
     /**
-     * @brief store the clear color's r component
+     * @brief invalidate the content of attachments
+     * 
+     * @param points the attachment points to invalidate
      */
-    float clearR = 0.f;
+    void invalidate(const std::vector<GLenum>& points);
+
     /**
-     * @brief store the clear color's g component
+     * @brief store the framebuffer, or 0 for the default framebuffer
      */
-    float clearG = 0.f;
+    OGL_Framebuffer* framebuffer = 0;
     /**
-     * @brief store the clear color's b component
+     * @brief store the operations for each attachment
      */
-    float clearB = 0.f;
+    std::vector<OGL_AttachmentOps> ops;
     /**
-     * @brief store the clear color's a component
+     * @brief store the area that is rendered to, a width of 0 keeps the viewport
      */
-    float clearA = 0.f;
+    GLint viewport[4] = {0, 0, 0, 0};
+};
 
+/**
+ * @brief store a render target of a render target pool
+ */
+struct OGL_PooledRenderTarget
+{
     /**
-     * @brief store the x-position of the window in pixels relative to the top left corner of the screen
-     */
-    uint32_t posX = 0;
-    /**
-     * @brief store the y-position of the window in pixels relative to the top left corner of the screen
+     * @brief store the texture of the render target, it is owned by the pool
      */
-    uint32_t posY = 0;
-
+    OGL_Texture* texture = 0;
     /**
-     * @brief store the widht of the window in pixels
+     * @brief store the allocated width, a multiple of OGL_RENDER_TARGET_GRANULARITY
      */
     uint32_t width = 0;
     /**
-     * @brief store the height of the window in pixels
+     * @brief store the allocated height, a multiple of OGL_RENDER_TARGET_GRANULARITY
      */
     uint32_t height = 0;
     /**
-     * @brief store the name of the window
+     * @brief store the internal format of the texture
      */
-    const char* name;
+    GLenum internalFormat = 0;
     /**
-     * @brief store a function that should be called if the window is resized
+     * @brief store the amount of samples per pixel
      */
-    void (*resizeFunc)(uint32_t, uint32_t, void*) = 0;
+    uint32_t samples = 1;
     /**
-     * @brief store some abituary data for the user that can be passed into the resize function
+     * @brief store if the render target is handed out
      */
-    void* resizeFuncUserData = 0;
+    bool used = false;
+    /**
+     * @brief store the index of the frame the render target was given back in
+     */
+    uint64_t lastUse = 0;
 };
 
-//a macro to ensure that the correct window is bound
-#define correctInstanceBinding() if (oglGetCurrentInstance() != this->instance) {this->instance->makeCurrent();}
-
 /**
- * @brief handle vertex buffers in a class-wraped fassion
- * 
- * @tparam T the type of a vertex, can be anything. 
+ * @brief hand out textures for framebuffers and re-use them. The sizes are rounded up to size classes, so render targets survive small resizes and 
+ * targets that are given back are handed out again for the same size class, format and sample count. Render into the requested size with the viewport
  */
-template<typename T> class OGL_VertexBuffer : OGL_BindableBase
+class OGL_RenderTargetPool
 {
 public:
+
     /**
-     * @brief Construct a new ogl vertex buffer
+     * @brief Construct a new render target pool
      */
-    OGL_VertexBuffer() = default;
+    OGL_RenderTargetPool() = default;
 
     /**
-     * @brief Construct a new ogl vertex buffer
+     * @brief render target pools own their textures, so they can't be copied
+     */
+    OGL_RenderTargetPool(const OGL_RenderTargetPool&) = delete;
+
+    /**
+     * @brief render target pools own their textures, so they can't be copied
+     */
+    OGL_RenderTargetPool& operator=(const OGL_RenderTargetPool&) = delete;
+
+    /**
+     * @brief Destroy the render target pool and all its textures. Textures that are still handed out are deleted too
+     */
+    ~OGL_RenderTargetPool();
+
+    /**
+     * @brief hand out a render target. A free target with the same size class, format and sample count is re-used, else a new one is created
      * 
-     * @param vertices the vertices 
+     * @param width the width that is rendered to
+     * @param height the height that is rendered to
+     * @param internalFormat the internal format of the texture, like GL_RGBA16F or GL_DEPTH_COMPONENT24
+     * @param samples the amount of samples per pixel, more than 1 creates a multisample texture
+     * @return OGL_Texture* the texture of the render target. It is at least as big as requested and owned by the pool
      */
-    OGL_VertexBuffer(std::vector<T> vertices)
-    {
-        //store the vertices
-        this->vertices = vertices;
-        //create the VB
-        glGenBuffers(1, &this->buffer);
-        //upload to the GPU
-        this->uploadToGPU();
-    }
+    OGL_Texture* acquire(uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples = 1);
 
     /**
-     * @brief add a vertex ad the end of the vertices
+     * @brief change the size of a handed out render target. The texture only gets new storage if the size class changes, framebuffers using it re-attach it when they are bound
      * 
-     * @param vertex the vertex to add
+     * @param texture the texture of the render target
+     * @param width the new width that is rendered to
+     * @param height the new height that is rendered to
+     * @return true : the texture got new storage | 
+     * @return false : the storage is big enough and was kept
      */
-    void addVertex(T vertex)
-    {
-        //add a vertex
-        this->vertices.push_back(vertex);
-    }
+    bool resize(OGL_Texture* texture, uint32_t width, uint32_t height);
 
     /**
-     * @brief Set the Vertex at the specified position
-     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * @brief give a render target back to the pool, so it can be handed out again
      * 
-     * @param index the index to set the vertex to
-     * @param vertex the vertex to set
+     * @param texture the texture of the render target
      */
-    void setVertex(size_t index, T vertex)
-    {
-        //update the vertex
-        this->vertices[index] = vertex;
-    }
+    void release(OGL_Texture* texture);
 
     /**
-     * @brief Get the vertex at the specified index
-     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * @brief delete free render targets that where not used for some frames
      * 
-     * @param index the index to get the vertex from
-     * @return T the vertex at the specified index
+     * @param frames the amount of frames a free render target is kept
      */
-    T getVertex(size_t index)
-    {
-        //return the vertex at the specified location
-        return this->vertices[index];
-    }
+    void trim(uint32_t frames = OGL_RENDER_TARGET_LIFETIME);
 
     /**
-     * @brief remove the vertex at the specified position
-     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * @brief get the amount of render targets in the pool, including the handed out ones
      * 
-     * @param index the index to delete the vertex from
+     * @return size_t the amount of render targets
      */
-    void deleteVertex(size_t index)
-    {
-        //remove the index at the specified position
-        this->vertices.erase(this->vertices.begin() + index);
-    }
+    inline size_t getTargetCount() {return this->targets.size();}
 
     /**
-     * @brief access the element at the specified index
-     * @warning indexing out of bounds resoults in undefined behaviour. This dose not add a vertex, but changes an existing one. 
+     * @brief get the amount of video memory all render targets of the pool use
      * 
-     * @param index the index to access the element at
-     * @return T& a reference to the element
+     * @return size_t the used memory in bytes
      */
-    T& operator[](size_t index)
-    {
-        //return a reference to the element
-        return this->vertices[index];
-    }
+    size_t getMemorySize();
 
     /**
-     * @brief Get a pointer to all the vertices
+     * @brief get how often storage for a render target was allocated
      * 
-     * @return std::vector<T>* a pointer to the vertices
+     * @return uint64_t the amount of allocations
      */
-    std::vector<T>* getVertices()
-    {
-        //return a pointer to the vertices
-        return &this->vertices;
-    }
+    inline uint64_t getAllocationCount() {return this->allocations;}
 
     /**
-     * @brief bind the vertex buffer object
+     * @brief get how often a render target was handed out or resized without allocating storage
+     * 
+     * @return uint64_t the amount of re-uses
      */
-    void bind()
-    {
-        //bind the correct window / instance
-        correctInstanceBinding()
+    inline uint64_t getReuseCount() {return this->reuses;}
 
-        //bind the vertex buffer
-        glBindBuffer(GL_ARRAY_BUFFER, this->buffer);
-    }
+private:
+    /**
+     * @brief find the render target of a texture
+     * 
+     * @param texture the texture to search
+     * @return OGL_PooledRenderTarget* the render target, or 0 if the texture is not from this pool
+     */
+    OGL_PooledRenderTarget* find(OGL_Texture* texture);
 
     /**
-     * @brief unbind any vertex buffer
+     * @brief store all render targets
      */
-    void bindNone()
-    {
-        //bind the correct window / instance
-        correctInstanceBinding()
-        //bind buffer 0, which means none
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    }
+    std::vector<OGL_PooledRenderTarget> targets;
+    /**
+     * @brief store the amount of allocations
+     */
+    uint64_t allocations = 0;
+    /**
+     * @brief store the amount of re-uses
+     */
+    uint64_t reuses = 0;
+};
 
+/**
+ * @brief store a texture or renderbuffer of a frame graph
+ */
+struct OGL_FrameGraphResource
+{
     /**
-     * @brief upload the data of the element to the GPU
+     * @brief store the name of the resource, used for error messages
      */
-    void uploadToGPU()
-    {
-        //bind the correct window / instance
-        correctInstanceBinding()
-        //bind the buffer
-        glBindBuffer(GL_ARRAY_BUFFER, this->buffer);
-        //buffer the whole vertices
-        glBufferData(GL_ARRAY_BUFFER, sizeof(T) * this->vertices.size(), this->vertices.data(), GL_STATIC_DRAW);
-    }
+    std::string name;
+    /**
+     * @brief store the width that is rendered to in pixels
+     */
+    uint32_t width = 0;
+    /**
+     * @brief store the height that is rendered to in pixels
+     */
+    uint32_t height = 0;
+    /**
+     * @brief store the internal format of the texture
+     */
+    GLenum internalFormat = 0;
+    /**
+     * @brief store the amount of samples per pixel
+     */
+    uint32_t samples = 1;
+    /**
+     * @brief store the texture. Transient textures only have one while they are alive, imported textures always
+     */
+    OGL_Texture* texture = 0;
+    /**
+     * @brief store an imported renderbuffer that is attached instead of a texture, or 0 for textures
+     */
+    OGL_Renderbuffer* renderbuffer = 0;
+    /**
+     * @brief store if the texture is owned by the user instead of the render target pool
+     */
+    bool imported = false;
+    /**
+     * @brief store if the texture is used after the frame graph executed, so its writers are never culled
+     */
+    bool output = false;
+    /**
+     * @brief store the position of the first pass in the execution order that uses the texture
+     */
+    uint32_t firstUse = 0;
+    /**
+     * @brief store the position of the last pass in the execution order that uses the texture
+     */
+    uint32_t lastUse = 0;
+};
 
-private:
+/**
+ * @brief store a write of a pass to a texture of a frame graph
+ */
+struct OGL_FrameGraphWrite
+{
+    /**
+     * @brief store the resource that is written to
+     */
+    uint32_t resource = 0;
+    /**
+     * @brief store what happens with the content when the pass begins and ends
+     */
+    OGL_AttachmentOps ops;
+};
+
+/**
+ * @brief store a pass of a frame graph
+ */
+struct OGL_FrameGraphPass
+{
+    /**
+     * @brief store the name of the pass, used for error messages
+     */
+    std::string name;
+    /**
+     * @brief store the function that renders the pass
+     */
+    void (*execute)(OGL_FrameGraph*, uint32_t, void*) = 0;
+    /**
+     * @brief store the data for the function
+     */
+    void* userData = 0;
+    /**
+     * @brief store the resources the pass reads
+     */
+    std::vector<uint32_t> reads;
+    /**
+     * @brief store the resources the pass renders to, in the order of the attachments
+     */
+    std::vector<OGL_FrameGraphWrite> writes;
+    /**
+     * @brief store the operations for the default framebuffer, the pass renders to the window if it is not empty
+     */
+    std::vector<OGL_AttachmentOps> backbuffer;
+    /**
+     * @brief store if the pass is never culled
+     */
+    bool keep = false;
     /**
-     * @brief this function is responsible for deleting the object
+     * @brief store if the pass was culled because nothing uses its results
      */
-    virtual void onDestroy() override
-    {
-        //delete the vertex buffer
-        glDeleteBuffers(1, &this->buffer);
-        //set the buffer to 0
-        this->buffer = 0;
-        //free the vertices
-        this->vertices.clear();
-        //bind no buffer
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    }
-
+    bool culled = false;
     /**
-     * @brief store the vertices
+     * @brief store the passes whose results the pass uses
      */
-    std::vector<T> vertices;
+    std::vector<uint32_t> dependencies;
     /**
-     * @brief store the OpenGL buffer
+     * @brief store the passes that must be executed before the pass, including the dependencies
      */
-    GLuint buffer = 0;
-};
-
-/**
- * @brief store the information about a part of an vertex
- */
-struct OGL_VertexAttribute
-{
-    //store the vertex size
-    uint8_t size = 4;
-    //store the type of the data
-    OGL_Type type = OGL_TYPE_FLOAT;
-    //store if the data should be normalized
-    bool normalize = false;
+    std::vector<uint32_t> after;
+    /**
+     * @brief store the framebuffer the pass renders to, it is created the first time the pass is executed
+     */
+    OGL_Framebuffer* framebuffer = 0;
+    /**
+     * @brief store the render pass with the final load and store operations
+     */
+    OGL_RenderPass renderPass;
 };
 
 /**
- * @brief handle the definition of how a vertex looks
+ * @brief build a frame out of passes that declare which textures they read and write. Passes whose results are never used are culled, the rest is 
+ * ordered by their dependencies. Transient textures are taken from a render target pool when they are first used and given back after their last use, 
+ * so textures whose lifetimes don't overlap share the same video memory
  */
-class OGL_VertexAttributes : OGL_BindableBase
+class OGL_FrameGraph
 {
 public:
 
     /**
-     * @brief Construct a new structure to describe the structure of the vertices
+     * @brief Construct a new frame graph
      */
-    OGL_VertexAttributes() = default;
+    OGL_FrameGraph() = default;
 
     /**
-     * @brief Construct a new structure to describe the structure of the vertices
-     * 
-     * @param attributes the attributes of the vertices
-     * @param vertexSize the size of a single vertex
+     * @brief frame graphs own their framebuffers, so they can't be copied
      */
-    OGL_VertexAttributes(std::vector<OGL_VertexAttribute> attributes, size_t vertexSize);
+    OGL_FrameGraph(const OGL_FrameGraph&) = delete;
 
     /**
-     * @brief change the structure of the vertices
-     * 
-     * @param attributes the new attributes for the structure of the vertices
-     * @param vertexSize the size of a single vertex
+     * @brief frame graphs own their framebuffers, so they can't be copied
      */
-    void updateStructure(std::vector<OGL_VertexAttribute> attributes, size_t vertexSize);
+    OGL_FrameGraph& operator=(const OGL_FrameGraph&) = delete;
 
     /**
-     * @brief only re-upload the structure of the VAO, don't set a new structure
+     * @brief Destroy the frame graph, all transient textures are given back to the pool
      */
-    void update();
+    ~OGL_FrameGraph();
 
     /**
-     * @brief change and upload the structure of a single attribute of the vertex
+     * @brief Construct a new frame graph
      * 
-     * @param idx the index to change the data at. If the index is out of range, it will be put to the end of the list
-     * @return OGL_VertexAttribute& a reference to the requested attribute. If it changes, the data will be re-uploaded. 
+     * @param pool the render target pool the transient textures are taken from
      */
-    OGL_VertexAttribute& operator[](size_t idx);
+    OGL_FrameGraph(OGL_RenderTargetPool* pool);
 
     /**
-     * @brief bind this as the structure for the current vertices
+     * @brief add a transient texture. It only has storage while passes use it
+     * 
+     * @param name the name of the texture
+     * @param width the width that is rendered to in pixels
+     * @param height the height that is rendered to in pixels
+     * @param internalFormat the internal format, like GL_RGBA16F or GL_DEPTH_COMPONENT24
+     * @param samples the amount of samples per pixel, more than 1 creates a multisample texture
+     * @return uint32_t the handle of the texture
      */
-    void bind();
+    uint32_t createTexture(const std::string& name, uint32_t width, uint32_t height, GLenum internalFormat, uint32_t samples = 1);
 
-private:
     /**
-     * @brief clean up the object
+     * @brief add a texture that is owned by the user. It is never shared with other textures and passes that write to it are never culled
+     * 
+     * @param name the name of the texture
+     * @param texture the texture
+     * @return uint32_t the handle of the texture
      */
-    virtual void onDestroy() override;
+    uint32_t importTexture(const std::string& name, OGL_Texture* texture);
 
     /**
-     * @brief store the attributes for the vertices
+     * @brief add a renderbuffer that is owned by the user, like a depth buffer that is never read. Passes can only write to it and are never culled if they do
+     * 
+     * @param name the name of the renderbuffer
+     * @param renderbuffer the renderbuffer
+     * @return uint32_t the handle of the renderbuffer
      */
-    std::vector<OGL_VertexAttribute> attributes;
+    uint32_t importRenderbuffer(const std::string& name, OGL_Renderbuffer* renderbuffer);
+
     /**
-     * @brief store the size of a vertex
+     * @brief change the size of a transient texture, like when the window is resized
+     * 
+     * @param resource the handle of the texture
+     * @param width the new width in pixels
+     * @param height the new height in pixels
      */
-    size_t vertSize = 0;
+    void setTextureSize(uint32_t resource, uint32_t width, uint32_t height);
+
     /**
-     * @brief store the VAO
+     * @brief mark a transient texture as used after the frame graph executed. It stays alive until the next execution and passes that write to it are never culled
+     * 
+     * @param resource the handle of the texture
      */
-    GLuint vao = 0;
-};
+    void markOutput(uint32_t resource);
 
-/**
- * @brief handle an element array buffer, also called index buffer, for OpenGL
- */
-class OGL_IndexBuffer : OGL_BindableBase
-{
-public:
     /**
-     * @brief Construct a new index buffer
+     * @brief add a pass. Passes are executed in the order they are added, as long as their dependencies allow it
+     * 
+     * @param name the name of the pass
+     * @param execute the function that renders the pass. It gets the frame graph, the handle of the pass and the user data
+     * @param userData some abituary data that is passed into the function
+     * @return uint32_t the handle of the pass
      */
-    OGL_IndexBuffer() = default;
+    uint32_t addPass(const std::string& name, void (*execute)(OGL_FrameGraph*, uint32_t, void*), void* userData = 0);
 
     /**
-     * @brief Construct a new index buffer
+     * @brief declare that a pass reads a texture
      * 
-     * @param indices the indices for the buffer
+     * @param pass the handle of the pass
+     * @param resource the handle of the texture
      */
-    OGL_IndexBuffer(std::vector<uint32_t> indices);
+    void read(uint32_t pass, uint32_t resource);
 
     /**
-     * @brief change the data stored in the buffer
+     * @brief declare that a pass renders to a texture. The texture is attached to the framebuffer of the pass in the order of the writes. 
+     * Loading the content of a transient texture that was not written before and storing content that is never read again is skipped automatically
      * 
-     * @param indices the new indices for the buffer
+     * @param pass the handle of the pass
+     * @param resource the handle of the texture
+     * @param ops what happens with the content when the pass begins and ends
      */
-    inline void updateData(std::vector<uint32_t> indices) {this->indices = indices;}
+    void write(uint32_t pass, uint32_t resource, const OGL_AttachmentOps& ops = OGL_AttachmentOps());
 
     /**
-     * @brief upload the buffer to the index buffer on the GPU
+     * @brief declare that a pass renders to the default framebuffer. The pass is never culled
+     * 
+     * @param pass the handle of the pass
+     * @param color what happens with the color buffer
+     * @param depth what happens with the depth and stencil buffer
      */
-    void upload();
+    void writeBackbuffer(uint32_t pass, const OGL_AttachmentOps& color = OGL_AttachmentOps(), const OGL_AttachmentOps& depth = OGL_AttachmentOps());
 
     /**
-     * @brief add an element to the buffer
+     * @brief mark a pass to never be culled, like a pass that writes to buffers the frame graph dose not know of
      * 
-     * @param index the index to add
+     * @param pass the handle of the pass
      */
-    inline void addElement(uint32_t index) {this->indices.push_back(index);}
+    void keepPass(uint32_t pass);
 
     /**
-     * @brief Set an element in the buffer to a new value
-     * 
-     * @param index the new value
-     * @param idx the index to change
+     * @brief cull and order the passes and calculate the lifetimes of the textures. This happens automatically when the frame graph is executed after it changed
      */
-    void setElement(uint32_t index, size_t idx);
+    void compile();
 
     /**
-     * @brief Get a specific element from the buffer
-     * 
-     * @param idx the index to access
-     * @return uint32_t the value of the element in the buffer
+     * @brief execute all passes that are not culled in their order
      */
-    uint32_t getElement(size_t idx);
+    void execute();
 
     /**
-     * @brief Get a pointer to an specific element from the buffer
+     * @brief remove all passes and textures
+     */
+    void clear();
+
+    /**
+     * @brief Get the texture of a resource. Transient textures only exist while the passes that use them are executed
      * 
-     * @param idx the index to access
-     * @return uint32_t* a pointer to the element
+     * @param resource the handle of the texture
+     * @return OGL_Texture* the texture or 0 if the texture has no storage right now
      */
-    uint32_t* getElementPtr(size_t idx);
+    inline OGL_Texture* getTexture(uint32_t resource) {return this->resources[resource].texture;}
 
     /**
-     * @brief access a reference of a specific element with the index operator
+     * @brief Get the framebuffer a pass renders to
      * 
-     * @param idx the index to access
-     * @return uint32_t& a reference to the element (a REFERENCE, not a POINTER)
+     * @param pass the handle of the pass
+     * @return OGL_Framebuffer* the framebuffer or 0 if the pass renders to the default framebuffer, to nothing or was not executed yet
      */
-    uint32_t& operator[](size_t idx);
+    inline OGL_Framebuffer* getFramebuffer(uint32_t pass) {return this->passes[pass].framebuffer;}
 
     /**
-     * @brief Get the values of all indices
+     * @brief get the amount of passes, including the culled passes
      * 
-     * @return std::vector<uint32_t> a vector of all values
+     * @return size_t the amount of passes
      */
-    inline std::vector<uint32_t> getIndices() {return this->indices;}
+    inline size_t getPassCount() {return this->passes.size();}
 
     /**
-     * @brief Get a pointer to all the indices
+     * @brief get the amount of passes that where culled the last time the frame graph was compiled
      * 
-     * @return std::vector<uint32_t>* a pointer to the vector containing the indices
+     * @return size_t the amount of culled passes
      */
-    inline std::vector<uint32_t>* getIndicesPtr() {return &this->indices;}
+    size_t getCulledPassCount();
 
     /**
-     * @brief bind this as the current element array buffer
+     * @brief get the passes in the order they are executed
+     * 
+     * @return const std::vector<uint32_t>& the handles of the passes that are not culled
      */
-    void bind();
+    inline const std::vector<uint32_t>& getExecutionOrder() {return this->order;}
 
     /**
-     * @brief bind this as the current element array buffer
+     * @brief get how many transient textures got a texture that an other transient texture used before in the last execution
+     * 
+     * @return uint32_t the amount of shared textures
      */
-    void unbind();
+    inline uint32_t getAliasCount() {return this->aliases;}
 
     /**
-     * @brief Get the amount of stored indices
+     * @brief get the most video memory the transient textures used at the same time in the last execution
      * 
-     * @return size_t the amount of indices
+     * @return size_t the size in bytes
      */
-    inline size_t getIndexCount() {return this->indices.size();}
+    inline size_t getPeakMemory() {return this->peakMemory;}
 
 private:
     /**
-     * @brief handle the destruction of the buffer
+     * @brief give back the texture of a transient resource to the pool
+     * 
+     * @param resource the handle of the texture
      */
-    virtual void onDestroy() override;
+    void releaseTexture(uint32_t resource);
 
     /**
-     * @brief store the index data for the buffer
+     * @brief create the framebuffer and render pass of a pass or update its attachments
+     * 
+     * @param pass the handle of the pass
+     * @param position the position of the pass in the execution order
      */
-    std::vector<uint32_t> indices;
+    void prepareFramebuffer(uint32_t pass, uint32_t position);
+
     /**
-     * @brief store the index buffer
+     * @brief store the pool the transient textures are taken from
      */
-    GLuint ibo = 0;
+    OGL_RenderTargetPool* pool = 0;
+    /**
+     * @brief store all textures
+     */
+    std::vector<OGL_FrameGraphResource> resources;
+    /**
+     * @brief store all passes
+     */
+    std::vector<OGL_FrameGraphPass> passes;
+    /**
+     * @brief store the passes that are not culled in the order they are executed
+     */
+    std::vector<uint32_t> order;
+    /**
+     * @brief store if the frame graph changed since it was compiled
+     */
+    bool dirty = true;
+    /**
+     * @brief store the amount of shared textures in the last execution
+     */
+    uint32_t aliases = 0;
+    /**
+     * @brief store the peak memory of the transient textures in the last execution
+     */
+    size_t peakMemory = 0;
 };
 
 /**
- * @brief store the information about a single uniform
+ * @brief store a texture that is bound for a recorded draw
  */
-class OGL_UniformInfo
+struct OGL_CommandTexture
 {
-public:
-
     /**
-     * @brief Construct a new uniform information structure
-     */
-    OGL_UniformInfo() = default;
-
-    /**
-     * @brief set the data contained in the info to a specific value
-     * 
-     * @tparam T the type of the data
-     * @param value the value to set to
+     * @brief store the texture unit
      */
-    template<typename T> void set(T value)
-    {
-        //check if the type fits
-        if (sizeof(T) > 64)
-        {
-            //if not, throw an error
-            std::__throw_runtime_error("The type of the value tried to set as uniform is bigger as 64, wich is the maximum size of a uniform");
-            return;
-        }
-        //if not, copy the data
-        memcpy(data, &value, sizeof(T));
-    }
-
+    uint8_t unit = 0;
     /**
-     * @brief get the data stored in the uniform info
-     * 
-     * @tparam T the type of the data
-     * @return T the stored data
+     * @brief store the texture
      */
-    template<typename T> inline T get()
-    {
-        //return the re-interpreted data
-        return *((T*)((void*)data));
-    }
-
-    template<typename T> inline T& getRef()
-    {
-        //retuern a reference to the re-interpreted data
-        return (*((T*)((void*)data)));
-    }
+    OGL_Texture* texture = 0;
+};
 
+/**
+ * @brief store a part of a uniform buffer that is bound for a recorded draw
+ */
+struct OGL_CommandUniformRange
+{
     /**
-     * @brief store the name of the uniform
+     * @brief store the uniform buffer binding point
      */
-    std::string name;
+    uint8_t unit = 0;
     /**
-     * @brief store the type
+     * @brief store the uniform buffer
      */
-    OGL_Type type;
+    OGL_UniformBuffer* buffer = 0;
     /**
-     * @brief store the raw data of the contained value
+     * @brief store the offset of the part in bytes
      */
-    uint8_t data[sizeof(float)*16] = {};
+    GLintptr offset = 0;
     /**
-     * @brief store the location of the uniform
+     * @brief store the size of the part in bytes, 0 binds the whole buffer
      */
-    GLint location = -1;
+    GLsizeiptr size = 0;
 };
 
 /**
- * @brief utility function to create an uniform info and initalise it
- * 
- * @tparam T the type for the value
- * @param name the name of the uniform
- * @param value the value of the uniform
- * @param type the base type for OpenGL
- * @return OGL_UniformInfo the finished uniform information
+ * @brief store a single recorded draw. The textures and uniform buffer ranges are stored in the arenas of the command list
  */
-template<typename T> OGL_UniformInfo oglCreateUniformInfo(std::string name, T value, OGL_Type type)
+struct OGL_DrawPacket
 {
-    //crate a new info
-    OGL_UniformInfo info;
-    //store the name
-    info.name = name;
-    //store the type identifyer
-    info.type = type;
-    //set the data
-    info.set<T>(value);
-    //return the info
-    return info;
-}
+    /**
+     * @brief store the key the draws are sorted by, it is calculated when the command list is submitted
+     */
+    uint64_t key = 0;
+    /**
+     * @brief store the shader to draw with
+     */
+    OGL_Shader* shader = 0;
+    /**
+     * @brief store the vertex attributes to draw with
+     */
+    OGL_VertexAttributes* vertexAttributes = 0;
+    /**
+     * @brief store the index buffer to draw with, or 0 to draw without indices
+     */
+    OGL_IndexBuffer* indexBuffer = 0;
+    /**
+     * @brief store the index of the first texture in the texture arena
+     */
+    uint32_t firstTexture = 0;
+    /**
+     * @brief store the amount of textures
+     */
+    uint32_t textureCount = 0;
+    /**
+     * @brief store the index of the first uniform buffer range in the uniform arena
+     */
+    uint32_t firstUniform = 0;
+    /**
+     * @brief store the amount of uniform buffer ranges
+     */
+    uint32_t uniformCount = 0;
+    /**
+     * @brief store the type of primitive, like GL_TRIANGLES
+     */
+    GLenum mode = GL_TRIANGLES;
+    /**
+     * @brief store the amount of indices or vertices to draw
+     */
+    GLsizei count = 0;
+    /**
+     * @brief store the first index or vertex to draw
+     */
+    uint32_t first = 0;
+    /**
+     * @brief store the value added to the indices
+     */
+    GLint baseVertex = 0;
+    /**
+     * @brief store the amount of instances
+     */
+    GLsizei instanceCount = 1;
+};
 
 /**
- * @brief handle all functions neceserry for shaders
+ * @brief store how many state changes the replay of a command list needed
  */
-class OGL_Shader : OGL_BindableBase
+struct OGL_CommandListStats
 {
-public:
-
     /**
-     * @brief Construct a new shader
+     * @brief store the amount of draws
      */
-    OGL_Shader() = default;
-
+    uint64_t draws = 0;
     /**
-     * @brief Construct a new shader
-     * 
-     * @param vs the vertex shader information, in the format specified by type
-     * @param fs the fragment shader information, in the format specified by type
-     * @param type the type the data is given in, can be inputed as file, source or binary
+     * @brief store how often the shader changed
      */
-    OGL_Shader(std::string vs, std::string fs, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
-
+    uint64_t programChanges = 0;
+    /**
+     * @brief store how often the vertex attributes changed
+     */
+    uint64_t vertexArrayChanges = 0;
+    /**
+     * @brief store how often the index buffer changed
+     */
+    uint64_t indexBufferChanges = 0;
+    /**
+     * @brief store how often a texture unit got an other texture
+     */
+    uint64_t textureChanges = 0;
     /**
-     * @brief change this shader to a new shader
-     * 
-     * @param vs the vertex shader information, in the format specified by type
-     * @param fs the fragment shader information, in the format specified by type
-     * @param type the type the data is given in, can be inputed as file, source or binary
+     * @brief store how often a uniform buffer binding point got an other range
      */
-    void recompileShader(std::string vs, std::string fs, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
-
+    uint64_t uniformChanges = 0;
     /**
-     * @brief Get the Compiled Shader on the GPU
-     * 
-     * @return uint32_t the compiled OpenGL shader on the GPU
+     * @brief store how many state changes the draws would have needed in the order they where recorded
      */
-    inline uint32_t getCompiledShader() {return this->shader;}
+    uint64_t unsortedStateChanges = 0;
+};
+
+/**
+ * @brief record draws without making OpenGL calls and replay them later. The draws can be sorted by their state, so shaders, vertex attributes 
+ * and textures change as rarely as possible. Don't sort draws whose order matters, like transparent objects
+ */
+class OGL_CommandList
+{
+public:
 
     /**
-     * @brief bind the shader
+     * @brief Construct a new command list
      */
-    void bind();
+    OGL_CommandList() = default;
 
     /**
-     * @brief unbind the shader
+     * @brief Destroy the command list
      */
-    void unbind();
+    ~OGL_CommandList() = default;
 
     /**
-     * @brief Set the uniforms for the buffer
+     * @brief set the shader for the following draws
      * 
-     * @param uniforms the uniforms for the shader
+     * @param shader the shader
      */
-    inline void setUniforms(std::vector<OGL_UniformInfo> uniforms) {this->uniforms = uniforms;}
+    inline void setShader(OGL_Shader* shader) {this->shader = shader;}
 
     /**
-     * @brief Get a pointer to all stored uniforms
+     * @brief set the vertex attributes for the following draws
      * 
-     * @return std::vector<OGL_UniformInfo>* a pointer to the internal vector of uniforms
+     * @param vertexAttributes the vertex attributes, they also store the vertex buffer
      */
-    inline std::vector<OGL_UniformInfo>* getUniformPtr() {return &this->uniforms;}
+    inline void setVertexAttributes(OGL_VertexAttributes* vertexAttributes) {this->vertexAttributes = vertexAttributes;}
 
     /**
-     * @brief Get the amount of stored uniforms
+     * @brief set the index buffer for the following draws
      * 
-     * @return size_t the amount of uniforms
+     * @param indexBuffer the index buffer, or 0 to draw without indices
      */
-    inline size_t getUniformCount() {return this->uniforms.size();}
+    inline void setIndexBuffer(OGL_IndexBuffer* indexBuffer) {this->indexBuffer = indexBuffer;}
 
     /**
-     * @brief get a specific uniform from the shader. If it dosn't exist, create it
+     * @brief set the texture of a unit for the following draws
      * 
-     * @param name the name of the uniform
-     * @return OGL_UniformInfo& a reference to the uniform
+     * @param unit the texture unit
+     * @param texture the texture, or 0 to stop binding a texture to the unit
      */
-    OGL_UniformInfo& operator[](std::string name);
+    void setTexture(uint8_t unit, OGL_Texture* texture);
 
     /**
-     * @brief get a specific uniform from the shader. If it dosn't exist, throw an error
+     * @brief set the uniform buffer of a binding point for the following draws
      * 
-     * @param index the index of the 
-     * @return OGL_UniformInfo& 
+     * @param unit the uniform buffer binding point
+     * @param buffer the uniform buffer, or 0 to stop binding a buffer to the binding point
+     * @param offset the offset of the part to bind in bytes, a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+     * @param size the size of the part to bind in bytes, or 0 to bind the whole buffer
      */
-    OGL_UniformInfo& operator[](size_t index);
+    void setUniformBuffer(uint8_t unit, OGL_UniformBuffer* buffer, GLintptr offset = 0, GLsizeiptr size = 0);
 
     /**
-     * @brief update the positions of all uniforms
+     * @brief record a draw with the index buffer
+     * 
+     * @param count the amount of indices to draw
+     * @param mode the type of primitive
+     * @param firstIndex the first index to draw
+     * @param instanceCount the amount of instances
+     * @param baseVertex the value added to the indices
      */
-    void recalculateUniforms();
+    void drawElements(GLsizei count, GLenum mode = GL_TRIANGLES, uint32_t firstIndex = 0, GLsizei instanceCount = 1, GLint baseVertex = 0);
 
-private:
     /**
-     * @brief clean up the object after destruction
+     * @brief record a draw without indices
+     * 
+     * @param count the amount of vertices to draw
+     * @param mode the type of primitive
+     * @param first the first vertex to draw
+     * @param instanceCount the amount of instances
      */
-    virtual void onDestroy() override;
+    void drawArrays(GLsizei count, GLenum mode = GL_TRIANGLES, uint32_t first = 0, GLsizei instanceCount = 1);
 
     /**
-     * @brief store the OpenGL shader
+     * @brief add all draws of an other command list after the draws of this list
+     * 
+     * @param other the command list to add
      */
-    GLuint shader = 0;
+    void append(const OGL_CommandList& other);
+
     /**
-     * @brief store information about all the uniforms
+     * @brief replay all draws. This must be called on the thread of the instance
+     * 
+     * @param sort true to sort the draws by their state first, draws with the same state keep their order | false to keep the order of recording
      */
-    std::vector<OGL_UniformInfo> uniforms;
-};
-
-/**
- * @brief handle uniform buffers to transfear read-only data to a shader
- */
-class OGL_UniformBuffer : OGL_BindableBase
-{
-public:
+    void submit(bool sort = true);
 
     /**
-     * @brief Construct a new uniform buffer
+     * @brief remove all draws and reset the recording state. The memory is kept for the next frame
      */
-    OGL_UniformBuffer() = default;
+    void clear();
 
     /**
-     * @brief Construct a new uniform buffer
+     * @brief get the amount of recorded draws
      * 
-     * @param data the data for the buffer, or 0 to clear the data
-     * @param size the size of the data in bytes, or 0 to clear the data
-     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault
+     * @return size_t the amount of draws
      */
-    OGL_UniformBuffer(void* data, size_t size);
+    inline size_t getDrawCount() const {return this->packets.size();}
 
     /**
-     * @brief change the data that is stored in the buffer
+     * @brief get the recorded draws
      * 
-     * @param data the data for the buffer, or 0 to clear the data
-     * @param size the size of the data in bytes, or 0 to clear the data
-     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault 
+     * @return const std::vector<OGL_DrawPacket>& the draws in the order of recording
      */
-    void updateData(void* data, size_t size);
+    inline const std::vector<OGL_DrawPacket>& getPackets() const {return this->packets;}
 
     /**
-     * @brief add an element to the buffer
+     * @brief get the statistics of the last submission
      * 
-     * @tparam T the type of the new element
-     * @param element the element to add
+     * @return const OGL_CommandListStats& the statistics
      */
-    template<typename T> void addElement(T element)
-    {
-        //store the element index of the data
-        size_t i = this->data.size();
-        //add the size of T elements
-        for (size_t i = 0; i < sizeof(T); ++i) {this->data.push_back(0);}
-        //copy the data
-        memcpy(this->data.data() + i, &element, sizeof(T));
-    }
+    inline const OGL_CommandListStats& getStats() const {return this->stats;}
 
     /**
-     * @brief set an element in the element data
+     * @brief get how many state changes the last submission needed
      * 
-     * @tparam T the type of the element
-     * @param element the element to store
-     * @param index the index of the element in bytes
-     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     * @return uint64_t the amount of shader, vertex attribute, index buffer, texture and uniform buffer changes
      */
-    template<typename T> void setElement(T element, size_t index)
-    {
-        //check if the elment is in bounds
-        if ((index + sizeof(T)) > this->data.size())
-        {
-            //if not, throw an error
-            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
-            return;
-        }
-        //modify the element at the requested index
-        memcpy(this->data.data() + index, &element, sizeof(T));
-    }
+    uint64_t getStateChanges() const;
 
     /**
-     * @brief Get the Element at an specific index
+     * @brief get how many state changes sorting removed in the last submission
      * 
-     * @tparam T the type of the elment
-     * @param index the index to get the element from the data in bytes
-     * @return T the requested element
-     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     * @return uint64_t the state changes in the order of recording minus the state changes that where needed
      */
-    template<typename T> T getElement(size_t index)
-    {
-        //check if the elment is in bounds
-        if ((index + sizeof(T)) > this->data.size())
-        {
-            //if not, throw an error
-            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
-            return 0;
-        }
-        //return the requested data
-        return *((T*)((void*)this->data.data()));
-    }
+    uint64_t getRemovedStateChanges() const;
 
+private:
     /**
-     * @brief Get a pointer to an specific element
+     * @brief store a draw with the current state
      * 
-     * @tparam T the type of the object to get
-     * @param idx the index of the requested element in bytes
-     * @return T* a pointer to the requested element or NULL if the elment is out of bounds
-     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     * @param packet the draw arguments
      */
-    template<typename T> T* getRefElement(size_t idx)
-    {
-        //check if the elment is in bounds
-        if ((idx+sizeof(T)) > this->data.size())
-        {
-            //if not, throw an error
-            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
-            return 0;
-        }
+    void record(OGL_DrawPacket& packet);
 
-        //return the requested data
-        return ((T*)(this->data.data() + idx));
-    }
+    /**
+     * @brief calculate the sort keys of all draws
+     */
+    void calculateKeys();
 
     /**
-     * @brief upload the stored data to the GPU
+     * @brief sort the order of the draws by their keys with a radix sort
      */
-    void upload();
+    void sortKeys();
 
     /**
-     * @brief bind this buffer for use in a shader
+     * @brief count the state changes the draws need in an order, or replay them
      * 
-     * @param unit the unit to bind to
+     * @param order the order of the draws
+     * @param stats the statistics to fill
+     * @param execute true to replay the draws | false to only count the state changes
      */
-    void bind(uint8_t unit);
+    void replay(const std::vector<uint32_t>& order, OGL_CommandListStats& stats, bool execute);
 
     /**
-     * @brief unbind all buffers
+     * @brief store the recorded draws
      */
-    void unbind();
-
+    std::vector<OGL_DrawPacket> packets;
     /**
-     * @brief clear all data stored in the buffer
+     * @brief store the textures of all draws one after another
      */
-    inline void clear() {this->data.clear();}
-
+    std::vector<OGL_CommandTexture> textureArena;
     /**
-     * @brief Get a reference to the own data
-     * 
-     * @return std::vector<uint8_t>* a pointer to the stored data
+     * @brief store the uniform buffer ranges of all draws one after another
      */
-    inline std::vector<uint8_t>* getDataRef() {return &this->data;}
-
+    std::vector<OGL_CommandUniformRange> uniformArena;
     /**
-     * @brief Get the data stored in the buffer
-     * 
-     * @return std::vector<uint8_t> a vector of the data, structured in bytes
+     * @brief store the order the draws are replayed in
      */
-    inline std::vector<uint8_t> getData() {return this->data;}
-
-private:
+    std::vector<uint32_t> order;
     /**
-     * @brief handle the destruction of the object
+     * @brief store the order while it is sorted
      */
-    virtual void onDestroy() override;
-
+    std::vector<uint32_t> sortBuffer;
     /**
-     * @brief store the data of the buffer
+     * @brief store the shader for the next draw
      */
-    std::vector<uint8_t> data;
+    OGL_Shader* shader = 0;
     /**
-     * @brief store the buffer
+     * @brief store the vertex attributes for the next draw
      */
-    GLuint ubo = 0;
-
-};
-
-/**
- * @brief handle shader storage buffers to transfear read / write data to the GPU and read it back
- */
-class OGL_ShaderStorageBuffer : OGL_BindableBase
-{
-public:
-
+    OGL_VertexAttributes* vertexAttributes = 0;
     /**
-     * @brief Construct a new shader storage buffer
-     * 
+     * @brief store the index buffer for the next draw
      */
-    OGL_ShaderStorageBuffer() = default;
-
+    OGL_IndexBuffer* indexBuffer = 0;
     /**
-     * @brief Construct a new shader storage buffer
-     * 
-     * @param data the data for the buffer, or 0 to clear the data
-     * @param size the size of the data in bytes, or 0 to clear the data
-     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault 
+     * @brief store the textures for the next draw, sorted by their unit
      */
-    OGL_ShaderStorageBuffer(void* data, size_t size);
-
+    std::vector<OGL_CommandTexture> textures;
     /**
-     * @brief change the data that is stored in the buffer
-     * 
-     * @param data the data for the buffer, or 0 to clear the data
-     * @param size the size of the data in bytes, or 0 to clear the data
-     * @warning if the size of the data is bigger than the actual data this function can throw a segmentation fault 
+     * @brief store the uniform buffer ranges for the next draw, sorted by their binding point
      */
-    void updateData(void* data, size_t size);
-
+    std::vector<OGL_CommandUniformRange> uniforms;
     /**
-     * @brief clear all data stored in the buffer
+     * @brief store the statistics of the last submission
      */
-    inline void clear() {this->data.clear();}
+    OGL_CommandListStats stats;
+};
+
+/**
+ * @brief record draws into one command list per task on the worker threads and replay them on the thread of the instance. 
+ * The recording makes no OpenGL calls, the command lists are merged in the order of their index, so the result dose not depend on the timing of the threads
+ */
+class OGL_CommandRecorder
+{
+public:
 
     /**
-     * @brief add an element to the buffer
-     * 
-     * @tparam T the type of the new element
-     * @param element the element to add
+     * @brief Construct a new command recorder
      */
-    template<typename T> void addElement(T element)
-    {
-        //store the element index of the data
-        size_t i = this->data.size();
-        //add the size of T elements
-        for (size_t i = 0; i < sizeof(T); ++i) {this->data.push_back(0);}
-        //copy the data
-        memcpy(this->data.data() + i, &element, sizeof(T));
-    }
+    OGL_CommandRecorder() = default;
 
     /**
-     * @brief set an element in the element data
-     * 
-     * @tparam T the type of the element
-     * @param element the element to store
-     * @param index the index of the element in bytes
-     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     * @brief command recorders are used by worker threads, so they can't be copied
      */
-    template<typename T> void setElement(T element, size_t index)
-    {
-        //check if the elment is in bounds
-        if ((index + sizeof(T)) > this->data.size())
-        {
-            //if not, throw an error
-            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
-            return;
-        }
-        //modify the element at the requested index
-        memcpy(this->data.data() + index, &element, sizeof(T));
-    }
+    OGL_CommandRecorder(const OGL_CommandRecorder&) = delete;
 
     /**
-     * @brief Get the Element at an specific index
-     * 
-     * @tparam T the type of the elment
-     * @param index the index to get the element from the data in bytes
-     * @return T the requested element
-     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     * @brief command recorders are used by worker threads, so they can't be copied
      */
-    template<typename T> T getElement(size_t index)
-    {
-        //check if the elment is in bounds
-        if ((index + sizeof(T)) > this->data.size())
-        {
-            //if not, throw an error
-            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
-            return 0;
-        }
-        //return the requested data
-        return *((T*)((void*)this->data.data()));
-    }
+    OGL_CommandRecorder& operator=(const OGL_CommandRecorder&) = delete;
 
     /**
-     * @brief Get a pointer to an specific element
-     * 
-     * @tparam T the type of the object to get
-     * @param idx the index of the requested element in bytes
-     * @return T* a pointer to the requested element or NULL if the elment is out of bounds
-     * @warning if the index + the elment size is smaller than the size of the data, a runtime error is thrown
+     * @brief Destroy the command recorder. Running recordings are finished first
      */
-    template<typename T> T* getRefElement(size_t idx)
-    {
-        //check if the elment is in bounds
-        if ((idx+sizeof(T)) > this->data.size())
-        {
-            //if not, throw an error
-            std::__throw_runtime_error("The requested element is not in bounds of the uniform buffer");
-            return 0;
-        }
+    ~OGL_CommandRecorder();
 
-        //return the requested data
-        return ((T*)(this->data.data() + idx));
-    }
+    /**
+     * @brief start recording on the worker threads. Each task gets its own command list, which is cleared first. Recordings that are still running are finished first
+     * 
+     * @param func the function that records the draws. It gets the command list of the task, the user data and the index of the task. It must not make OpenGL calls
+     * @param data some abituary data that is passed into the function
+     * @param count the amount of tasks and command lists
+     * @param pool the worker pool to record on, or 0 to use the worker pool of the current instance
+     */
+    void record(void (*func)(OGL_CommandList*, void*, size_t), void* data, size_t count, OGL_WorkerPool* pool = 0);
 
     /**
-     * @brief upload the stored data to the GPU
+     * @brief wait until all tasks finished recording. If a task threw an error, it is thrown again here
      */
-    void upload();
+    void wait();
 
     /**
-     * @brief donalod the data from the GPU and store it
+     * @brief wait for the recording and merge all command lists in the order of their index
+     * 
+     * @return OGL_CommandList& the merged command list
      */
-    void download();
+    OGL_CommandList& merge();
 
     /**
-     * @brief bind this buffer for use in a shader
+     * @brief wait for the recording, merge the command lists and replay the draws. This must be called on the thread of the instance
      * 
-     * @param unit the unit to bind to
+     * @param sort true to sort the draws by their state first | false to keep the order of the tasks and of the recording
      */
-    void bind(uint8_t unit);
+    inline void submit(bool sort = true) {this->merge().submit(sort);}
 
     /**
-     * @brief unbind all buffers
+     * @brief Get the command list of a task
+     * 
+     * @param index the index of the task
+     * @return OGL_CommandList& the command list, don't use it while the task is running
      */
-    void unbind();
+    inline OGL_CommandList& getList(size_t index) {return this->lists[index];}
+
+    /**
+     * @brief Get the amount of command lists
+     * 
+     * @return size_t the amount of command lists, one for each task of the last recording
+     */
+    inline size_t getListCount() {return this->lists.size();}
+
+    /**
+     * @brief Get the merged command list
+     * 
+     * @return OGL_CommandList& the command list all draws where merged into
+     */
+    inline OGL_CommandList& getMerged() {return this->merged;}
 
 private:
+    /**
+     * @brief the function that runs on the worker threads
+     * 
+     * @param data the command recorder
+     * @param index the index of the task
+     */
+    static void runTask(void* data, size_t index);
 
     /**
-     * @brief handle the destruction of the object
+     * @brief store the command list of each task
      */
-    virtual void onDestroy() override;
+    std::vector<OGL_CommandList> lists;
+    /**
+     * @brief store the command list all lists are merged into
+     */
+    OGL_CommandList merged;
+    /**
+     * @brief store the function that records the draws
+     */
+    void (*func)(OGL_CommandList*, void*, size_t) = 0;
+    /**
+     * @brief store the data for the function
+     */
+    void* data = 0;
+    /**
+     * @brief store the amount of tasks that are still running
+     */
+    size_t pending = 0;
+    /**
+     * @brief store the first error a task threw
+     */
+    std::string error;
+    /**
+     * @brief store the mutex that protects the amount of running tasks and the error
+     */
+    std::mutex mutex;
+    /**
+     * @brief store the signal that is sent when all tasks are done
+     */
+    std::condition_variable signal;
+};
 
+/**
+ * @brief store the arguments of a single indexed indirect draw, laid out like OpenGL reads them from the draw indirect buffer
+ */
+struct OGL_DrawElementsIndirectCommand
+{
     /**
-     * @brief store the data for the buffer
+     * @brief store the amount of indices to draw
      */
-    std::vector<uint8_t> data;
+    uint32_t count = 0;
     /**
-     * @brief store the shader storage buffer object
+     * @brief store the amount of instances
      */
-    GLuint ssbo = 0;
+    uint32_t instanceCount = 1;
+    /**
+     * @brief store the first index to draw
+     */
+    uint32_t firstIndex = 0;
+    /**
+     * @brief store the value added to the indices
+     */
+    int32_t baseVertex = 0;
+    /**
+     * @brief store the first instance, it offsets instanced vertex attributes
+     */
+    uint32_t baseInstance = 0;
 };
 
 /**
- * @brief handle textures for OpenGL
+ * @brief store indirect draw commands on the GPU and issue many of them with a single call. The amount of draws can also be read from the GPU, 
+ * so compute shaders can cull draws without reading anything back
  */
-class OGL_Texture : OGL_BindableBase
+class OGL_DrawIndirectBuffer : OGL_BindableBase
 {
 public:
-
     /**
-     * @brief Construct a new texture
+     * @brief Construct a new draw indirect buffer
      */
-    OGL_Texture() = default;
+    OGL_DrawIndirectBuffer() = default;
 
     /**
-     * @brief Construct a new texture
+     * @brief Move a draw indirect buffer. The new object takes over the OpenGL objects, the old one can't be used anymore
      * 
-     * @param type the type of the texture
-     * @param width the width of the texture
-     * @param height the height of the texture
-     * @param layers the amount of layers for 3D textures
-     * @param internalFormat the internal format of the texture
+     * @param other the draw indirect buffer to move from
      */
-    OGL_Texture(OGL_TextureType type, uint32_t width, uint32_t height, uint32_t layers, GLenum internalFormat = GL_RGBA32F, GLenum format = GL_RGBA);
+    OGL_DrawIndirectBuffer(OGL_DrawIndirectBuffer&& other) = default;
 
     /**
-     * @brief Construct a new texture
+     * @brief Move a draw indirect buffer into an existing one. The OpenGL objects of this draw indirect buffer are destroyed first
      * 
-     * @param texFile the path to the texture
-     * @param internalFormat the internal format for the texture
+     * @param other the draw indirect buffer to move from
+     * @return OGL_DrawIndirectBuffer& a reference to this draw indirect buffer
      */
-    OGL_Texture(const char* texFile, GLenum internalFormat = GL_RGBA32F);
+    OGL_DrawIndirectBuffer& operator=(OGL_DrawIndirectBuffer&& other) = default;
 
     /**
-     * @brief Construct a new texture
+     * @brief Destroy the draw indirect buffer
+     */
+    ~OGL_DrawIndirectBuffer() {this->release();}
+
+    /**
+     * @brief Construct a new draw indirect buffer
      * 
-     * @param texFiles the texture files for the textures
-     * @param type the type of the texture
-     * @param internalFormat the internal format for the texture
+     * @param commands the draw commands. Pass a temporary or use std::move to store them without copying
+     * @param usage the usage hint for the storage of the buffer
      */
-    OGL_Texture(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat = GL_RGBA32F);
+    OGL_DrawIndirectBuffer(std::vector<OGL_DrawElementsIndirectCommand> commands, GLenum usage = GL_DYNAMIC_DRAW);
 
     /**
-     * @brief Construct a new texture
+     * @brief change all draw commands
      * 
-     * @param data the data for the texture
-     * @param width the width of the texture
-     * @param height the height of the texture
-     * @param format the format of the data
-     * @param type the type of the data
-     * @param internalFormat the internal format for the texture
+     * @param commands the new draw commands. Pass a temporary or use std::move to store them without copying
      */
-    OGL_Texture(void* data, uint32_t width, uint32_t height, GLenum format, GLenum type, GLenum internalFormat = GL_RGBA32F);
+    inline void updateData(std::vector<OGL_DrawElementsIndirectCommand> commands) {this->commands = std::move(commands); this->dirty.markAll();}
 
     /**
-     * @brief update the texture
+     * @brief change all draw commands by copying them from memory. The memory of the old commands is re-used
      * 
-     * @param texFile the texture file to read
-     * @param internalFormat the internal format of the texture
+     * @param commands a pointer to the first command
+     * @param count the amount of commands
      */
-    void setTexture(const char* texFile, GLenum internalFormat = GL_RGBA32F);
+    inline void setCommands(const OGL_DrawElementsIndirectCommand* commands, size_t count) {this->commands.assign(commands, commands + count); this->dirty.markAll();}
 
     /**
-     * @brief update the texture
+     * @brief add a draw command to the end of the buffer
      * 
-     * @param texFiles the texture files to read from
-     * @param type the type of the texture
-     * @param internalFormat the internal format of the texture
+     * @param command the draw command
      */
-    void setTexture(std::vector<const char*> texFiles, OGL_TextureType type, GLenum internalFormat = GL_RGBA32F);
+    inline void addCommand(const OGL_DrawElementsIndirectCommand& command) {this->dirty.mark(this->commands.size()*sizeof(OGL_DrawElementsIndirectCommand), sizeof(OGL_DrawElementsIndirectCommand)); this->commands.push_back(command);}
 
     /**
-     * @brief update the texture
+     * @brief access a draw command. The command is uploaded again with the next upload
      * 
-     * @param data the data for the texture
-     * @param width the width of the texture
-     * @param height the height of the texture
-     * @param format the format of the data
-     * @param type the type of the data
-     * @param internalFormat the internal format for the texture
+     * @param idx the index of the command
+     * @return OGL_DrawElementsIndirectCommand& a reference to the command
+     */
+    OGL_DrawElementsIndirectCommand& operator[](size_t idx);
+
+    /**
+     * @brief remove all draw commands
      */
-    void setTexture(void* data, uint32_t width, uint32_t height, GLenum format, GLenum type, GLenum internalFormat = GL_RGBA32F);
+    inline void clear() {this->commands.clear();}
 
     /**
-     * @brief bind the texture to a specific unit
+     * @brief Get the amount of draw commands
      * 
-     * @param unit the unit to unbind from
+     * @return size_t the amount of commands
      */
-    void bind(uint8_t unit);
+    inline size_t getCommandCount() {return this->commands.size();}
 
     /**
-     * @brief unbind the texture from a specific unit
+     * @brief set an amount of draws that is read from the GPU by drawCount
      * 
-     * @param unit the unit to unbind from
+     * @param index the index of the amount
+     * @param count the amount of draws
      */
-    void unbind(uint8_t unit);
+    void setDrawCount(size_t index, uint32_t count);
+
+    /**
+     * @brief upload the changed draw commands and the amounts of draws. The storage is only re-allocated if the commands don't fit into it
+     */
+    void upload();
+
+    /**
+     * @brief bind this as the current draw indirect buffer
+     */
+    void bind();
+
+    /**
+     * @brief unbind any draw indirect buffer
+     */
+    void unbind();
 
     /**
-     * @brief Set any OpenGL texture parameter for the texture
+     * @brief bind the draw commands as a shader storage buffer, so a compute shader can change them
      * 
-     * @param parameter the parameter to set
-     * @param value the value for the parameter
+     * @param unit the shader storage buffer binding point
      */
-    void setTexParameter(GLenum parameter, GLenum value);
+    void bindStorage(uint8_t unit);
 
     /**
-     * @brief Create a mipmap for the texture
+     * @brief bind the amounts of draws as a shader storage buffer, so a compute shader can change them. The amounts must be set and uploaded first
+     * 
+     * @param unit the shader storage buffer binding point
      */
-    void createMipmap();
+    void bindCountStorage(uint8_t unit);
 
     /**
-     * @brief Get the type of the texture
+     * @brief issue draw commands with a single call (OpenGL 4.3 or newer, else they are issued one by one). 
+     * The shader, vertex attributes and index buffer must be bound, the indices are read as 32-Bit unsigned integers
      * 
-     * @return OGL_TextureType the texture type
+     * @param mode the type of primitive
+     * @param first the index of the first command
+     * @param count the amount of commands, or 0 for all commands after the first
      */
-    inline OGL_TextureType getType() {return this->type;}
+    void draw(GLenum mode = GL_TRIANGLES, size_t first = 0, size_t count = 0);
 
     /**
-     * @brief Get the OpenGL texture
+     * @brief issue draw commands with a single call and read the amount of draws from the GPU (OpenGL 4.6 or newer). 
+     * Without support, the amount that was set on the CPU is used
      * 
-     * @return GLuint the OpenGL texture
+     * @param mode the type of primitive
+     * @param countIndex the index of the amount of draws
+     * @param first the index of the first command
+     * @param maxCount the most commands that are drawn, or 0 for all commands after the first
      */
-    inline GLuint getTexture() {return this->texture;}
+    void drawCount(GLenum mode = GL_TRIANGLES, size_t countIndex = 0, size_t first = 0, size_t maxCount = 0);
 
 private:
     /**
-     * @brief delete the object
+     * @brief handle the destruction of the buffer
      */
     virtual void onDestroy() override;
+
     /**
-     * @brief store the type of the texture
+     * @brief store the draw commands
      */
-    OGL_TextureType type;
+    std::vector<OGL_DrawElementsIndirectCommand> commands;
     /**
-     * @brief store the internal format depending on type
+     * @brief store the amounts of draws for drawCount
      */
-    GLenum format = 0;
+    std::vector<uint32_t> counts;
     /**
-     * @brief store the OpenGL texture
+     * @brief store the buffer for the draw commands
      */
-    GLuint texture = 0;
+    GLuint buffer = 0;
     /**
-     * @brief store the width of the texture in pixels
+     * @brief store the buffer for the amounts of draws, it is created when the amounts are first uploaded
      */
-    uint32_t width = 0;
+    GLuint countBuffer = 0;
     /**
-     * @brief store the height of the texture in pixels
+     * @brief store the size of the storage for the draw commands in bytes
      */
-    uint32_t height = 0;
+    size_t gpuSize = 0;
     /**
-     * @brief store the amount of layers in the texture
+     * @brief store the size of the storage for the amounts of draws in bytes
      */
-    uint32_t layers = 0;
+    size_t countGpuSize = 0;
+    /**
+     * @brief store if the amounts of draws changed since the last upload
+     */
+    bool countsDirty = false;
+    /**
+     * @brief store the ranges that where modified since the last upload
+     */
+    OGL_DirtyRanges dirty;
+    /**
+     * @brief store the usage hint and the upload counters
+     */
+    OGL_BufferUsageTracker usage = OGL_BufferUsageTracker(GL_DYNAMIC_DRAW);
 };
 
 /**
- * @brief store the information about a single color attachment
+ * @brief store a draw that was added to a draw batcher
  */
-struct OGL_FramebufferAttachment
+struct OGL_BatchedDraw
 {
     /**
-     * @brief store a pointer to the texture to use
-     */
-    OGL_Texture* texture = 0;
-    /**
-     * @brief store the id of the attachment unit
+     * @brief store the index of the batch of the draw
      */
-    uint8_t attachmentID = 0;
+    uint32_t batch = 0;
     /**
-     * @brief store the type of attachment
+     * @brief store the arguments of the draw
      */
-    OGL_FramebufferAttachmentType type = OGL_COLOR_ATTACHMENT;
+    OGL_DrawElementsIndirectCommand command;
     /**
-     * @brief for layers and cube maps, selecte the layer to use
+     * @brief store the offset of the data of the draw in the data of the batcher, in bytes
      */
-    uint8_t layerSelect = 0;
+    size_t dataOffset = 0;
 };
 
 /**
- * @brief handle multiple framebuffers
+ * @brief store the draws of a draw batcher that share a shader, vertex attributes and an index buffer
  */
-class OGL_Framebuffer : OGL_BindableBase
+struct OGL_DrawBatch
 {
-public:
-
     /**
-     * @brief Construct a new framebuffer
+     * @brief store the shader of the batch
      */
-    OGL_Framebuffer() = default;
-
+    OGL_Shader* shader = 0;
     /**
-     * @brief Construct a new framebuffer
-     * 
-     * @param attachments the attachments for the framebuffer
+     * @brief store the vertex attributes of the batch
      */
-    OGL_Framebuffer(std::vector<OGL_FramebufferAttachment> attachments);
-
+    OGL_VertexAttributes* vertexAttributes = 0;
     /**
-     * @brief update all the attachments bound to the framebuffer
+     * @brief store the index buffer of the batch
      */
-    void updateAttachmentBindings();
-
+    OGL_IndexBuffer* indexBuffer = 0;
     /**
-     * @brief access a specific framebuffer attachment
-     * @warning this operator dose not check if the element belongs to the framebuffer. If the index is out of range, this may lead to undefined behaviour
-     * 
-     * @param index the index of that attachment
-     * @return OGL_FramebufferAttachment& a reference of the attachment
+     * @brief store the index of the first command of the batch in the draw indirect buffer
      */
-    inline OGL_FramebufferAttachment& operator[](size_t index) {return this->attachments[index];}
-
+    uint32_t firstCommand = 0;
     /**
-     * @brief bind the framebuffer
-     * 
-     * @param target the framebuffer type to bind to
+     * @brief store the amount of draws in the batch
      */
-    void bind(GLenum target = GL_FRAMEBUFFER);
-
+    uint32_t commandCount = 0;
     /**
-     * @brief unbind the framebuffer
-     * 
-     * @param target the framebuffer type to unbind from
+     * @brief store the offset of the data of the batch in the shader storage buffer, in bytes
      */
-    void unbind(GLenum target = GL_FRAMEBUFFER);
-
-private:
-    virtual void onDestroy() override;
-
-    GLuint framebuffer;
-
-    std::vector<OGL_FramebufferAttachment> attachments;
+    size_t dataOffset = 0;
 };
 
-class OGL_ComputeShader : OGL_BindableBase
+/**
+ * @brief collect draws and issue all draws that share a shader, vertex attributes and an index buffer with a single multi draw call. 
+ * The data of each draw is stored in a shader storage buffer, the shader reads it with gl_DrawID (OpenGL 4.6 or GL_ARB_shader_draw_parameters)
+ */
+class OGL_DrawBatcher
 {
 public:
 
-    OGL_ComputeShader() = default;
+    /**
+     * @brief Construct a new draw batcher
+     */
+    OGL_DrawBatcher() = default;
 
-    OGL_ComputeShader(const char* input, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
+    /**
+     * @brief draw batchers own their buffers, so they can't be copied
+     */
+    OGL_DrawBatcher(const OGL_DrawBatcher&) = delete;
+
+    /**
+     * @brief draw batchers own their buffers, so they can't be copied
+     */
+    OGL_DrawBatcher& operator=(const OGL_DrawBatcher&) = delete;
 
+    /**
+     * @brief Destroy the draw batcher and its buffers
+     */
+    ~OGL_DrawBatcher();
 
     /**
-     * @brief change this shader to a new shader
+     * @brief Construct a new draw batcher
      * 
-     * @param cs the compute shader information, in the format specified by type
-     * @param type the type the data is given in, can be inputed as file, source or binary
+     * @param drawDataSize the size of the data of each draw in bytes, or 0 if the draws have no data. Use the std430 layout in the shader
+     * @param dataUnit the shader storage buffer binding point the data of the current batch is bound to
+     * @param mode the type of primitive of all draws
      */
-    void recompileShader(std::string cs, OGL_ShaderInput type = OGL_SHADER_INPUT_FILE);
+    OGL_DrawBatcher(size_t drawDataSize, uint8_t dataUnit = 0, GLenum mode = GL_TRIANGLES);
 
     /**
-     * @brief Get the Compiled Shader on the GPU
+     * @brief add a draw
      * 
-     * @return uint32_t the compiled OpenGL shader on the GPU
+     * @param shader the shader to draw with
+     * @param vertexAttributes the vertex attributes to draw with, they also store the vertex buffer
+     * @param indexBuffer the index buffer to draw with
+     * @param count the amount of indices to draw
+     * @param firstIndex the first index to draw
+     * @param baseVertex the value added to the indices
+     * @param instanceCount the amount of instances
+     * @param drawData a pointer to the data of the draw with the size that was set for the batcher, or 0 to fill it with zeros
      */
-    inline uint32_t getCompiledShader() {return this->shader;}
+    void add(OGL_Shader* shader, OGL_VertexAttributes* vertexAttributes, OGL_IndexBuffer* indexBuffer, uint32_t count, uint32_t firstIndex = 0, int32_t baseVertex = 0, uint32_t instanceCount = 1, const void* drawData = 0);
 
     /**
-     * @brief bind the shader
+     * @brief upload the draws and issue a multi draw call for each batch. The batches are drawn in the order they where first used
+     * 
+     * @param useDrawCount true to read the amount of draws from the GPU if the context supports it (OpenGL 4.6 or newer) | false to pass it from the CPU
      */
-    void bind();
+    void submit(bool useDrawCount = true);
 
     /**
-     * @brief unbind the shader
+     * @brief remove all draws. The memory is kept for the next frame
      */
-    void unbind();
+    void clear();
 
     /**
-     * @brief Set the uniforms for the buffer
+     * @brief get the amount of added draws
      * 
-     * @param uniforms the uniforms for the shader
+     * @return size_t the amount of draws
      */
-    inline void setUniforms(std::vector<OGL_UniformInfo> uniforms) {this->uniforms = uniforms;}
+    inline size_t getDrawCount() {return this->draws.size();}
 
     /**
-     * @brief Get a pointer to all stored uniforms
+     * @brief get the amount of batches the added draws are sorted into
      * 
-     * @return std::vector<OGL_UniformInfo>* a pointer to the internal vector of uniforms
+     * @return size_t the amount of batches
      */
-    inline std::vector<OGL_UniformInfo>* getUniformPtr() {return &this->uniforms;}
+    inline size_t getBatchCount() {return this->batches.size();}
 
     /**
-     * @brief Get the amount of stored uniforms
+     * @brief get the batches the added draws are sorted into. The offsets are set when the draws are submitted
      * 
-     * @return size_t the amount of uniforms
+     * @return const std::vector<OGL_DrawBatch>& the batches
      */
-    inline size_t getUniformCount() {return this->uniforms.size();}
+    inline const std::vector<OGL_DrawBatch>& getBatches() {return this->batches;}
 
     /**
-     * @brief get a specific uniform from the shader. If it dosn't exist, create it
+     * @brief Get the draw indirect buffer, like to cull the draws of the last submission with a compute shader
      * 
-     * @param name the name of the uniform
-     * @return OGL_UniformInfo& a reference to the uniform
+     * @return OGL_DrawIndirectBuffer* the draw indirect buffer or 0 if nothing was submitted yet
      */
-    OGL_UniformInfo& operator[](std::string name);
+    inline OGL_DrawIndirectBuffer* getIndirectBuffer() {return this->indirect;}
 
     /**
-     * @brief get a specific uniform from the shader. If it dosn't exist, throw an error
+     * @brief Get the shader storage buffer with the data of all draws
      * 
-     * @param index the index of the 
-     * @return OGL_UniformInfo& 
+     * @return OGL_ShaderStorageBuffer* the shader storage buffer or 0 if nothing was submitted yet
      */
-    OGL_UniformInfo& operator[](size_t index);
+    inline OGL_ShaderStorageBuffer* getDataBuffer() {return this->data;}
 
+private:
     /**
-     * @brief update the positions of all uniforms
+     * @brief store the added draws
      */
-    void recalculateUniforms();
-
-private: 
+    std::vector<OGL_BatchedDraw> draws;
     /**
-     * @brief clean up the object after destruction
+     * @brief store the data of the added draws one after another
      */
-    virtual void onDestroy() override;
-
+    std::vector<uint8_t> drawData;
     /**
-     * @brief store the OpenGL shader
+     * @brief store the batches, in the order they where first used
      */
-    GLuint shader = 0;
+    std::vector<OGL_DrawBatch> batches;
     /**
-     * @brief store information about all the uniforms
+     * @brief store the batch the last draw was added to, consecutive draws mostly share it
      */
-    std::vector<OGL_UniformInfo> uniforms;
+    uint32_t lastBatch = 0;
+    /**
+     * @brief store the draw commands sorted by their batch
+     */
+    std::vector<OGL_DrawElementsIndirectCommand> commands;
+    /**
+     * @brief store the data of the draws sorted by their batch, each batch starts at an aligned offset
+     */
+    std::vector<uint8_t> sortedData;
+    /**
+     * @brief store the draw indirect buffer, it is created with the first submission
+     */
+    OGL_DrawIndirectBuffer* indirect = 0;
+    /**
+     * @brief store the shader storage buffer for the data of the draws, it is created with the first submission
+     */
+    OGL_ShaderStorageBuffer* data = 0;
+    /**
+     * @brief store the size of the data of each draw in bytes
+     */
+    size_t drawDataSize = 0;
+    /**
+     * @brief store the binding point for the data
+     */
+    uint8_t dataUnit = 0;
+    /**
+     * @brief store the type of primitive
+     */
+    GLenum mode = GL_TRIANGLES;
 };
 
 //undefine the helper macros
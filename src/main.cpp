@@ -158,15 +158,70 @@ void debugCallback(GLenum source, GLenum type, GLuint, GLenum severity, GLsizei,
     }
 }
 
+//the objects the passes of the frame graph render with
+struct FrameData
+{
+    OGL_Window* window;
+    OGL_FrameGraph* graph;
+    OGL_Renderbuffer* msaaDepth;
+    uint32_t msaaColor;
+    uint32_t color;
+    uint32_t scenePass;
+    OGL_CommandList* commands;
+    OGL_Shader* shader;
+    OGL_VertexAttributes* VAO;
+    OGL_IndexBuffer* IBO;
+    OGL_Texture* texture;
+    OGL_Shader* ppsShader;
+    OGL_VertexBuffer<unsigned int>* ppsVBO;
+    OGL_VertexAttributes* ppsVAO;
+};
+
 //function to call on window resize
 void onResize(uint32_t width, uint32_t height, void* userData)
 {
-    //re-interprete the user data as a texture array
-    OGL_Texture* textures = (OGL_Texture*)userData;
-    //call a resize on the first texture
-    textures[0].setTexture(0, width, height, GL_RGBA, GL_FLOAT, GL_RGBA16F);
-    //call a resize on the second texture
-    textures[1].setTexture(0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, GL_DEPTH_COMPONENT24);
+    //re-interprete the user data as the frame data
+    FrameData* frame = (FrameData*)userData;
+    //the transient textures get the new size from the pool in the next frame
+    frame->graph->setTextureSize(frame->msaaColor, width, height);
+    frame->graph->setTextureSize(frame->color, width, height);
+    //the depth buffer is owned by the example
+    frame->msaaDepth->resize(width, height);
+}
+
+//render the cube into the multisampled targets
+void renderScene(OGL_FrameGraph*, uint32_t, void* userData)
+{
+    FrameData* frame = (FrameData*)userData;
+    glEnable(GL_DEPTH_TEST);
+    //record the draws of the scene and replay them sorted by their state
+    frame->commands->clear();
+    frame->commands->setShader(frame->shader);
+    frame->commands->setVertexAttributes(frame->VAO);
+    frame->commands->setIndexBuffer(frame->IBO);
+    frame->commands->setTexture(0, frame->texture);
+    frame->commands->drawElements(frame->IBO->getIndexCount());
+    frame->commands->submit();
+}
+
+//resolve the samples of the scene into a single sampled texture
+void resolveScene(OGL_FrameGraph* graph, uint32_t pass, void* userData)
+{
+    FrameData* frame = (FrameData*)userData;
+    graph->getFramebuffer(frame->scenePass)->resolve(graph->getFramebuffer(pass), frame->window->getWidth(), frame->window->getHeight());
+}
+
+//draw the resolved scene to the window
+void renderPost(OGL_FrameGraph* graph, uint32_t, void* userData)
+{
+    FrameData* frame = (FrameData*)userData;
+    glDisable(GL_DEPTH_TEST);
+    graph->getTexture(frame->color)->bind(0);
+    frame->ppsShader->bind();
+    frame->ppsVBO->bind();
+    frame->ppsVAO->bind();
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    graph->getTexture(frame->color)->unbind(0);
 }
 
 int main()
@@ -229,6 +284,10 @@ int main()
         OGL_VertexAttribute{1, OGL_TYPE_UINT, false}
     }, sizeof(unsigned int));
 
+    VBO.releaseCPUData();
+    IBO.releaseCPUData();
+    ppsVBO.releaseCPUData();
+
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
     glEnable(GL_CULL_FACE);
@@ -238,6 +297,7 @@ int main()
 
     OGL_UniformBuffer UBO(0,0);
     vec3 pos = {{0,0,-2}};
+    if (!UBO.enableStreaming(sizeof(mat4)*2 + sizeof(float))) {std::cerr << "Immutable buffer storage is not supported, the uniform buffer is not streamed\n";}
     UBO.bind(0);
 
     OGL_UniformBuffer Proj(0,0);
@@ -254,27 +314,13 @@ int main()
     Proj.upload();
     Proj.bind(1);
 
-    OGL_Texture colorTex = OGL_Texture(OGL_TEXTURE_2D, window.getWidth(), window.getHeight(), 0, GL_RGBA32F);
-    colorTex.setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    colorTex.setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    colorTex.setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    colorTex.setTexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    OGL_Texture depthTex = OGL_Texture(OGL_TEXTURE_2D, window.getWidth(), window.getHeight(), 0, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT); 
-    depthTex.setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    depthTex.setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    depthTex.setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    depthTex.setTexParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    OGL_Framebuffer framebuff = OGL_Framebuffer({
-        OGL_FramebufferAttachment{&colorTex, 0, OGL_COLOR_ATTACHMENT, 0},
-        OGL_FramebufferAttachment{&depthTex, 0, OGL_DEPTH_ATTACHMENT, 0}
-    });
-
-    OGL_Texture framebufferTextures[] = {colorTex, depthTex};
-    window.setOnResizeHook(onResize, framebufferTextures);
+    OGL_Sampler pixelSampler = OGL_Sampler(GL_NEAREST, GL_NEAREST);
+    OGL_RenderTargetPool targetPool;
+    OGL_FrameGraph graph(&targetPool);
+    OGL_Renderbuffer msaaDepth = OGL_Renderbuffer(window.getWidth(), window.getHeight(), GL_DEPTH_COMPONENT24, 4);
 
     OGL_Texture texture("src/cubeTexture.png");
-    texture.setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    texture.setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    texture.setSampler(&pixelSampler);
     texture.bind(0);
 
     OGL_Shader shader = OGL_Shader("src/vertex.vs", "src/fragment.fs");
@@ -286,12 +332,37 @@ int main()
     ppsShader["mainBuff"] = oglCreateUniformInfo<int>("mainBuff", 0, OGL_TYPE_INT);
     ppsShader.recalculateUniforms();
 
+    OGL_CommandList commands;
+    FrameData frame = {&window, &graph, &msaaDepth, 0, 0, 0, &commands, &shader, &VAO, &IBO, &texture, &ppsShader, &ppsVBO, &ppsVAO};
+    frame.msaaColor = graph.createTexture("msaaColor", window.getWidth(), window.getHeight(), GL_R11F_G11F_B10F, 4);
+    uint32_t depth = graph.importRenderbuffer("msaaDepth", &msaaDepth);
+    frame.color = graph.createTexture("color", window.getWidth(), window.getHeight(), GL_R11F_G11F_B10F);
+
+    OGL_AttachmentOps sceneColor;
+    sceneColor.load = OGL_LOAD_OP_CLEAR;
+    sceneColor.clearColor[0] = sceneColor.clearColor[1] = sceneColor.clearColor[2] = .5f;
+    sceneColor.clearColor[3] = 1.f;
+    OGL_AttachmentOps sceneDepth;
+    sceneDepth.load = OGL_LOAD_OP_CLEAR;
+    sceneDepth.store = OGL_STORE_OP_DISCARD;
+    frame.scenePass = graph.addPass("scene", renderScene, &frame);
+    graph.write(frame.scenePass, frame.msaaColor, sceneColor);
+    graph.write(frame.scenePass, depth, sceneDepth);
+    uint32_t resolvePass = graph.addPass("resolve", resolveScene, &frame);
+    graph.read(resolvePass, frame.msaaColor);
+    graph.write(resolvePass, frame.color);
+    OGL_AttachmentOps windowOps;
+    windowOps.load = OGL_LOAD_OP_DONT_CARE;
+    uint32_t postPass = graph.addPass("post", renderPost, &frame);
+    graph.read(postPass, frame.color);
+    graph.writeBackbuffer(postPass, windowOps, windowOps);
+    window.setOnResizeHook(onResize, &frame);
+
     float a = 0.f;
     float b = 0.f;
     float c = 0.f;
     while (!window.isClosingRequested())
     {
-        glEnable(GL_DEPTH_TEST);
         UBO.clear();
         updatePos(&UBO, pos);
         a = std::fmod(a + 0.002f, 2.0*M_PI);
@@ -301,25 +372,9 @@ int main()
         UBO.addElement<float>(window.getHeight() / (float)window.getWidth());
         UBO.upload();
 
-        framebuff.bind();
         oglHandleAllEvents();
 
-        window.clear();
-        shader.bind();
-        VBO.bind();
-        VAO.bind();
-        IBO.bind();
-        texture.bind(0);
-        glDrawElements(GL_TRIANGLES, IBO.getIndexCount(), GL_UNSIGNED_INT, 0);
-
-        framebuff.unbind();
-        glDisable(GL_DEPTH_TEST);
-        colorTex.bind(0);
-        ppsShader.bind();
-        ppsVBO.bind();
-        ppsVAO.bind();
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        colorTex.unbind(0);
+        graph.execute();
         window.flip();
     }
 }
\ No newline at end of file
@@ -0,0 +1,281 @@
+/**
+ * @file pixelBenchmark.cpp
+ * @author DM8AT
+ * @brief a benchmark for the pixel conversions of the texture loading. It compares the vector kernels with the scalar kernels and the SDL conversions
+ * @version 0.1
+ * @date 2024-08-24
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "ObjectGL/ObjectGL.hpp"
+#include <iostream>
+#include <chrono>
+
+//the size of the test image, a full HD frame
+#define BENCH_WIDTH 1920
+#define BENCH_HEIGHT 1080
+//the amount of runs per measurement, the fastest run is reported
+#define BENCH_RUNS 20
+
+/**
+ * @brief store the result of the benchmark, it is 0 if all outputs matched
+ */
+static int benchResult = 0;
+
+/**
+ * @brief fill memory with deterministic noise
+ *
+ * @param data the memory to fill
+ * @param size the size of the memory in bytes
+ */
+void fillNoise(uint8_t* data, size_t size)
+{
+    //a simple linear congruential generator, so every run uses the same image
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < size; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (uint8_t)(state >> 24);
+    }
+}
+
+/**
+ * @brief measure a function and return the time of the fastest run
+ *
+ * @param func the function to measure
+ * @param userData the data passed to the function
+ * @return double the time of the fastest run in milliseconds
+ */
+double measure(void (*func)(void* userData), void* userData)
+{
+    //store the fastest run
+    double best = 1e30;
+    for (int i = 0; i < BENCH_RUNS; ++i)
+    {
+        //time a single run
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        (*func)(userData);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (ms < best) {best = ms;}
+    }
+    //return the fastest run
+    return best;
+}
+
+/**
+ * @brief print a line of the results
+ *
+ * @param name the name of the measurement
+ * @param ms the time in milliseconds
+ * @param reference the time to compare with in milliseconds, or 0 to print no speedup
+ */
+void report(const char* name, double ms, double reference)
+{
+    std::cout << "  " << name << ": " << ms << " ms";
+    if (reference > 0.0) {std::cout << " (" << reference / ms << "x)";}
+    std::cout << "\n";
+}
+
+/**
+ * @brief compare the output of a kernel with the output of the scalar kernel
+ *
+ * @param name the name of the kernel
+ * @param a the output of the vector kernel
+ * @param b the output of the scalar kernel
+ * @param size the size of the outputs in bytes
+ */
+void compare(const char* name, const void* a, const void* b, size_t size)
+{
+    //check if the outputs are the same
+    if (memcmp(a, b, size) == 0) {std::cout << "  " << name << ": outputs match\n"; return;}
+    //else, the benchmark failed
+    std::cout << "  " << name << ": OUTPUTS DIFFER\n";
+    benchResult = 1;
+}
+
+/**
+ * @brief store the buffers for the kernels
+ */
+struct KernelData
+{
+    uint8_t* src;
+    uint8_t* dst;
+    uint16_t* half;
+    size_t count;
+};
+
+//functions that call a single kernel, so they can be measured
+void runRGBToRGBA(void* data) {KernelData* d = (KernelData*)data; oglConvertRGBToRGBA(d->src, d->dst, d->count);}
+void runSwizzle(void* data) {KernelData* d = (KernelData*)data; oglSwizzleRedBlue(d->src, d->dst, d->count);}
+void runPremultiply(void* data) {KernelData* d = (KernelData*)data; memcpy(d->dst, d->src, d->count*4); oglPremultiplyAlpha(d->dst, d->count);}
+void runU8ToHalf(void* data) {KernelData* d = (KernelData*)data; oglConvertU8ToHalf(d->src, d->half, d->count*4);}
+
+/**
+ * @brief measure a kernel with and without the vector instructions and compare the outputs
+ *
+ * @param name the name of the kernel
+ * @param func the function that calls the kernel
+ * @param data the buffers of the kernel
+ * @param output the output of the kernel
+ * @param size the size of the output in bytes
+ */
+void benchKernel(const char* name, void (*func)(void* userData), KernelData* data, void* output, size_t size)
+{
+    std::cout << name << "\n";
+    //run the scalar kernel and keep its output
+    oglSetPixelSIMD(false);
+    double scalar = measure(func, data);
+    std::vector<uint8_t> reference((uint8_t*)output, (uint8_t*)output + size);
+    //run the vector kernel
+    oglSetPixelSIMD(true);
+    double simd = measure(func, data);
+    //print the results
+    report("scalar", scalar, 0.0);
+    report("simd", simd, scalar);
+    compare("simd", output, reference.data(), size);
+}
+
+/**
+ * @brief store the surfaces for the SDL measurements
+ */
+struct SurfaceData
+{
+    SDL_Surface* src;
+    SDL_Surface* dst;
+    SDL_Surface* converted;
+    uint8_t* pixels;
+    OGL_PixelData image;
+};
+
+//functions that call a single conversion, so they can be measured
+void runSDLConvert(void* data) {SurfaceData* d = (SurfaceData*)data; if (d->converted) {SDL_FreeSurface(d->converted);} d->converted = SDL_ConvertSurfaceFormat(d->src, SDL_PIXELFORMAT_RGBA32, 0);}
+void runSDLBlit(void* data) {SurfaceData* d = (SurfaceData*)data; SDL_BlitSurface(d->src, 0, d->dst, 0);}
+void runDescribe(void* data) {SurfaceData* d = (SurfaceData*)data; oglDescribeSurface(d->src, d->image);}
+void runRowsRGB(void* data)
+{
+    SurfaceData* d = (SurfaceData*)data;
+    //convert row by row, the rows of the surface may be padded
+    for (int y = 0; y < d->src->h; ++y) {oglConvertRGBToRGBA((uint8_t*)d->src->pixels + y*d->src->pitch, d->pixels + (size_t)y*d->src->w*4, d->src->w);}
+}
+void runRowsBGRA(void* data)
+{
+    SurfaceData* d = (SurfaceData*)data;
+    //convert row by row, the rows of the surface may be padded
+    for (int y = 0; y < d->src->h; ++y) {oglSwizzleRedBlue((uint8_t*)d->src->pixels + y*d->src->pitch, d->pixels + (size_t)y*d->src->w*4, d->src->w);}
+}
+
+/**
+ * @brief compare tightly packed RGBA pixels with the pixels of a surface
+ *
+ * @param name the name of the conversion
+ * @param pixels the packed pixels
+ * @param surf the surface, it may have padded rows
+ */
+void compareSurface(const char* name, const uint8_t* pixels, SDL_Surface* surf)
+{
+    //check if the surface exists
+    if (!surf) {std::cout << "  " << name << ": SDL failed to convert the surface: " << SDL_GetError() << "\n"; benchResult = 1; return;}
+    //compare row by row
+    for (int y = 0; y < surf->h; ++y)
+    {
+        if (memcmp(pixels + (size_t)y*surf->w*4, (uint8_t*)surf->pixels + y*surf->pitch, (size_t)surf->w*4) == 0) {continue;}
+        std::cout << "  " << name << ": OUTPUTS DIFFER in row " << y << "\n";
+        benchResult = 1;
+        return;
+    }
+    std::cout << "  " << name << ": outputs match\n";
+}
+
+/**
+ * @brief measure the conversion of a surface to RGBA with SDL and with the library
+ *
+ * @param name the name of the source format
+ * @param format the SDL format of the source surface
+ * @param rows the function that converts the surface with the kernels of the library
+ */
+void benchSurface(const char* name, Uint32 format, void (*rows)(void* userData))
+{
+    std::cout << name << " surface to RGBA\n";
+    //create the surfaces
+    SurfaceData data;
+    data.src = SDL_CreateRGBSurfaceWithFormat(0, BENCH_WIDTH, BENCH_HEIGHT, 32, format);
+    data.dst = SDL_CreateRGBSurfaceWithFormat(0, BENCH_WIDTH, BENCH_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+    data.converted = 0;
+    //check if SDL could create them
+    if (!data.src || !data.dst)
+    {
+        std::cout << "  SDL failed to create the surfaces: " << SDL_GetError() << "\n";
+        if (data.src) {SDL_FreeSurface(data.src);}
+        if (data.dst) {SDL_FreeSurface(data.dst);}
+        benchResult = 1;
+        return;
+    }
+    //the blit must copy the pixels, not blend them with the destination
+    SDL_SetSurfaceBlendMode(data.src, SDL_BLENDMODE_NONE);
+    //fill the source with noise
+    fillNoise((uint8_t*)data.src->pixels, (size_t)data.src->pitch * data.src->h);
+    data.pixels = new uint8_t[(size_t)BENCH_WIDTH * BENCH_HEIGHT * 4];
+
+    //measure the SDL conversions
+    double convert = measure(runSDLConvert, &data);
+    double blit = measure(runSDLBlit, &data);
+    //measure the library, the format is checked first and the kernel converts what can't be uploaded in place
+    double describe = measure(runDescribe, &data);
+    double kernel = measure(rows, &data);
+    //print the results
+    report("SDL_ConvertSurfaceFormat", convert, 0.0);
+    report("SDL_BlitSurface", blit, convert);
+    report("oglDescribeSurface (upload in place)", describe, convert);
+    report("oglDescribeSurface + kernel", describe + kernel, convert);
+    //the kernel must produce the same pixels as SDL and as the scalar kernel
+    compareSurface("kernel vs SDL_ConvertSurfaceFormat", data.pixels, data.converted);
+    compareSurface("kernel vs SDL_BlitSurface", data.pixels, data.dst);
+    std::vector<uint8_t> simd(data.pixels, data.pixels + (size_t)BENCH_WIDTH * BENCH_HEIGHT * 4);
+    oglSetPixelSIMD(false);
+    (*rows)(&data);
+    oglSetPixelSIMD(true);
+    compare("kernel vs scalar kernel", simd.data(), data.pixels, simd.size());
+
+    //free the surfaces
+    delete[] data.pixels;
+    if (data.converted) {SDL_FreeSurface(data.converted);}
+    SDL_FreeSurface(data.dst);
+    SDL_FreeSurface(data.src);
+}
+
+int main()
+{
+    //store the amount of pixels
+    size_t count = (size_t)BENCH_WIDTH * BENCH_HEIGHT;
+    std::cout << "Pixel conversion benchmark, " << BENCH_WIDTH << "x" << BENCH_HEIGHT << ", fastest of " << BENCH_RUNS << " runs\n\n";
+
+    //create the buffers for the kernels
+    KernelData data;
+    data.src = new uint8_t[count*4];
+    data.dst = new uint8_t[count*4];
+    data.half = new uint16_t[count*4];
+    data.count = count;
+    fillNoise(data.src, count*4);
+
+    //measure all kernels with and without the vector instructions
+    benchKernel("oglConvertRGBToRGBA", runRGBToRGBA, &data, data.dst, count*4);
+    benchKernel("oglSwizzleRedBlue", runSwizzle, &data, data.dst, count*4);
+    benchKernel("oglPremultiplyAlpha", runPremultiply, &data, data.dst, count*4);
+    benchKernel("oglConvertU8ToHalf", runU8ToHalf, &data, data.half, count*4*sizeof(uint16_t));
+
+    //free the buffers
+    delete[] data.src;
+    delete[] data.dst;
+    delete[] data.half;
+
+    //compare the library with SDL for the formats the kernels convert
+    std::cout << "\n";
+    benchSurface("RGB24", SDL_PIXELFORMAT_RGB24, runRowsRGB);
+    benchSurface("BGRA32", SDL_PIXELFORMAT_BGRA32, runRowsBGRA);
+
+    //say if all outputs matched
+    std::cout << "\n" << (benchResult ? "FAILED: see the results above" : "All outputs match") << "\n";
+    return benchResult;
+}
@@ -8,5 +8,6 @@ in vec2 f_tex;
 
 void main()
 {
-    color = vec4(vec3(1) - texture(mainBuff, f_tex).rgb,1);
+    //the render target may be bigger than the window, so the pixels are read directly
+    color = vec4(vec3(1) - texelFetch(mainBuff, ivec2(gl_FragCoord.xy), 0).rgb,1);
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+/**
+ * @file textureTest.cpp
+ * @author DM8AT
+ * @brief tests for the texture memory budget and the render targets. It opens a window, because the tests need an OpenGL context
+ * @version 0.1
+ * @date 2024-08-24
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "ObjectGL/ObjectGL.hpp"
+#include <iostream>
+
+/**
+ * @brief store the result of the tests, it is 0 if all checks passed
+ */
+static int testResult = 0;
+
+/**
+ * @brief print the result of a check
+ *
+ * @param passed true if the check passed
+ * @param name a description of the check
+ */
+void check(bool passed, const char* name)
+{
+    std::cout << "  " << (passed ? "passed" : "FAILED") << ": " << name << "\n";
+    if (!passed) {testResult = 1;}
+}
+
+/**
+ * @brief read a parameter of a texture from OpenGL
+ *
+ * @param texture the texture to read from
+ * @param parameter the parameter to read
+ * @return GLint the value of the parameter
+ */
+GLint getTexParameter(OGL_Texture& texture, GLenum parameter)
+{
+    GLint value = 0;
+    glGetTextureParameteriv(texture.getTexture(), parameter, &value);
+    return value;
+}
+
+/**
+ * @brief check that the parameters set by the test are still set on the OpenGL texture
+ *
+ * @param texture the texture to check
+ * @param name a description of the check
+ */
+void checkParameters(OGL_Texture& texture, const char* name)
+{
+    check(texture.getTexture() != 0 &&
+          getTexParameter(texture, GL_TEXTURE_MIN_FILTER) == GL_NEAREST &&
+          getTexParameter(texture, GL_TEXTURE_MAG_FILTER) == GL_NEAREST &&
+          getTexParameter(texture, GL_TEXTURE_WRAP_S) == GL_CLAMP_TO_EDGE, name);
+}
+
+/**
+ * @brief check that texture parameters survive dropping mip levels and a full eviction with a reload
+ *
+ * @param instance the instance to set the budget of
+ * @param window the window, it is flipped so the texture is not used in the current frame
+ */
+void testEvictReload(OGL_Instance& instance, OGL_Window& window)
+{
+    std::cout << "texture parameters survive an eviction\n";
+    //load a texture that can be evicted and set parameters that differ from the defaults
+    OGL_Texture texture("src/cubeTexture.png");
+    texture.setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    texture.setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    texture.setTexParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    checkParameters(texture, "parameters are set");
+    //only textures that where not used in the current frame are evicted
+    window.flip();
+    //a budget slightly below the size drops the top mip level
+    uint32_t levels = texture.getLevelCount();
+    instance.setTextureBudget(texture.getMemorySize() - 1);
+    check(texture.getLevelCount() == levels - 1, "the top mip level was dropped");
+    checkParameters(texture, "parameters survive dropping a mip level");
+    //a tiny budget evicts the texture completely
+    instance.setTextureBudget(1);
+    check(texture.isEvicted() && texture.getTexture() == 0, "the texture was evicted");
+    //binding the texture loads it again
+    instance.setTextureBudget(0);
+    texture.bind(0);
+    texture.waitReady();
+    check(!texture.isEvicted() && texture.getLevelCount() == levels, "the texture was loaded again");
+    checkParameters(texture, "parameters survive the reload");
+    texture.unbind(0);
+}
+
+/**
+ * @brief check that a framebuffer attaches the new storage of a pooled render target after it was resized. OpenGL may give the new storage the name of the old texture
+ */
+void testResizeReattach()
+{
+    std::cout << "framebuffers attach resized render targets\n";
+    //create a render target and a framebuffer that draws to it
+    OGL_RenderTargetPool pool;
+    OGL_Texture* target = pool.acquire(64, 64, GL_RGBA8);
+    OGL_FramebufferAttachment attachment;
+    attachment.texture = target;
+    OGL_Framebuffer framebuffer({attachment});
+    //resize the render target to an other size class
+    uint64_t generation = target->getStorageGeneration();
+    check(pool.resize(target, 200, 200), "the render target got new storage");
+    check(target->getStorageGeneration() != generation, "the storage generation changed");
+    //clear the framebuffer, this must write to the new storage
+    framebuffer.bind();
+    glViewport(0, 0, target->getWidth(), target->getHeight());
+    glClearColor(1, 0, 0, 1);
+    glClear(GL_COLOR_BUFFER_BIT);
+    framebuffer.unbind();
+    //read a pixel of the new storage that is outside of the old size
+    uint8_t pixel[4] = {};
+    glGetTextureSubImage(target->getTexture(), 0, 150, 150, 0, 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, sizeof(pixel), pixel);
+    check(pixel[0] == 255 && pixel[1] == 0 && pixel[2] == 0 && pixel[3] == 255, "the framebuffer cleared the new storage");
+    pool.release(target);
+}
+
+int main()
+{
+    //the tests need an OpenGL context
+    OGL_Instance instance(4.6, OGL_PROFILE_CORE);
+    OGL_Window window = OGL_Window("ObjectGL tests", 256, 256);
+
+    //run all tests
+    testEvictReload(instance, window);
+    testResizeReattach();
+
+    //say if all checks passed
+    std::cout << "\n" << (testResult ? "FAILED: see the results above" : "All checks passed") << "\n";
+    return testResult;
+}